@@ -0,0 +1,28 @@
+#pragma once
+
+#include "AudioSink.hpp"
+
+#include <SFML/Audio.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// SFML audio stream for the desktop frontend. Until the APU mixes its channels it plays a fixed tune.
+class AudioOutput : public sf::SoundStream, public AudioSink {
+public:
+    AudioOutput();
+
+    void start() override;
+
+private:
+    bool onGetData(Chunk& data) override;
+    void onSeek(sf::Time timeOffset) override;
+
+    std::vector<std::int16_t> m_samples{};
+    std::size_t m_currentSample{};
+    static constexpr uint32_t m_blockSize = 4000;
+    static constexpr uint32_t m_sampleRate = 44100;
+
+    int m_note{};
+    int m_bar{};
+};
@@ -0,0 +1,9 @@
+#pragma once
+
+// Audio output of a Bus. The APU does not mix samples yet, the sink is started on its first step.
+class AudioSink {
+public:
+    virtual ~AudioSink() = default;
+
+    virtual void start() = 0;
+};
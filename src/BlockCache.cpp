@@ -0,0 +1,260 @@
+#include "BlockCache.hpp"
+
+#include "Bus.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    constexpr std::array<uint8_t, 256> instructionLength{
+    1, 3, 1, 1, 1, 1, 2, 1, 3, 1, 1, 1, 1, 1, 2, 1, // 0x
+    2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1, // 1x
+    2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1, // 2x
+    2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1, // 3x
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 4x
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 5x
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 6x
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 7x
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 8x
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 9x
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // Ax
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // Bx
+    1, 1, 3, 3, 3, 1, 2, 1, 1, 1, 3, 2, 3, 3, 2, 1, // Cx
+    1, 1, 3, 1, 3, 1, 2, 1, 1, 1, 3, 1, 3, 1, 2, 1, // Dx
+    2, 1, 1, 1, 1, 1, 2, 1, 2, 1, 3, 1, 1, 1, 2, 1, // Ex
+    2, 1, 1, 1, 1, 1, 2, 1, 2, 1, 3, 1, 1, 1, 2, 1, // Fx
+    };
+
+    constexpr std::array<uint8_t, 256> instructionCycles{
+    4, 12, 8, 8, 4, 4, 8, 4, 20, 8, 8, 8, 4, 4, 8, 4, // 0x
+    4, 12, 8, 8, 4, 4, 8, 4, 12, 8, 8, 8, 4, 4, 8, 4, // 1x
+    8, 12, 8, 8, 4, 4, 8, 4, 8, 8, 8, 8, 4, 4, 8, 4, // 2x
+    8, 12, 8, 8, 12, 12, 12, 4, 8, 8, 8, 8, 4, 4, 8, 4, // 3x
+    4, 4, 4, 4, 4, 4, 8, 4, 4, 4, 4, 4, 4, 4, 8, 4, // 4x
+    4, 4, 4, 4, 4, 4, 8, 4, 4, 4, 4, 4, 4, 4, 8, 4, // 5x
+    4, 4, 4, 4, 4, 4, 8, 4, 4, 4, 4, 4, 4, 4, 8, 4, // 6x
+    8, 8, 8, 8, 8, 8, 4, 8, 4, 4, 4, 4, 4, 4, 8, 4, // 7x
+    4, 4, 4, 4, 4, 4, 8, 4, 4, 4, 4, 4, 4, 4, 8, 4, // 8x
+    4, 4, 4, 4, 4, 4, 8, 4, 4, 4, 4, 4, 4, 4, 8, 4, // 9x
+    4, 4, 4, 4, 4, 4, 8, 4, 4, 4, 4, 4, 4, 4, 8, 4, // Ax
+    4, 4, 4, 4, 4, 4, 8, 4, 4, 4, 4, 4, 4, 4, 8, 4, // Bx
+    8, 12, 12, 16, 12, 16, 8, 16, 8, 16, 12, 4, 12, 24, 8, 16, // Cx
+    8, 12, 12, 0, 12, 16, 8, 16, 8, 16, 12, 0, 12, 0, 8, 16, // Dx
+    12, 12, 8, 0, 0, 16, 8, 16, 16, 4, 16, 0, 0, 0, 8, 16, // Ex
+    12, 12, 8, 4, 0, 16, 8, 16, 12, 8, 16, 4, 0, 0, 8, 16, // Fx
+    };
+
+    constexpr std::array<uint8_t, 256> prefixCycles{
+    8, 8, 8, 8, 8, 8, 16, 8, 8, 8, 8, 8, 8, 8, 16, 8, // 0x
+    8, 8, 8, 8, 8, 8, 16, 8, 8, 8, 8, 8, 8, 8, 16, 8, // 1x
+    8, 8, 8, 8, 8, 8, 16, 8, 8, 8, 8, 8, 8, 8, 16, 8, // 2x
+    8, 8, 8, 8, 8, 8, 16, 8, 8, 8, 8, 8, 8, 8, 16, 8, // 3x
+    8, 8, 8, 8, 8, 8, 12, 8, 8, 8, 8, 8, 8, 8, 12, 8, // 4x
+    8, 8, 8, 8, 8, 8, 12, 8, 8, 8, 8, 8, 8, 8, 12, 8, // 5x
+    8, 8, 8, 8, 8, 8, 12, 8, 8, 8, 8, 8, 8, 8, 12, 8, // 6x
+    8, 8, 8, 8, 8, 8, 12, 8, 8, 8, 8, 8, 8, 8, 12, 8, // 7x
+    8, 8, 8, 8, 8, 8, 16, 8, 8, 8, 8, 8, 8, 8, 16, 8, // 8x
+    8, 8, 8, 8, 8, 8, 16, 8, 8, 8, 8, 8, 8, 8, 16, 8, // 9x
+    8, 8, 8, 8, 8, 8, 16, 8, 8, 8, 8, 8, 8, 8, 16, 8, // Ax
+    8, 8, 8, 8, 8, 8, 16, 8, 8, 8, 8, 8, 8, 8, 16, 8, // Bx
+    8, 8, 8, 8, 8, 8, 16, 8, 8, 8, 8, 8, 8, 8, 16, 8, // Cx
+    8, 8, 8, 8, 8, 8, 16, 8, 8, 8, 8, 8, 8, 8, 16, 8, // Dx
+    8, 8, 8, 8, 8, 8, 16, 8, 8, 8, 8, 8, 8, 8, 16, 8, // Ex
+    8, 8, 8, 8, 8, 8, 16, 8, 8, 8, 8, 8, 8, 8, 16, 8, // Fx
+    };
+
+    // Jumps, calls, returns, restarts, HALT/STOP and illegal opcodes end a block
+    bool endsBlock(uint8_t opcode)
+    {
+        switch (opcode) {
+            case 0x10: case 0x18: case 0x20: case 0x28: case 0x30: case 0x38: case 0x76:
+            case 0xC0: case 0xC2: case 0xC3: case 0xC4: case 0xC7: case 0xC8: case 0xC9: case 0xCA: case 0xCC: case 0xCD: case 0xCF:
+            case 0xD0: case 0xD2: case 0xD3: case 0xD4: case 0xD7: case 0xD8: case 0xD9: case 0xDA: case 0xDB: case 0xDC: case 0xDD: case 0xDF:
+            case 0xE3: case 0xE4: case 0xE7: case 0xE9: case 0xEB: case 0xEC: case 0xED: case 0xEF:
+            case 0xF4: case 0xF7: case 0xFC: case 0xFD: case 0xFF:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // No writes, no stack and nothing that changes H or L, so (HL) reads keep pointing at the same byte
+    bool idleSafe(const DecodedInstruction& decoded)
+    {
+        const auto opcode = decoded.opcode;
+        if (opcode == 0xCB) {
+            return (decoded.operands[0] & 0xC0) == 0x40; // BIT b, r
+        }
+        if (opcode >= 0x40 && opcode < 0x80) {
+            return opcode < 0x60 || opcode >= 0x78; // LD r, r' unless r is H, L or (HL)
+        }
+        if (opcode >= 0x80 && opcode < 0xC0) {
+            return true;
+        }
+        switch (opcode) {
+            case 0x00: case 0x06: case 0x0E: case 0x16: case 0x1E: case 0x3E:
+            case 0x07: case 0x0F: case 0x17: case 0x1F: case 0x27: case 0x2F: case 0x37: case 0x3F:
+            case 0xC6: case 0xCE: case 0xD6: case 0xDE: case 0xE6: case 0xEE: case 0xF6: case 0xFE:
+            case 0xF0: case 0xFA:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // A loop the CPU may find idle, it still has to prove it does not change any state
+    bool idleCandidate(const Block& block)
+    {
+        const auto& last = block.instructions.back();
+        const uint16_t next = last.address + last.length;
+        uint16_t target{};
+        switch (last.opcode) {
+            case 0x18: case 0x20: case 0x28: case 0x30: case 0x38:
+                target = static_cast<uint16_t>(next + static_cast<int8_t>(last.operands[0]));
+                break;
+            case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA:
+                target = static_cast<uint16_t>(last.operands[0] | (last.operands[1] << 8));
+                break;
+            default:
+                return false;
+        }
+        return target == block.start && std::all_of(block.instructions.begin(), block.instructions.end() - 1, idleSafe);
+    }
+}
+
+BlockCache::BlockCache(Bus* bus) : m_bus(bus)
+{
+    m_blocks.reserve(4096);
+}
+
+Block& BlockCache::get(uint16_t pc)
+{
+    // During OAM DMA the CPU fetches 0xFF, which must not be cached past the transfer
+    if (!cacheable(pc) || (pc < 0xFF00 && m_bus->dmaBlocking())) {
+        m_misses++;
+        m_uncachedFetches++;
+        decode(m_uncached, pc, 1);
+        return m_uncached;
+    }
+
+    if (const auto it = m_blocks.find(pc); it != m_blocks.end()) {
+        return it->second;
+    }
+
+    m_misses++;
+    auto& block = m_blocks[pc];
+    decode(block, pc, maxBlockLength);
+    for (auto page = block.start >> 8; page <= lastPage(block); ++page) {
+        m_pageBlocks[page].push_back(pc);
+        m_codePages[page] = 1;
+        m_bus->trapWrites(static_cast<uint8_t>(page));
+    }
+
+    m_blocksDecoded++;
+    m_instructionsDecoded += block.instructions.size();
+    m_cyclesDecoded += block.cycles;
+    m_blockLengths[block.instructions.size()]++;
+    return block;
+}
+
+void BlockCache::decode(Block& block, uint16_t pc, size_t maxLength)
+{
+    block.start = pc;
+    block.cycles = 0;
+    block.instructions.clear();
+
+    uint16_t addr = pc;
+    while (true) {
+        DecodedInstruction decoded{};
+        decoded.address = addr;
+        decoded.opcode = m_bus->read(addr);
+        const auto length = instructionLength[decoded.opcode];
+        for (int i = 1; i < length; ++i) {
+            decoded.operands[i - 1] = m_bus->read(addr + i);
+        }
+        decoded.length = length;
+        decoded.cycles = (decoded.opcode == 0xCB) ? prefixCycles[decoded.operands[0]] : instructionCycles[decoded.opcode];
+
+        block.end = addr + length - 1;
+        block.cycles += decoded.cycles;
+        block.instructions.push_back(decoded);
+
+        const uint16_t next = addr + length;
+        if (endsBlock(decoded.opcode) || block.instructions.size() == maxLength || next < pc || !cacheable(next)) {
+            break;
+        }
+        addr = next;
+    }
+    block.idleCandidate = idleCandidate(block);
+}
+
+// A block that spans two pages also leaves the other page's list, which lets go of that page
+// once nothing else on it is cached
+void BlockCache::invalidatePage(uint8_t page)
+{
+    std::vector<uint16_t> starts;
+    starts.swap(m_pageBlocks[page]);
+    for (const auto start : starts) {
+        const auto it = m_blocks.find(start);
+        if (it == m_blocks.end()) {
+            continue;
+        }
+        for (auto other = start >> 8; other <= lastPage(it->second); ++other) {
+            auto& blocks = m_pageBlocks[other];
+            if (other == page || blocks.empty()) {
+                continue;
+            }
+            blocks.erase(std::remove(blocks.begin(), blocks.end(), start), blocks.end());
+            if (blocks.empty()) {
+                releasePage(static_cast<uint8_t>(other));
+            }
+        }
+        m_blocks.erase(it);
+        m_blocksInvalidated++;
+    }
+    releasePage(page);
+}
+
+void BlockCache::releasePage(uint8_t page)
+{
+    m_codePages[page] = 0;
+    m_bus->untrapWrites(page);
+}
+
+void BlockCache::forgetNative()
+{
+    for (auto& [start, block] : m_blocks) {
+        block.executions = 0;
+        block.native = nullptr;
+    }
+}
+
+bool BlockCache::flush(uint16_t first, uint16_t last)
+{
+    bool flushed = false;
+    for (auto page = first >> 8; page <= (last >> 8); ++page) {
+        if (!m_pageBlocks[page].empty()) {
+            invalidatePage(static_cast<uint8_t>(page));
+            flushed = true;
+        }
+    }
+    return flushed;
+}
+
+void BlockCache::printStats() const
+{
+    const auto hits = m_fetches - m_misses;
+    std::cout << std::dec << "Block cache:\n"
+        << "fetches=" << m_fetches << " hits=" << hits << " misses=" << m_misses << " uncached=" << m_uncachedFetches
+        << " hitRate=" << (m_fetches ? 100.0 * hits / m_fetches : 0.0) << "%\n"
+        << "blocksDecoded=" << m_blocksDecoded << " blocksInvalidated=" << m_blocksInvalidated << " blocksLive=" << m_blocks.size()
+        << " avgLength=" << (m_blocksDecoded ? double(m_instructionsDecoded) / m_blocksDecoded : 0.0)
+        << " avgCycles=" << (m_blocksDecoded ? double(m_cyclesDecoded) / m_blocksDecoded : 0.0) << "\n"
+        << "block lengths:";
+    for (size_t length = 1; length < m_blockLengths.size(); ++length) {
+        if (m_blockLengths[length]) {
+            std::cout << " " << length << ":" << m_blockLengths[length];
+        }
+    }
+    std::cout << "\n";
+}
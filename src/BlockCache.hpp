@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class Bus;
+struct RecompilerState;
+
+// Entry point of a block translated by the recompiler, returns the cycles it ran
+using NativeBlock = uint32_t (*)(RecompilerState* state);
+
+struct DecodedInstruction {
+    uint16_t address{};
+    uint8_t opcode{};
+    std::array<uint8_t, 2> operands{}; // immediates, or the second opcode byte after 0xCB
+    uint8_t length{};
+    uint8_t cycles{}; // static cost, branches not taken
+};
+
+struct Block {
+    uint16_t start{};
+    uint16_t end{}; // address of the last byte
+    uint32_t cycles{};
+    std::vector<DecodedInstruction> instructions{};
+    uint32_t executions{}; // entries from the interpreter, drives recompilation
+    NativeBlock native{};
+    bool idleCandidate{}; // branches back to its own start and only reads memory
+};
+
+// Straight-line runs of pre-decoded instructions keyed on their start PC.
+// Blocks are registered with every 256 byte page they span so writes can drop them.
+class BlockCache {
+public:
+    BlockCache(Bus* bus);
+    Block& get(uint16_t pc);
+    void recordFetch() { m_fetches++; }
+    void forgetNative();
+    const uint8_t* codePages() const { return m_codePages.data(); }
+
+    bool invalidate(uint16_t addr)
+    {
+        const auto page = static_cast<uint8_t>(addr >> 8);
+        if (m_pageBlocks[page].empty() || !cacheable(addr)) {
+            return false;
+        }
+        invalidatePage(page);
+        return true;
+    }
+
+    bool flush(uint16_t first, uint16_t last);
+    void printStats() const;
+
+    static constexpr size_t maxBlockLength = 32;
+
+private:
+    void invalidatePage(uint8_t page);
+    void releasePage(uint8_t page);
+    void decode(Block& block, uint16_t pc, size_t maxLength);
+
+    static int lastPage(const Block& block) { return block.end >= block.start ? block.end >> 8 : 0xFF; }
+
+    // OAM and I/O registers are never executed from the cache
+    static bool cacheable(uint16_t addr) { return addr < 0xFE00 || addr >= 0xFF80; }
+
+    Bus* m_bus{};
+    std::unordered_map<uint16_t, Block> m_blocks{};
+    std::array<std::vector<uint16_t>, 256> m_pageBlocks{};
+    std::array<uint8_t, 256> m_codePages{}; // mirrors !m_pageBlocks[page].empty() for translated code
+    Block m_uncached{};
+
+    uint64_t m_fetches{};
+    uint64_t m_misses{};
+    uint64_t m_uncachedFetches{};
+    uint64_t m_blocksDecoded{};
+    uint64_t m_blocksInvalidated{};
+    uint64_t m_instructionsDecoded{};
+    uint64_t m_cyclesDecoded{};
+    std::array<uint64_t, maxBlockLength + 1> m_blockLengths{};
+};
@@ -1,214 +1,702 @@
 #include "Bus.hpp"
 
+#include "SaveState.hpp"
+
+#include <algorithm>
+#include <chrono>
 #include <cstring>
-#include <fstream>
+#include <limits>
 #include <optional>
+#include <utility>
+#include <vector>
 
-Bus::Bus(bool bootRom) :
-    m_bootRom(bootRom),
-    m_boot(std::make_unique<uint8_t[]>(0x100)),
+Bus::Bus(const char* romFilename, const char* bootRomFilename, VideoSink* video, AudioSink* audio, bool saveFile) :
+    m_bootRom(bootRomFilename != nullptr),
+    m_video(video),
     m_map(std::make_unique<uint8_t[]>(0x10000)),
     m_cpu(this),
+    m_timer(this),
     m_ppu(this),
-    m_screen(this),
-    m_sound(this)
+    m_sound(this, audio)
+#ifdef TAMEBOY_REWIND
+    , m_rewind(this, m_rewindSettings.budget)
+#endif
 {    
-    std::memset((char*)m_boot.get(), 0, 0x100);
     std::memset((char*)m_map.get(), 0, 0x10000);
 
-    readFile((char*)m_boot.get(), "../roms/DMG_ROM_no_checksum.bin");
-    //readFile((char*)m_map.get(), "../roms/tetris.bin");
-    //readFile((char*)m_map.get(), "../roms/cpu_instrs.gb");
-    //readFile((char*)m_map.get(), "../roms/blargg/cpu_instrs/1.gb");
-    //readFile((char*)m_map.get(), "../roms/blargg/instr_timing.gb");
-    //readFile((char*)m_map.get(), "../roms/tennis.bin");
-    //readFile((char*)m_map.get(), "../roms/Alleyway.bin");
-    //readFile((char*)m_map.get(), "../roms/dr.bin");
-    //readFile((char*)m_map.get(), "../roms/spot.gb");
-    readFile((char*)m_map.get(), "../roms/taz.gb");
-    //readFile((char*)m_map.get(), "../roms/balls.gb");
+    if (m_bootRom) {
+        m_boot = MappedFile(bootRomFilename);
+        if (m_boot.size() < 0x100) {
+            throw std::runtime_error("Boot ROM file too small!");
+        }
+    }
+    m_cartridge.load(romFilename, saveFile);
 
+    mapPages();
+    mapRegisters();
     m_cpu.reset(m_bootRom);
     if (m_bootRom) {
         compareLogo();
     }
+    else {
+        postBoot();
+    }
+
+    m_scheduler.schedule(Event::Sound, m_cycleCounter + soundClock);
+    m_scheduler.schedule(Event::ScreenUpdate, m_cycleCounter);
+    if (m_cartridge.hasSave()) {
+        m_scheduler.schedule(Event::SaveFlush, m_cycleCounter + saveFlushClock);
+    }
+    schedulePPU();
+}
+
+void Bus::runFrames(uint64_t frames)
+{
+    // Frames start at multiples of the frame length, so stopping a little late does not add up
+    const auto end = (m_cycleCounter / screenUpdateClock + frames) * screenUpdateClock;
+    while (m_cycleCounter < end) {
+        step();
+    }
+}
+
+void Bus::stepInstruction()
+{
+    m_cycleCounter += m_cpu.fetchDecodeExecute();
+    if (m_cycleCounter >= m_scheduler.next()) {
+        runEvents();
+    }
 }
 
 void Bus::start()
 {
-    const auto updateScreens = [&]()
-    {
-        m_screen.update(m_ppu.getFrameBuffer());
-        m_ppu.updateDebugVramDisplays();
-        m_screen.updateDebug(m_ppu.getTileDataBuffer(), m_ppu.getTileMapBuffer(), m_ppu.getObjectBuffer());
-        //m_sound.printState();
-    };
+#ifdef TAMEBOY_BENCHMARK
+    constexpr uint64_t benchmarkInstructions = 50'000'000;
+    const auto benchmarkStart = std::chrono::steady_clock::now();
+#endif
 
-    const auto processTimer = [&](uint64_t& counter)
+    while (true)
     {
-        const auto tac = read(0xFF07);
-        const auto enable = static_cast<bool>(tac & 0b0000'0100);
-        if (!enable) {
+#ifdef TAMEBOY_BENCHMARK
+        // Counted by the CPU, a translated block or a skipped idle loop retires many instructions at once
+        const auto instructions = m_cpu.instructionCount();
+        if (instructions >= benchmarkInstructions) {
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - benchmarkStart;
+            std::cout << std::dec << instructions << " instructions, " << m_cycleCounter << " cycles in "
+                << elapsed.count() << " s (" << instructions / elapsed.count() << " instructions/s)\n";
+            std::cout << "Events=" << m_events << " (" << (m_events ? double(instructions) / m_events : 0.0)
+                << " instructions per event)\n";
+            std::cout << "Halt skips=" << m_haltSkips << " idle loop skips=" << m_idleSkips << " cyclesSkipped=" << m_cyclesSkipped
+                << " (" << (m_cycleCounter ? 100.0 * m_cyclesSkipped / m_cycleCounter : 0.0) << "% of cycles)\n";
+            m_cpu.printBlockCacheStats();
+            m_cpu.printFlagStats();
+            m_cpu.printIdleLoopStats();
+            m_ppu.printRenderStats();
+            PixelKernels::benchmark();
+#ifdef TAMEBOY_REWIND
+            m_rewind.printStats();
+#endif
+            benchmarkSaveStates();
             return;
         }
+#endif
 
-        const auto clockSelect = static_cast<uint8_t>(tac & 0b0000'0011);
-        uint16_t clock{};
-        switch (clockSelect) {
-            case 0: clock = 256; break;
-            case 1: clock = 4; break;
-            case 2: clock = 16; break;
-            case 3: clock = 64; break;
-            default: throw std::runtime_error("Bad clock select");
-        }
-        if (counter >= clock) {
-            const auto tima = read(0xFF05);
-            const auto modulo = read(0xFF06);
-            if (tima == 0xFF) {
-                write(0xFF05, modulo);
-                const auto newInterruptFlag = Utils::setBit(read(0xFF0F), static_cast<int>(Interrupt::Timer));
-                write(0xFF0F, newInterruptFlag);
+        step();
+    }
+}
+
+// Runs the CPU up to the next deadline and handles the events due there
+void Bus::step()
+{
+    // Nothing outside the CPU changes before the next deadline. Writes to I/O registers
+    // may bring it forward, so it is read again after every instruction.
+    while (m_cycleCounter < m_scheduler.next()) {
+        m_cycleCounter += m_cpu.fetchDecodeExecute();
+
+#ifdef TAMEBOY_HALT_SKIP
+        // Instead of spinning in 4 cycle steps, move straight to the next event
+        if (m_cpu.isHalted() && m_cycleCounter < m_scheduler.next() && !(read(0xFFFF) & read(0xFF0F))) {
+            m_haltSkips++;
+            m_cyclesSkipped += m_scheduler.next() - m_cycleCounter;
+            m_cycleCounter = m_scheduler.next();
+        }
+#endif
+
+#ifdef TAMEBOY_IDLE_LOOPS
+        // The CPU stopped at the head of a loop that only polls memory, skip whole passes up to the next event
+        if (const auto* loop = m_cpu.idleLoop()) {
+            // DIV and TIMA change without an event, a loop polling them may only run up to their next step
+            auto until = m_scheduler.next();
+            for (size_t i = 0; i < loop->readCount; ++i) {
+                until = std::min(until, m_timer.nextChange(loop->reads[i]));
             }
-            else {
-                write(0xFF05, tima + 1);
+            const auto cycles = until > m_cycleCounter ? until - m_cycleCounter : 0;
+            const auto iterations = cycles / loop->cycles;
+            m_cpu.skipIdleLoop(iterations);
+            if (iterations) {
+                m_idleSkips++;
+                m_cyclesSkipped += iterations * loop->cycles;
+                m_cycleCounter += iterations * loop->cycles;
             }
-            counter -= clock;
         }
-    };
+#endif
+    }
 
-    const auto processDivider = [&](uint64_t& counter)
-    {
-        if (counter >= 64) {
-            m_map[0xFF04] += 1;
-            counter -= 64;
-        }
-    };
+    runEvents();
 
-    const auto processSerial = [&](uint64_t& counter)
-    {
-        if (counter >= 4) {                        // |        7        | 6 5 4 3 2 |      1      |      0       |
-            const auto SC = read(0xFF02); // | Transfer enable |           | Clock speed | Clock select |
-            if (SC == 0b1000'0001) {  // transfer enable & master clock
-                const auto SB = read(0xFF01);
-                std::cout << static_cast<char>(SB) << " ";
-                const auto clearEnable = Utils::clearBit(SC, 7);
-                write(0xFF02, clearEnable);
-
-                const auto newInterruptFlag = Utils::setBit(read(0xFF0F), static_cast<int>(Interrupt::Serial));
-                write(0xFF0F, newInterruptFlag);
+#ifdef TAMEBOY_REWIND
+    if (std::exchange(m_frameDone, false)) {
+        updateRewind();
+    }
+#endif
+}
+
+#ifdef TAMEBOY_REWIND
+// Once per frame, outside the event loop since a rewind replaces the scheduler and the cycle counter
+void Bus::updateRewind()
+{
+    if (!m_rewindSettings.interval) {
+        return;
+    }
+    if (m_video && m_video->rewinding()) {
+        m_rewindFrames = 0;
+        m_rewind.stepBack(m_rewindSettings.speed);
+    }
+    else if (++m_rewindFrames >= m_rewindSettings.interval) {
+        m_rewindFrames = 0;
+        m_rewind.capture();
+    }
+}
+#endif
+
+// Handles every event that is due. Periodic events are rescheduled from their deadline
+// rather than from the current cycle so a late dispatch does not shift them.
+void Bus::runEvents()
+{
+    const auto blocking = std::exchange(m_dma.blocking, false); // only the CPU sees the DMA bus conflict
+    while (m_scheduler.next() <= m_cycleCounter) {
+        const auto cycle = m_scheduler.next();
+        m_events++;
+        switch (m_scheduler.nextEvent()) {
+            case Event::Timer: {
+                m_timer.overflow(cycle);
+                break;
+            }
+            case Event::Serial: {                  // |        7        | 6 5 4 3 2 |      1      |      0       |
+                const auto SC = read(0xFF02); // | Transfer enable |           | Clock speed | Clock select |
+                if (SC == 0b1000'0001) {  // transfer enable & master clock
+                    const auto SB = read(0xFF01);
+                    *m_serialOutput << static_cast<char>(SB) << " ";
+                    const auto clearEnable = Utils::clearBit(SC, 7);
+                    write(0xFF02, clearEnable);
+
+                    const auto newInterruptFlag = Utils::setBit(read(0xFF0F), static_cast<int>(Interrupt::Serial));
+                    write(0xFF0F, newInterruptFlag);
+                }
+                m_scheduler.cancel(Event::Serial);
+                break;
+            }
+            case Event::PPULine: {
+                syncPPU();
+                schedulePPU();
+                break;
+            }
+            case Event::Sound: {
+                m_sound.tick(soundClock);
+                m_scheduler.schedule(Event::Sound, cycle + soundClock);
+                break;
+            }
+            case Event::ScreenUpdate: {
+                updateScreens();
+                m_scheduler.schedule(Event::ScreenUpdate, cycle + screenUpdateClock);
+#ifdef TAMEBOY_REWIND
+                m_frameDone = true;
+#endif
+                break;
+            }
+            case Event::SaveFlush: {
+                flushSave();
+                m_scheduler.schedule(Event::SaveFlush, cycle + saveFlushClock);
+                break;
+            }
+            case Event::Dma: {
+                endDma(cycle);
+                break;
+            }
+            default: {
+                throw std::runtime_error("Bad event");
             }
-            counter -= 4;
         }
-    };
-    
-    uint64_t timerCycleCounter{};
-    uint64_t dividerCycleCounter{};
-    uint64_t serialCycleCounter{};
+    }
+    m_dma.blocking = blocking && m_dma.active;
+}
 
-    while (true)
-    {
-        processTimer(timerCycleCounter);
-        processDivider(dividerCycleCounter);
-        processSerial(serialCycleCounter);
+void Bus::updateScreens()
+{
+    if (!m_video) {
+        return;
+    }
+    m_video->present(m_ppu.getFrameBuffer());
+    if (m_video->wantsDebug()) {
+        m_ppu.updateDebugVramDisplays();
+        m_video->presentDebug(m_ppu.getTileDataBuffer(), m_ppu.getTileMapBuffer(), m_ppu.getObjectBuffer());
+    }
+    setJoypad(m_video->joypad());
+    //m_sound.printState();
+}
 
-        const auto cycles = m_cpu.fetchDecodeExecute();
-        m_ppu.tick(cycles);
-        m_sound.tick(cycles);
+void Bus::setJoypad(uint8_t keys)
+{
+    if (keys == m_joypad) {
+        return;
+    }
+    m_joypad = keys;
+    const auto newInterruptFlag = Utils::setBit(read(0xFF0F), static_cast<int>(Interrupt::Joypad));
+    write(0xFF0F, newInterruptFlag);
+}
 
-        if (m_instructionCounter % 10000 == 0) {
-            updateScreens();
-        }
-       
-        m_instructionCounter++;
-        
-        m_cycleCounter += cycles;
-        timerCycleCounter += cycles;
-        dividerCycleCounter += cycles;
-        serialCycleCounter += cycles;
+// The PPU only acts on line boundaries, so it is brought up to date there and before LCDC changes
+void Bus::syncPPU()
+{
+    if (m_dma.active) { // OAM has to hold what the DMA transferred so far
+        copyDma(m_cycleCounter);
     }
+    const auto blocking = std::exchange(m_dma.blocking, false);
+    m_ppu.tick(static_cast<uint32_t>(m_cycleCounter - m_ppuCycle));
+    m_ppuCycle = m_cycleCounter;
+    m_dma.blocking = blocking;
 }
 
-uint8_t Bus::read(uint16_t addr)
+// Every page goes to the handlers for the length of the transfer, which keeps the check off the fast path
+void Bus::startDma(uint8_t source)
 {
-    auto& map = (m_bootRom && (addr < 0x100)) ? m_boot : m_map;
+    if (m_dma.active) { // restarted, the old transfer stops where it got to
+        copyDma(m_cycleCounter);
+    }
+    else {
+        m_dmaPages = m_pages;
+        m_pages.read.fill(nullptr);
+        m_pages.write.fill(nullptr);
+    }
+    m_dma = { true, true, static_cast<uint16_t>(source << 8), m_cycleCounter + dmaStartDelay, 0 };
+    m_scheduler.schedule(Event::Dma, m_dma.start + dmaLength);
+    m_cpu.restartFetch();
+}
 
-    if (addr == 0xFF00) {
-        const auto joypad = m_screen.getJoypad();
-        const auto dPad = (joypad & 0xF0) >> 4;
-        const auto buttons = joypad & 0x0F;
-        const auto bits4to5 = static_cast<uint8_t>((m_map[0xFF00] & 0b0011'0000) >> 4);
-        const auto msn = m_map[0xFF00] & 0xF0;
-        switch (bits4to5) {
-            case 0: return msn | (buttons & dPad);
-            case 1: return msn | buttons;
-            case 2: return msn | dPad;
-            default: return msn | 0x0F;
+// Brings OAM up to the bytes transferred by the given cycle
+void Bus::copyDma(uint64_t cycle)
+{
+    const auto done = static_cast<uint8_t>(cycle > m_dma.start ? std::min<uint64_t>((cycle - m_dma.start) / 4, 160) : 0);
+    if (done <= m_dma.copied) {
+        return;
+    }
+    if (const auto* page = m_dmaPages.read[m_dma.source >> 8]) {
+        std::memcpy(m_map.get() + 0xFE00 + m_dma.copied, page + m_dma.copied, done - m_dma.copied);
+    }
+    else {
+        const auto blocking = std::exchange(m_dma.blocking, false);
+        for (auto i = m_dma.copied; i < done; ++i) {
+            m_map[0xFE00 + i] = read(m_dma.source + i);
         }
+        m_dma.blocking = blocking;
     }
+    m_dma.copied = done;
+}
 
-    return map[addr];
+void Bus::endDma(uint64_t cycle)
+{
+    copyDma(cycle);
+    m_pages = m_dmaPages;
+    m_dma.active = false;
+    m_dma.blocking = false;
+    m_scheduler.cancel(Event::Dma);
 }
 
-void Bus::write(uint16_t addr, uint8_t value)
+void Bus::schedulePPU()
 {
-    if (addr < 0x8000) // ROM
+    const auto cycles = m_ppu.cyclesUntilNextLine();
+    if (cycles == std::numeric_limits<uint32_t>::max()) {
+        m_scheduler.cancel(Event::PPULine);
         return;
+    }
+    m_scheduler.schedule(Event::PPULine, m_cycleCounter + cycles);
+}
 
-    if (addr == 0xFF00) { // Joypad. Only bits 4 and 5 are writable
-        m_map[0xFF00] = (m_map[0xFF00] & 0b1100'1111) | (value & 0b0011'0000);
-        return;
+// ROM, VRAM, external and work RAM and OAM are plain memory. The boot ROM is overlaid on page 0
+// until 0xFF50 is written, page 0xFF holds the I/O registers and HRAM. Writes to tile data
+// always take the handler, which tells the PPU.
+void Bus::mapPages()
+{
+    for (int page = 0x80; page < 0xFF; ++page) {
+        mapping().read[page] = m_map.get() + (page << 8);
+        mapping().write[page] = writablePage(static_cast<uint8_t>(page));
     }
+    mapCartridge();
+}
 
-    if (addr == 0xFF04) { // divider register
-        m_map[0xFF04] = 0;
+// Points the ROM and external RAM windows at the banks the cartridge has selected.
+// Only windows that moved are touched, code decoded from their old banks is dropped.
+void Bus::mapCartridge()
+{
+    constexpr std::array<std::pair<int, int>, 3> windows{ { { 0x00, 0x40 }, { 0x40, 0x80 }, { 0xA0, 0xC0 } } };
+    for (const auto& [first, end] : windows) {
+        // the last page of a window is never overlaid by the boot ROM
+        if (mapping().read[end - 1] == m_cartridge.readPage(static_cast<uint8_t>(end - 1))) {
+            continue;
+        }
+        for (auto page = first; page < end; ++page) {
+            mapping().read[page] = m_cartridge.readPage(static_cast<uint8_t>(page));
+            mapping().write[page] = m_cartridge.writePage(static_cast<uint8_t>(page));
+        }
+        if (first == 0 && m_bootRom) {
+            mapping().read[0] = m_boot.data();
+        }
+        m_cpu.remapCode(static_cast<uint16_t>(first << 8), static_cast<uint16_t>((end << 8) - 1));
+    }
+}
+
+// Save RAM written since the last flush goes to disk in the background, its pages
+// are write protected again so the cartridge sees the next change.
+void Bus::flushSave()
+{
+    if (!m_cartridge.flushSave()) {
         return;
     }
+    for (int page = 0xA0; page < 0xC0; ++page) {
+        mapping().write[page] = writablePage(static_cast<uint8_t>(page));
+    }
+}
+
+// Registers owned by the bus itself, the timer, PPU and APU register theirs on construction
+void Bus::mapRegisters()
+{
+    // Joypad. Only the select bits 4 and 5 are writable, the low nibble reads the selected keys
+    mapIo(0xFF00, 0b0011'0000, {}, [this]() {
+        const auto select = io(0xFF00);
+        const auto dPad = (m_joypad & 0xF0) >> 4;
+        const auto buttons = m_joypad & 0x0F;
+        const auto msn = select & 0xF0;
+        switch ((select & 0b0011'0000) >> 4) {
+            case 0: return static_cast<uint8_t>(msn | (buttons & dPad));
+            case 1: return static_cast<uint8_t>(msn | buttons);
+            case 2: return static_cast<uint8_t>(msn | dPad);
+            default: return static_cast<uint8_t>(msn | 0x0F);
+        }
+    });
+    mapIo(0xFF02, 0xFF, [this](uint8_t value) { // serial control
+        io(0xFF02) = value;
+        if (value == 0b1000'0001) { // transfer on the internal clock
+            m_scheduler.schedule(Event::Serial, m_cycleCounter + 4);
+        }
+    });
+    mapIo(0xFF0F, 0x1F); // interrupt flags
+    mapIo(0xFF40, 0xFF, [this](uint8_t value) { // LCD control, the PPU runs up to here under the old value
+        syncPPU();
+        io(0xFF40) = value;
+        schedulePPU();
+    });
+    mapIo(0xFF46, 0xFF, [this](uint8_t value) { // OAM DMA
+        io(0xFF46) = value;
+        startDma(value);
+    });
+    mapIo(0xFF50, 0xFF, [this](uint8_t value) { // boot ROM off
+        io(0xFF50) = value;
+        m_bootRom = false;
+        mapping().read[0] = m_cartridge.readPage(0);
+        m_cpu.flushCode(0x0000, 0x00FF);
+    });
+}
+
+uint8_t Bus::readSpecial(uint16_t addr)
+{
+    if (m_dma.active) {
+        if (m_dma.blocking && addr < 0xFF00) // bus conflict
+            return 0xFF;
+        if (const auto* page = m_dmaPages.read[addr >> 8])
+            return page[addr & 0xFF];
+    }
+
+    if (addr >= 0xFF00 && addr < 0xFF80) {
+        const auto& reg = m_io[addr - 0xFF00];
+        return reg.read ? reg.read() : m_map[addr];
+    }
 
-    if (addr == 0xFF46) { // DMA
-        m_cycleCounter += 160;
-        const auto src = static_cast<uint16_t>(value << 8);
-        std::memcpy((m_map.get() + 0xFE00), (m_map.get() + src), 160);
+    if (addr >= 0xA000 && addr < 0xC000) // external RAM while it is disabled, or the MBC3 clock
+        return m_cartridge.readRam(addr);
+
+    return m_map[addr];
+}
+
+void Bus::writeSpecial(uint16_t addr, uint8_t value)
+{
+    if (m_dma.active) {
+        if (m_dma.blocking && addr < 0xFF00) // bus conflict
+            return;
+        if (auto* page = m_dmaPages.write[addr >> 8]) {
+            page[addr & 0xFF] = value;
+            return;
+        }
+    }
+
+    if (addr < 0x8000) { // memory bank controller
+        if (m_cartridge.write(addr, value)) {
+            mapCartridge();
+        }
         return;
     }
 
-    if (addr == 0xFF47) // Palette
-        m_ppu.updatePaletteLookup(value);
+    if (addr >= 0xA000 && addr < 0xC000) { // external RAM that is disabled, nibble wide, clean save RAM or holds decoded code
+        m_cpu.invalidateCode(addr);
+        m_cartridge.writeRam(addr, value);
+        mapping().write[addr >> 8] = writablePage(static_cast<uint8_t>(addr >> 8));
+        return;
+    }
 
-    if (addr == 0xFF50)
-        m_bootRom = false;
+    if (addr >= 0xFF00 && addr < 0xFF80) {
+        const auto& reg = m_io[addr - 0xFF00];
+        const auto masked = static_cast<uint8_t>((m_map[addr] & ~reg.writable) | (value & reg.writable));
+        if (reg.write) {
+            reg.write(masked);
+        }
+        else {
+            m_map[addr] = masked;
+        }
+        return;
+    }
 
+    // tile data, trapped page with decoded code, or HRAM and IE
+    if (addr < 0x9800) {
+        m_ppu.invalidateTile(addr);
+    }
+    m_cpu.invalidateCode(addr);
     m_map[addr] = value;
 }
 
-void Bus::readFile(char* buffer, const char* filename)
+size_t Bus::stateSize()
 {
-    std::ifstream fs(filename, std::ios::binary | std::ios::ate);
-    if(!fs) {
-        throw std::runtime_error("Cannot open ROM file!");
+    StateWriter counter;
+    saveState(counter);
+    return counter.size();
+}
+
+size_t Bus::saveState(uint8_t* data, size_t size)
+{
+    StateWriter state(data, size);
+    saveState(state);
+    return state.size();
+}
+
+// Header, cartridge, VRAM, work RAM up to IE, then the components. The cartridge comes
+// first so a state of another game is rejected before anything is overwritten.
+void Bus::saveState(StateWriter& state)
+{
+    state.put(stateMagic);
+    state.put(stateVersion);
+    if (m_dma.active) { // OAM as the PPU would see it now
+        copyDma(m_cycleCounter);
+    }
+    m_cartridge.saveState(state);
+    state.put(m_map.get() + 0x8000, 0x2000);
+    state.put(m_map.get() + 0xC000, 0x4000);
+
+    m_cpu.saveState(state);
+    m_timer.saveState(state);
+    m_ppu.saveState(state);
+    m_sound.saveState(state);
+    m_scheduler.saveState(state);
+
+    state.put(m_bootRom);
+    state.put(m_cycleCounter);
+    state.put(m_ppuCycle);
+    state.put(m_joypad);
+    state.put(m_dma.active);
+    state.put(m_dma.blocking);
+    state.put(m_dma.source);
+    state.put(m_dma.start);
+    state.put(m_dma.copied);
+}
+
+void Bus::loadState(const uint8_t* data, size_t size)
+{
+    if (size != stateSize()) {
+        throw std::runtime_error("Save state has the wrong size!");
+    }
+    StateReader state(data, size);
+    if (state.get<uint32_t>() != stateMagic || state.get<uint32_t>() != stateVersion) {
+        throw std::runtime_error("Not a save state of this version!");
+    }
+    m_cartridge.checkState(state);
+
+    if (m_dma.active) { // the running transfer is dropped, the state brings its own
+        m_pages = m_dmaPages;
+        m_dma = {};
+    }
+
+    m_cartridge.loadState(state);
+    state.get(m_map.get() + 0x8000, 0x2000);
+    state.get(m_map.get() + 0xC000, 0x4000);
+
+    m_cpu.loadState(state);
+    m_timer.loadState(state);
+    m_ppu.loadState(state);
+    m_sound.loadState(state);
+    m_scheduler.loadState(state);
+
+    OamDma dma{};
+    state.get(m_bootRom);
+    state.get(m_cycleCounter);
+    state.get(m_ppuCycle);
+    state.get(m_joypad);
+    state.get(dma.active);
+    state.get(dma.blocking);
+    state.get(dma.source);
+    state.get(dma.start);
+    state.get(dma.copied);
+
+    // Banks that moved are remapped, ROM code stays decoded but all of RAM may have changed
+    mapPages();
+    const auto* bootPage = m_bootRom ? m_boot.data() : m_cartridge.readPage(0);
+    if (m_pages.read[0] != bootPage) {
+        m_pages.read[0] = bootPage;
+        m_cpu.flushCode(0x0000, 0x00FF);
+    }
+    m_cpu.flushCode(0x8000, 0xFFFF);
+
+    if (dma.active) {
+        m_dmaPages = m_pages;
+        m_pages.read.fill(nullptr);
+        m_pages.write.fill(nullptr);
     }
+    m_dma = dma; // a finished transfer still has its source saved
+}
+
+#ifdef TAMEBOY_BENCHMARK
+// Times taking and restoring a state, then checks that a frame run twice from the same state ends the same
+void Bus::benchmarkSaveStates()
+{
+    constexpr int rounds = 1000;
+    std::vector<uint8_t> state(stateSize());
+    std::vector<uint8_t> first(state.size());
+    std::vector<uint8_t> second(state.size());
+
+    const auto saveStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        saveState(state.data(), state.size());
+    }
+    const auto loadStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        loadState(state.data(), state.size());
+    }
+    const auto loadEnd = std::chrono::steady_clock::now();
+
+    const auto replay = [this, &state](std::vector<uint8_t>& result) {
+        loadState(state.data(), state.size());
+        runFrames(1);
+        saveState(result.data(), result.size());
+    };
+    replay(first);
+    replay(second);
 
-    const auto bytes = fs.tellg();
-    fs.seekg(0);
-    fs.read(buffer, bytes);
+    const std::chrono::duration<double, std::micro> saveTime = loadStart - saveStart;
+    const std::chrono::duration<double, std::micro> loadTime = loadEnd - loadStart;
+    std::cout << std::dec << "Save state: " << state.size() << " bytes, save=" << saveTime.count() / rounds
+        << " us load=" << loadTime.count() / rounds << " us, replayed frame " << (first == second ? "identical" : "differs") << "\n";
 }
-  
+#endif
+
 void Bus::compareLogo()
 {
     for(int i=0; i<48; ++i) {
-        if(m_map[0x104 + i] != m_boot[0xA8 + i]) {
+        if(m_cartridge.rom()[0x104 + i] != m_boot.data()[0xA8 + i]) {
             std::cout << i << " ";
             throw std::runtime_error("Logos don't match!");
         }
     }
 }
 
+// Everything the boot ROM leaves behind, so starting without it looks the same to the cartridge
+void Bus::postBoot()
+{
+    // I/O registers as they read at 0x0100, the write-only and unused bits read as 1. DIV, TIMA,
+    // TMA and TAC are the timer's, which starts out disabled.
+    constexpr std::array<std::pair<uint16_t, uint8_t>, 31> registers{ {
+        { 0xFF00, 0xCF }, // P1
+        { 0xFF01, 0x00 }, // SB
+        { 0xFF02, 0x7E }, // SC
+        { 0xFF0F, 0xE1 }, // IF, VBlank left over from the logo
+        { 0xFF10, 0x80 }, // NR10
+        { 0xFF11, 0xBF }, // NR11
+        { 0xFF12, 0xF3 }, // NR12
+        { 0xFF13, 0xFF }, // NR13
+        { 0xFF14, 0xBF }, // NR14
+        { 0xFF16, 0x3F }, // NR21
+        { 0xFF17, 0x00 }, // NR22
+        { 0xFF18, 0xFF }, // NR23
+        { 0xFF19, 0xBF }, // NR24
+        { 0xFF1A, 0x7F }, // NR30
+        { 0xFF1B, 0xFF }, // NR31
+        { 0xFF1C, 0x9F }, // NR32
+        { 0xFF1D, 0xFF }, // NR33
+        { 0xFF1E, 0xBF }, // NR34
+        { 0xFF20, 0xFF }, // NR41
+        { 0xFF21, 0x00 }, // NR42
+        { 0xFF22, 0x00 }, // NR43
+        { 0xFF23, 0xBF }, // NR44
+        { 0xFF24, 0x77 }, // NR50
+        { 0xFF25, 0xF3 }, // NR51
+        { 0xFF26, 0xF1 }, // NR52, channel 1 still on after the chime
+        { 0xFF40, 0x91 }, // LCDC
+        { 0xFF41, 0x85 }, // STAT, VBlank with LY matching LYC
+        { 0xFF44, 0x00 }, // LY
+        { 0xFF46, 0xFF }, // DMA
+        { 0xFF50, 0x01 }, // boot ROM off
+        { 0xFFFF, 0x00 }, // IE
+    } };
+    for (const auto& [addr, value] : registers) {
+        io(addr) = value;
+    }
+    // The palettes through their handlers, which keep the PPU lookups
+    write(0xFF47, 0xFC); // BGP
+    write(0xFF48, 0xFF); // OBP0
+    write(0xFF49, 0xFF); // OBP1
+
+    // The cartridge logo as the boot ROM scrolled it in, every bit doubled in width and every
+    // row doubled in height, in tiles 1 to 24 and the ® in tile 25. Only bitplane 0 is set.
+    const auto* logo = m_cartridge.rom() + 0x104;
+    auto* tile = m_map.get() + 0x8010;
+    for (int i = 0; i < 48; ++i) {
+        for (const auto nibble : { logo[i] >> 4, logo[i] & 0x0F }) {
+            uint8_t row = 0;
+            for (int bit = 3; bit >= 0; --bit) {
+                row = static_cast<uint8_t>((row << 2) | (((nibble >> bit) & 1) * 0b11));
+            }
+            tile[0] = row;
+            tile[2] = row;
+            tile += 4;
+        }
+    }
+    constexpr std::array<uint8_t, 8> registered{ 0x3C, 0x42, 0xB9, 0xA5, 0xB9, 0xA5, 0x42, 0x3C };
+    for (const auto row : registered) {
+        tile[0] = row;
+        tile += 2;
+    }
+    // Tile map rows 8 and 9 from column 4, the ® closes the first
+    for (uint8_t i = 0; i < 12; ++i) {
+        m_map[0x9904 + i] = i + 1;
+        m_map[0x9924 + i] = i + 13;
+    }
+    m_map[0x9910] = 0x19;
+
+    m_timer.presetCounter(postBootCounter);
+    m_ppu.setLinePhase(postBootLine, postBootLineDots);
+}
+
 void Bus::printState()
 {
     std::cout << std::hex << "System registers:\n"
         // Timer registers
-        << "TIMA(0xFF05)=" << static_cast<int>(m_map[0xFF05]) << " "  // Timer counter
-        << "TMA(0xFF06)=" << static_cast<int>(m_map[0xFF06]) << " "  // Timer modulo
-        << "TAC(0xFF07)=" << static_cast<int>(m_map[0xFF07]) << " "  // Timer control
+        << "TIMA(0xFF05)=" << static_cast<int>(read(0xFF05)) << " "  // Timer counter
+        << "TMA(0xFF06)=" << static_cast<int>(read(0xFF06)) << " "  // Timer modulo
+        << "TAC(0xFF07)=" << static_cast<int>(read(0xFF07)) << " "  // Timer control
 
         // LCD control & status
         << "LCDC(0xFF40)=" << static_cast<int>(m_map[0xFF40]) << " "  // LCD Control
@@ -1,45 +1,236 @@
 #pragma once
 
 #include "CPULR35902.hpp"
+#include "Cartridge.hpp"
+#include "MappedFile.hpp"
 #include "PPU.hpp"
-#include "Screen.hpp"
+#ifdef TAMEBOY_REWIND
+#include "Rewind.hpp"
+#endif
+#include "Scheduler.hpp"
 #include "Sound.hpp"
+#include "Timer.hpp"
+#include "VideoSink.hpp"
 
+#include <array>
 #include <cassert>
+#include <functional>
 #include <iostream>
 #include <memory>
 
+// Snapshots for rewinding, kept in a ring of budget bytes. An interval of 0 keeps none.
+struct RewindSettings {
+    size_t budget = 32 * 1024 * 1024;
+    uint32_t interval = 4; // frames between snapshots
+    uint32_t speed = 1; // snapshots stepped back per frame while rewinding
+};
+
+// The machine. Everything it keeps is per instance, frames and audio go to the sinks of the
+// caller, without them the bus runs headless. Without a boot ROM file it starts from the state
+// the boot ROM leaves behind. Without saveFile battery RAM starts blank and is not written
+// back, for runs that must not depend on or change the .sav next to the ROM.
 class Bus {
 public:
-    Bus(bool bootRom = true);
+    Bus(const char* romFilename, const char* bootRomFilename = nullptr, VideoSink* video = nullptr,
+        AudioSink* audio = nullptr, bool saveFile = true);
     void start();
-    uint8_t read(uint16_t addr);
-    void write(uint16_t addr, uint8_t value);
+    // Runs up to the start of the frame that many frames ahead, stopping at the first event from there
+    void runFrames(uint64_t frames);
+    // One instruction and the events it reaches, for running two machines side by side
+    void stepInstruction();
+    bool bootRomMapped() const { return m_bootRom; }
+    // Drops the snapshots taken so far, a no-op without TAMEBOY_REWIND
+    void setRewind([[maybe_unused]] const RewindSettings& settings)
+    {
+#ifdef TAMEBOY_REWIND
+        m_rewindSettings = settings;
+        m_rewind = Rewind(this, settings.budget);
+        m_rewindFrames = 0;
+#endif
+    }
+
+    // Plain memory is a single indexed access, pages without a pointer go to the handlers
+    uint8_t read(uint16_t addr)
+    {
+        if (const auto* page = m_pages.read[addr >> 8]) {
+            return page[addr & 0xFF];
+        }
+        return readSpecial(addr);
+    }
+
+    void write(uint16_t addr, uint8_t value)
+    {
+        if (auto* page = m_pages.write[addr >> 8]) {
+            page[addr & 0xFF] = value;
+            return;
+        }
+        writeSpecial(addr, value);
+    }
+
+    // I/O registers 0xFF00-0xFF7F are claimed by the component owning them. CPU writes keep the
+    // bits outside the writable mask, a hook replaces the plain store or load of the register.
+    using IoRead = std::function<uint8_t()>;
+    using IoWrite = std::function<void(uint8_t value)>;
+    void mapIo(uint16_t addr, uint8_t writable, IoWrite write = {}, IoRead read = {})
+    {
+        m_io[addr - 0xFF00] = { std::move(read), std::move(write), writable };
+    }
+
+    // Register storage without hooks or masks, for the owner updating its own registers
+    uint8_t& io(uint16_t addr) { return m_map[addr]; }
+
+    // The whole machine as a versioned fixed layout blob, see SaveState.hpp. The caller provides
+    // a buffer of stateSize() bytes, saving and loading copy into it without allocating.
+    size_t stateSize();
+    size_t saveState(uint8_t* data, size_t size);
+    void loadState(const uint8_t* data, size_t size);
+
+    // down, up, left, right, start, select, b, a, active low. Any change requests the joypad interrupt.
+    void setJoypad(uint8_t keys);
+    const std::vector<uint8_t>& frameBuffer() const { return m_ppu.getFrameBuffer(); }
+    // The frame before RGBA conversion, one shade 0-3 per pixel
+    const std::vector<uint8_t>& shadeBuffer() const { return m_ppu.getShadeBuffer(); }
+    // Bytes sent over the link cable, std::cout by default
+    void setSerialOutput(std::ostream& output) { m_serialOutput = &output; }
+
+    // Checks translated code against the interpreter, see CPULR35902::setLockstep
+    bool setLockstep(bool enabled) { return m_cpu.setLockstep(enabled); }
+    uint64_t lockstepChecks() const { return m_cpu.lockstepChecks(); }
+
+    uint64_t cycles() const { return m_cycleCounter; }
+    Scheduler& scheduler() { return m_scheduler; }
+    // OAM DMA has the CPU cut off from everything below 0xFF00
+    bool dmaBlocking() const { return m_dma.blocking; }
+
+    // Writes to pages holding decoded code take the handler so the code can be dropped
+    void trapWrites(uint8_t page) { mapping().write[page] = nullptr; }
+    void untrapWrites(uint8_t page) { mapping().write[page] = writablePage(page); }
+    const uint8_t* readPage(uint8_t page) const { return mapping().read[page]; }
 
     // debug
     uint8_t* getMap() { return m_map.get(); }
+    std::array<uint16_t, 6> cpuRegisters() { return m_cpu.registers(); }
     void printState();
     void printOam();
     void printAudio();
 
     void forceDraw()
     {
-        m_ppu.updateDebugVramDisplays();
-        m_screen.updateDebug(m_ppu.getTileDataBuffer(), m_ppu.getTileMapBuffer(), m_ppu.getObjectBuffer());
+        if (m_video && m_video->wantsDebug()) {
+            m_ppu.updateDebugVramDisplays();
+            m_video->presentDebug(m_ppu.getTileDataBuffer(), m_ppu.getTileMapBuffer(), m_ppu.getObjectBuffer());
+        }
     }
 
 private:
-    void readFile(char* buffer, const char* filename);
+    // Host memory behind each 256 byte page, nullptr sends the access to the handlers
+    struct PageTable {
+        std::array<const uint8_t*, 256> read{};
+        std::array<uint8_t*, 256> write{};
+    };
+
+    // The memory map, moved aside while OAM DMA holds the bus
+    PageTable& mapping() { return m_dma.active ? m_dmaPages : m_pages; }
+    const PageTable& mapping() const { return m_dma.active ? m_dmaPages : m_pages; }
+
+    uint8_t readSpecial(uint16_t addr);
+    void writeSpecial(uint16_t addr, uint8_t value);
+    void mapPages();
+    void mapCartridge();
+    void mapRegisters();
+    void flushSave();
+    uint8_t* writablePage(uint8_t page)
+    {
+        if (page >= 0xA0 && page < 0xC0) {
+            return m_cartridge.writePage(page);
+        }
+        if (page >= 0x80 && page < 0x98) {
+            return nullptr; // tile data, the PPU keeps it decoded
+        }
+        return (page >= 0x98 && page < 0xFF) ? m_map.get() + (page << 8) : nullptr;
+    }
+
+    void step();
+    void runEvents();
+#ifdef TAMEBOY_REWIND
+    void updateRewind();
+#endif
+    void updateScreens();
+    void syncPPU();
+    void schedulePPU();
+    void startDma(uint8_t source);
+    void copyDma(uint64_t cycle);
+    void endDma(uint64_t cycle);
+
     void compareLogo();
+    void postBoot();
+#ifdef TAMEBOY_BENCHMARK
+    void benchmarkSaveStates();
+#endif
+
+    void saveState(StateWriter& state);
 
     bool m_bootRom;
-    std::unique_ptr<uint8_t[]> m_boot = nullptr;
+    VideoSink* m_video{};
+    uint8_t m_joypad = 0xFF;
+    std::ostream* m_serialOutput = &std::cout;
+    MappedFile m_boot{};
     std::unique_ptr<uint8_t[]> m_map = nullptr;
+    Cartridge m_cartridge;
+
+    struct IoRegister {
+        IoRead read{};
+        IoWrite write{};
+        uint8_t writable = 0xFF;
+    };
+    std::array<IoRegister, 0x80> m_io{}; // before the components registering into it
     CPULR35902 m_cpu;
+    Timer m_timer;
     PPU m_ppu;
-    Screen m_screen;
     Sound m_sound;
 
-    uint64_t m_instructionCounter{};
+    PageTable m_pages{};
+    PageTable m_dmaPages{};
+
+    // OAM DMA. The CPU only reaches 0xFF00-0xFFFF until it ends, OAM is filled in one copy
+    // at the end unless the PPU looks at it earlier.
+    struct OamDma {
+        bool active = false;
+        bool blocking = false; // CPU accesses below 0xFF00 are cut off, events still see memory
+        uint16_t source{};
+        uint64_t start{};
+        uint8_t copied{};
+    };
+    OamDma m_dma{};
+    static constexpr uint64_t dmaStartDelay = 4;
+    static constexpr uint64_t dmaLength = 640; // 160 M-cycles, one byte each
+
+    Scheduler m_scheduler;
+    uint64_t m_ppuCycle{};
+
+#ifdef TAMEBOY_REWIND
+    RewindSettings m_rewindSettings{};
+    Rewind m_rewind;
+    uint32_t m_rewindFrames{};
+    bool m_frameDone = false;
+#endif
+
+    static constexpr uint64_t soundClock = 8192; // 512 Hz
+    static constexpr uint64_t screenUpdateClock = 70224; // one frame
+    static constexpr uint64_t saveFlushClock = 60 * screenUpdateClock;
+
+    // Where a DMG is when the boot ROM jumps to 0x0100: DIV at 0xAB and LY already reading 0 in
+    // line 153, which it does from dot 4 on. tameboy-batch --boot-check compares against the boot ROM.
+    static constexpr uint8_t postBootLine = 153;
+    static constexpr uint32_t postBootLineDots = 4;
+    static constexpr uint16_t postBootCounter = 0xABCC;
+
+    static constexpr uint32_t stateMagic = 0x54534254; // "TBST"
+    static constexpr uint32_t stateVersion = 3;
+
     uint64_t m_cycleCounter{};
+    uint64_t m_events{};
+    uint64_t m_haltSkips{};
+    uint64_t m_idleSkips{};
+    uint64_t m_cyclesSkipped{};
 };
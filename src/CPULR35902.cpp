@@ -1,15 +1,33 @@
 #include "CPULR35902.hpp"
 
 #include "Bus.hpp"
+#include "SaveState.hpp"
 
-#include <iostream>
+#include <algorithm>
 #include <fstream>
+#include <iomanip>
+#include <iostream>
 #include <sstream>
 #include <string>
 
-CPULR35902::CPULR35902(Bus* bus) : m_bus(bus)
+CPULR35902::CPULR35902(Bus* bus) :
+    m_bus(bus)
+#ifdef TAMEBOY_BLOCK_CACHE
+    , m_blockCache(bus)
+#endif
+#ifdef TAMEBOY_RECOMPILER
+    , m_recompiler(bus, m_blockCache)
+#endif
 {
-    initOpcodeHandlers();
+#ifndef TAMEBOY_SWITCH_DISPATCH
+    initOpcodeHandlers<false>(m_opcodeHandler, m_prefixHandler);
+#ifdef TAMEBOY_DEBUGGER
+    initOpcodeHandlers<true>(m_tracedOpcodeHandler, m_tracedPrefixHandler);
+#endif
+#endif
+#ifdef TAMEBOY_RECOMPILER_LOCKSTEP
+    m_lockstep = true;
+#endif
     //m_pcOfInterest = 0x100;
     //m_instructionCountOfInterest = 8300664;
 
@@ -23,9 +41,12 @@ CPULR35902::CPULR35902(Bus* bus) : m_bus(bus)
 
 void CPULR35902::logTrace()
 {
-    static std::ofstream fs("log.txt", std::ios::binary);
+    if (!m_traceLog.is_open()) {
+        m_traceLog.open("log.txt", std::ios::binary);
+    }
+    materializeFlags();
 
-    fs << std::hex
+    m_traceLog << std::hex
         << "A:" << std::setw(2) << std::setfill('0') << (int)AF.left
         << " F:" << std::setw(2) << std::setfill('0') << (int)AF.right
         << " B:" << std::setw(2) << std::setfill('0') << (int)BC.left
@@ -46,6 +67,7 @@ void CPULR35902::logTrace()
 
 void CPULR35902::printState()
 {
+    materializeFlags();
     std::cout << std::hex << "CPU state:\n"
         << "AF=" << AF.w << " "
         << "BC=" << BC.w << " "
@@ -70,6 +92,7 @@ void CPULR35902::logInstruction(std::string str, bool newLine)
 
 void CPULR35902::reset(bool bootRom)
 {
+    discardFlags();
     if (bootRom) {
         AF.w = 0;
         BC.w = 0;
@@ -79,9 +102,10 @@ void CPULR35902::reset(bool bootRom)
         PC.w = 0x0;
     }
     else {
-        // Post bootrom state (partial)
+        // Post bootrom state, the bus sets up memory and the I/O registers. H and C are
+        // left set by the header checksum loop unless the checksum byte is 0.
         AF.left = 0x01;
-        AF.right = 0xB0;
+        AF.right = m_bus->read(0x014D) ? 0xB0 : 0x80;
         BC.left = 0x00;
         BC.right = 0x13;
         DE.left = 0x00;
@@ -90,76 +114,248 @@ void CPULR35902::reset(bool bootRom)
         HL.right = 0x4D;
         SP.w = 0xFFFE;
         PC.w = 0x0100;
-
-        // Interrupts
         m_interruptMasterEnable = false;
-        m_bus->write(0xFFFF, 0x00); // IE
-        m_bus->write(0xFF0F, 0xE1); // IF
+    }
+}
 
-        // Timers
-        m_bus->write(0xFF05, 0x00); // TIMA
-        m_bus->write(0xFF06, 0x00); // TMA
-        m_bus->write(0xFF07, 0x00); // TAC
+std::array<uint16_t, 6> CPULR35902::registers()
+{
+    materializeFlags();
+    return { AF.w, BC.w, DE.w, HL.w, SP.w, PC.w };
+}
 
-        // LCD and graphics
-        m_bus->write(0xFF40, 0x91); // LCDC: BG/WIN enabled, display on
-        m_bus->write(0xFF41, 0x85); // STAT
-        m_bus->write(0xFF42, 0x00); // SCY
-        m_bus->write(0xFF43, 0x00); // SCX
-        m_bus->write(0xFF44, 0x00); // LY
-        m_bus->write(0xFF45, 0x00); // LYC
-        m_bus->write(0xFF47, 0xFC); // BGP
-        m_bus->write(0xFF48, 0xFF); // OBP0
-        m_bus->write(0xFF49, 0xFF); // OBP1
-        m_bus->write(0xFF4A, 0x00); // WY
-        m_bus->write(0xFF4B, 0x00); // WX
+void CPULR35902::saveState(StateWriter& state)
+{
+    materializeFlags();
+    for (const auto& reg : { AF, BC, DE, HL, SP, PC }) {
+        state.put(reg.w);
     }
+    state.put(m_halt);
+    state.put(m_stop);
+    state.put(m_interruptMasterEnable);
 }
 
-void CPULR35902::setFlags(int Z, int  N, int  H, int C) 
+void CPULR35902::loadState(StateReader& state)
 {
-    const auto set = [this](Flag flag, bool high)
-    {
-        uint8_t mask = 0;
-        switch(flag) {
-            using enum Flag;
-            case Z : { mask = 0b10000000; break; }
-            case N : { mask = 0b01000000; break; }
-            case H : { mask = 0b00100000; break; }
-            case C : { mask = 0b00010000; break; }
-        }
+    discardFlags();
+    for (auto* reg : { &AF, &BC, &DE, &HL, &SP, &PC }) {
+        state.get(reg->w);
+    }
+    state.get(m_halt);
+    state.get(m_stop);
+    state.get(m_interruptMasterEnable);
+
+#ifdef TAMEBOY_BLOCK_CACHE
+    m_cursor = m_cursorEnd = nullptr;
+#endif
+#ifdef TAMEBOY_IDLE_LOOPS
+    m_idleSnapshot.valid = false;
+    m_idleLoopPending = false;
+    m_idleLoopDecided = false;
+#endif
+}
 
-        if(high)
+void CPULR35902::setFlags(int Z, int N, int H, int C)
+{
+#ifdef TAMEBOY_LAZY_FLAGS
+    if (Z < 0 || N < 0 || H < 0 || C < 0) {
+        materializeFlags();
+    }
+    else {
+        m_lazyFlags.op = FlagOp::None;
+    }
+#endif
+
+    const auto set = [this](int value, uint8_t mask)
+    {
+        if (value > 0)
             AF.right |= mask;
-        else
+        else if (value == 0)
             AF.right &= ~mask;
     };
-   
-    if(Z >= 0)
-        set(Flag::Z, Z);
 
-    if(N >= 0)
-        set(Flag::N, N);
+    set(Z, 0b10000000);
+    set(N, 0b01000000);
+    set(H, 0b00100000);
+    set(C, 0b00010000);
+}
+
+bool CPULR35902::getFlag(Flag flag)
+{
+    const auto mask = static_cast<uint8_t>(0b10000000 >> flag);
+#ifdef TAMEBOY_LAZY_FLAGS
+    if (m_lazyFlags.op != FlagOp::None) {
+#ifdef TAMEBOY_BENCHMARK
+        m_flagsEvaluated++;
+#endif
+        switch (flag) {
+            case Z : { return (m_lazyFlags.result & 0xFF) == 0; }
+            case C : { return m_lazyFlags.result & 0x100; }
+            default : { return evaluateFlags() & mask; }
+        }
+    }
+#endif
+    return AF.right & mask;
+}
 
-    if(H >= 0)
-        set(Flag::H, H);
+// A op= value (+ carry) for the 8 bit ALU group, flags are deferred when TAMEBOY_LAZY_FLAGS is set
+void CPULR35902::add8(uint8_t value, uint8_t carry)
+{
+    const auto a = AF.left;
+    const uint16_t result = a + value + carry;
+    AF.left = static_cast<uint8_t>(result);
+#ifdef TAMEBOY_LAZY_FLAGS
+    deferFlags(FlagOp::Add, a, value, result);
+#else
+    setFlags((AF.left == 0), 0, ((a & 0xF) + (value & 0xF) + carry) > 0xF, result > 0xFF);
+#endif
+}
 
-    if(C >= 0)
-        set(Flag::C, C);
+void CPULR35902::sub8(uint8_t value, uint8_t carry)
+{
+    const auto a = AF.left;
+    const uint16_t result = a - value - carry;
+    AF.left = static_cast<uint8_t>(result);
+#ifdef TAMEBOY_LAZY_FLAGS
+    deferFlags(FlagOp::Sub, a, value, result);
+#else
+    setFlags((AF.left == 0), 1, (a & 0xF) < ((value & 0xF) + carry), a < (value + carry));
+#endif
 }
 
-bool CPULR35902::getFlag(Flag flag)
+void CPULR35902::cp8(uint8_t value)
+{
+#ifdef TAMEBOY_LAZY_FLAGS
+    deferFlags(FlagOp::Sub, AF.left, value, static_cast<uint16_t>(AF.left - value));
+#else
+    setFlags((AF.left == value), 1, (AF.left & 0xF) < (value & 0xF), AF.left < value);
+#endif
+}
+
+void CPULR35902::and8(uint8_t value)
+{
+    AF.left &= value;
+#ifdef TAMEBOY_LAZY_FLAGS
+    deferFlags(FlagOp::And, 0, 0, AF.left);
+#else
+    setFlags((AF.left == 0), 0, 1, 0);
+#endif
+}
+
+void CPULR35902::xor8(uint8_t value)
+{
+    AF.left ^= value;
+#ifdef TAMEBOY_LAZY_FLAGS
+    deferFlags(FlagOp::Or, 0, 0, AF.left);
+#else
+    setFlags((AF.left == 0), 0, 0, 0);
+#endif
+}
+
+void CPULR35902::or8(uint8_t value)
+{
+    AF.left |= value;
+#ifdef TAMEBOY_LAZY_FLAGS
+    deferFlags(FlagOp::Or, 0, 0, AF.left);
+#else
+    setFlags((AF.left == 0), 0, 0, 0);
+#endif
+}
+
+uint8_t CPULR35902::inc8(uint8_t value)
 {
-    switch(flag) {
-        using enum Flag;
-        case Z : { return static_cast<bool>(AF.right & 0b10000000); }
-        case N : { return static_cast<bool>(AF.right & 0b01000000); }
-        case H : { return static_cast<bool>(AF.right & 0b00100000); }
-        case C : { return static_cast<bool>(AF.right & 0b00010000); }
-        default : { throw std::runtime_error("Invalid flag get!"); }
+    const uint8_t result = value + 1;
+#ifdef TAMEBOY_LAZY_FLAGS
+    deferFlags(FlagOp::Inc, 0, 0, result | (pendingCarry() << 8));
+#else
+    setFlags((result == 0), 0, (value & 0x0F) == 0x0F, -1);
+#endif
+    return result;
+}
+
+uint8_t CPULR35902::dec8(uint8_t value)
+{
+    const uint8_t result = value - 1;
+#ifdef TAMEBOY_LAZY_FLAGS
+    deferFlags(FlagOp::Dec, 0, 0, result | (pendingCarry() << 8));
+#else
+    setFlags((result == 0), 1, (value & 0x0F) == 0, -1);
+#endif
+    return result;
+}
+
+#ifdef TAMEBOY_LAZY_FLAGS
+void CPULR35902::deferFlags(FlagOp op, uint8_t lhs, uint8_t rhs, uint16_t result)
+{
+    m_lazyFlags = { op, lhs, rhs, result };
+#ifdef TAMEBOY_BENCHMARK
+    m_flagsDeferred++;
+#endif
+}
+
+// INC and DEC keep C, which may itself still be pending
+uint16_t CPULR35902::pendingCarry() const
+{
+    if (m_lazyFlags.op == FlagOp::None) {
+        return (AF.right >> 4) & 1;
+    }
+    return (m_lazyFlags.result >> 8) & 1;
+}
+
+uint8_t CPULR35902::evaluateFlags() const
+{
+    const auto& f = m_lazyFlags;
+    const uint8_t zero = ((f.result & 0xFF) == 0) ? 0b10000000 : 0;
+    const uint8_t carry = ((f.result >> 8) & 1) << 4;
+    const uint8_t half = ((f.lhs ^ f.rhs ^ f.result) & 0x10) << 1;
+    switch (f.op) {
+        using enum FlagOp;
+        case Add: { return zero | half | carry; }
+        case Sub: { return zero | 0b01000000 | half | carry; }
+        case And: { return zero | 0b00100000; }
+        case Or: { return zero; }
+        case Inc: { return zero | (((f.result & 0xF) == 0) << 5) | carry; }
+        case Dec: { return zero | 0b01000000 | (((f.result & 0xF) == 0xF) << 5) | carry; }
+        default: { return AF.right & 0xF0; }
     }
 }
+#endif
 
+// Brings F up to date before it is read or written as a whole
+void CPULR35902::materializeFlags()
+{
+#ifdef TAMEBOY_LAZY_FLAGS
+    if (m_lazyFlags.op != FlagOp::None) {
+        AF.right = (AF.right & 0x0F) | evaluateFlags();
+        m_lazyFlags.op = FlagOp::None;
+#ifdef TAMEBOY_BENCHMARK
+        m_flagsEvaluated++;
+#endif
+    }
+#endif
+}
+
+void CPULR35902::discardFlags()
+{
+#ifdef TAMEBOY_LAZY_FLAGS
+    m_lazyFlags.op = FlagOp::None;
+#endif
+}
+
+// Counting is only compiled into benchmark builds, it costs as much as the flags it measures
+void CPULR35902::printFlagStats()
+{
+#if defined(TAMEBOY_LAZY_FLAGS) && defined(TAMEBOY_BENCHMARK)
+    const auto avoided = m_flagsDeferred > m_flagsEvaluated ? m_flagsDeferred - m_flagsEvaluated : 0;
+    std::cout << std::dec << "Lazy flags:\n"
+        << "deferred=" << m_flagsDeferred << " evaluated=" << m_flagsEvaluated << " avoided=" << avoided
+        << " (" << (m_flagsDeferred ? 100.0 * avoided / m_flagsDeferred : 0.0) << "%)\n";
+#else
+    std::cout << "Lazy flag stats need TAMEBOY_LAZY_FLAGS and TAMEBOY_BENCHMARK\n";
+#endif
+}
+
+template<bool Traced>
 void CPULR35902::processInterrupts()
 {
     const auto interruptEnable = m_bus->read(0xFFFF);
@@ -167,6 +363,9 @@ void CPULR35902::processInterrupts()
     if (interruptEnable & interruptFlag) {
         m_halt = false;
     }
+    if (interruptFlag & (1 << static_cast<int>(Interrupt::Joypad))) {
+        m_stop = false;
+    }
 
     if (!m_interruptMasterEnable) {
         return;
@@ -184,7 +383,7 @@ void CPULR35902::processInterrupts()
                 write16(SP.w, PC.w);
                 PC.w = addr;
 
-                if(m_debug)
+                if constexpr (Traced)
                     logInstruction("INT " + toHexString(addr), false);
             };
             
@@ -221,10 +420,10 @@ void CPULR35902::processInterrupts()
     }
 }
 
+#ifdef TAMEBOY_DEBUGGER
 void CPULR35902::processDebugger()
 {
-    static bool helped = false;
-    if (!helped) {
+    if (!m_debuggerHelpShown) {
         std::cout <<
 R"(TameBoy Debugger v0.1
         X : run X instructions (dec)
@@ -235,9 +434,13 @@ R"(TameBoy Debugger v0.1
         pX : increment PC by X (0-9)
         cX : break at PC == X (hex)
         d : draw tile maps
+        b : dump block cache stats
+        f : dump lazy flag stats
+        l : toggle recompiler lockstep check
+        i : toggle idle loop skipping, dump idle loop stats
         mX : print byte (hex)
 )";
-        helped = true;
+        m_debuggerHelpShown = true;
     }
     while (true) {
         try {
@@ -258,6 +461,25 @@ R"(TameBoy Debugger v0.1
             else if (str == "a") {
                 m_bus->printAudio();
             }
+            else if (str == "b") {
+                printBlockCacheStats();
+            }
+            else if (str == "f") {
+                printFlagStats();
+            }
+#ifdef TAMEBOY_IDLE_LOOPS
+            else if (str == "i") {
+                m_idleLoopSkipping = !m_idleLoopSkipping;
+                m_idleSnapshot.valid = false;
+                printIdleLoopStats();
+            }
+#endif
+#ifdef TAMEBOY_RECOMPILER
+            else if (str == "l") {
+                m_lockstep = !m_lockstep;
+                std::cout << "recompiler lockstep " << (m_lockstep ? "on" : "off") << std::endl;
+            }
+#endif
             else if (str == "d") {
                 std::cout << "tile maps drawn" << std::endl;
                 m_bus->forceDraw();
@@ -265,8 +487,7 @@ R"(TameBoy Debugger v0.1
             else if (str[0] == 'm') {
                 const auto end = str.find_first_of(' ');
                 const auto addr = std::stoi(str.substr(1, end), nullptr, 16);
-                const auto& map = m_bus->getMap();
-                std::cout << std::hex << "0x" << addr << ": " << (int)map[addr] << std::endl;
+                std::cout << std::hex << "0x" << addr << ": " << (int)m_bus->read(static_cast<uint16_t>(addr)) << std::endl;
             }
             else if (str[0] == 'c') {
                 const auto end = str.find_first_of(' ');
@@ -296,49 +517,377 @@ R"(TameBoy Debugger v0.1
     std::cout << std::dec << m_instructionCounter << ": "
         << std::hex << "PC=" << static_cast<int>(PC.w) << " ";
 }
+#endif
 
 uint64_t CPULR35902::fetchDecodeExecute()
 {
-    //logTrace();
-    const uint64_t Tstart = T;
-
+#ifdef TAMEBOY_DEBUGGER
     const auto breakAtThisPc = (PC.w == m_pcOfInterest) && m_pcSearch;
     const auto breakAtThisInstruction = (m_instructionCounter == m_instructionCountOfInterest) && !m_pcSearch;
     if (breakAtThisPc || breakAtThisInstruction) {
         m_debug = true;
     }
-    
+
     if (m_debug) {
         processDebugger();
+        if (m_debug) {
+            return execute<true>();
+        }
     }
+#endif
 
-    processInterrupts();
+    return execute<false>();
+}
+
+template<bool Traced>
+uint64_t CPULR35902::execute()
+{
+    //logTrace();
+    const uint64_t Tstart = T;
+
+    processInterrupts<Traced>();
 
     if (m_halt || m_stop)
         return 4;
 
-    const auto instruction = m_bus->read(PC.w);
-    PC.w++;
-    if (m_debug)
+#if defined(TAMEBOY_RECOMPILER) || defined(TAMEBOY_IDLE_LOOPS)
+    // Translated blocks and idle loops are entered on block boundaries only, interrupts were checked above
+    if constexpr (!Traced) {
+        if (m_cursor == m_cursorEnd || m_cursor->address != PC.w) {
+            auto& block = m_blockCache.get(PC.w);
+            m_cursor = block.instructions.data();
+            m_cursorEnd = m_cursor + block.instructions.size();
+#ifdef TAMEBOY_IDLE_LOOPS
+            if (trackIdleLoop(block)) {
+                return 0;
+            }
+#endif
+#ifdef TAMEBOY_RECOMPILER
+            if (runRecompiled(block)) {
+                return T - Tstart;
+            }
+#endif
+        }
+    }
+#endif
+
+    executeInstruction<Traced>();
+    m_instructionCounter++;
+
+    return T - Tstart;
+}
+
+template<bool Traced>
+void CPULR35902::executeInstruction()
+{
+#ifdef TAMEBOY_BLOCK_CACHE
+    const auto instruction = fetchOpcode();
+#else
+    const auto instruction = fetch8();
+#endif
+    if constexpr (Traced)
         logInstruction(toHexString(instruction), false);
 
     if(instruction == 0xCB) {
-        const auto prefixInstruction = m_bus->read(PC.w);
-        PC.w++;
-        if (m_debug)
+        const auto prefixInstruction = fetch8();
+        if constexpr (Traced)
             logInstruction(toHexString(prefixInstruction), false);
         
-        m_prefixHandler[prefixInstruction]();
+#ifdef TAMEBOY_SWITCH_DISPATCH
+        dispatchPrefix<Traced>(prefixInstruction);
+#else
+#ifdef TAMEBOY_DEBUGGER
+        if constexpr (Traced)
+            m_tracedPrefixHandler[prefixInstruction]();
+        else
+#endif
+            m_prefixHandler[prefixInstruction]();
+#endif
     }
     else {
-        m_opcodeHandler[instruction]();
+#ifdef TAMEBOY_SWITCH_DISPATCH
+        dispatch<Traced>(instruction);
+#else
+#ifdef TAMEBOY_DEBUGGER
+        if constexpr (Traced)
+            m_tracedOpcodeHandler[instruction]();
+        else
+#endif
+            m_opcodeHandler[instruction]();
+#endif
     }
+}
 
-    m_instructionCounter++;
+#ifdef TAMEBOY_BLOCK_CACHE
+uint8_t CPULR35902::fetchOpcode()
+{
+    m_blockCache.recordFetch();
+    if (m_cursor == m_cursorEnd || m_cursor->address != PC.w) {
+        const auto& block = m_blockCache.get(PC.w);
+        m_cursor = block.instructions.data();
+        m_cursorEnd = m_cursor + block.instructions.size();
+    }
 
-    return T - Tstart;
+    const auto& decoded = *m_cursor++;
+    m_operands = decoded.operands;
+    m_operandIndex = 0;
+    PC.w++;
+    return decoded.opcode;
+}
+
+uint8_t CPULR35902::fetch8() {
+    PC.w++;
+    return m_operands[m_operandIndex++];
+}
+
+uint16_t CPULR35902::fetch16() {
+    PC.w += 2;
+    m_operandIndex += 2;
+    return static_cast<uint16_t>(m_operands[0] | (m_operands[1] << 8));
+}
+#else
+uint8_t CPULR35902::fetch8() {
+    return m_bus->read(PC.w++);
+}
+
+uint16_t CPULR35902::fetch16() {
+    const auto value = read16(PC.w);
+    PC.w += 2;
+    return value;
+}
+#endif
+
+void CPULR35902::printBlockCacheStats()
+{
+#ifdef TAMEBOY_BLOCK_CACHE
+    m_blockCache.printStats();
+#ifdef TAMEBOY_RECOMPILER
+    m_recompiler.printStats();
+#endif
+#else
+    std::cout << "Block cache disabled\n";
+#endif
+}
+
+void CPULR35902::printIdleLoopStats()
+{
+#ifdef TAMEBOY_IDLE_LOOPS
+    std::cout << "Idle loops" << (m_idleLoopSkipping ? "" : " (skipping off)") << ":\n";
+    for (const auto& [pc, stats] : m_idleLoopStats) {
+        std::cout << std::hex << "PC=" << pc << " reads=";
+        for (const auto addr : stats.reads) {
+            std::cout << addr << " ";
+        }
+        std::cout << std::dec << "detections=" << stats.detections << " skips=" << stats.skips
+            << " iterations=" << stats.iterations << " cycles=" << stats.cycles << "\n";
+    }
+#else
+    std::cout << "Idle loop detection disabled\n";
+#endif
 }
 
+#ifdef TAMEBOY_IDLE_LOOPS
+// Stops at the head of a loop that made a full pass without changing a register or any byte it reads.
+// Every further pass is identical until one of those bytes changes, so the bus may skip them.
+bool CPULR35902::trackIdleLoop(const Block& block)
+{
+    if (m_idleLoopDecided) { // the bus already had its chance at this entry, unless an interrupt moved on
+        m_idleLoopDecided = false;
+        if (PC.w == m_idleLoop.pc) {
+            return false;
+        }
+    }
+    // Polled values read as 0xFF during OAM DMA, a loop seen then says nothing about the rest of the time
+    if (!m_idleLoopSkipping || !block.idleCandidate || m_bus->dmaBlocking()) {
+        m_idleSnapshot.valid = false;
+        return false;
+    }
+
+    std::array<uint16_t, maxIdleReads> reads{};
+    std::array<uint8_t, maxIdleReads> values{};
+    size_t readCount = 0;
+    for (const auto& decoded : block.instructions) {
+        const auto opcode = decoded.opcode;
+        const auto readsHL = (opcode >= 0x40 && opcode < 0xC0 && (opcode & 0x07) == 0x06 && opcode != 0x76) ||
+            (opcode == 0xCB && (decoded.operands[0] & 0x07) == 0x06);
+        uint16_t addr{};
+        if (opcode == 0xF0) {
+            addr = 0xFF00 | decoded.operands[0];
+        }
+        else if (opcode == 0xFA) {
+            addr = static_cast<uint16_t>(decoded.operands[0] | (decoded.operands[1] << 8));
+        }
+        else if (readsHL) {
+            addr = HL.w;
+        }
+        else {
+            continue;
+        }
+        if (readCount == maxIdleReads) {
+            m_idleSnapshot.valid = false;
+            return false;
+        }
+        reads[readCount] = addr;
+        values[readCount] = m_bus->read(addr);
+        readCount++;
+    }
+
+    materializeFlags();
+    const std::array<uint16_t, 5> registers{ AF.w, BC.w, DE.w, HL.w, SP.w };
+    const auto previous = m_idleSnapshot;
+    m_idleSnapshot = { PC.w, registers, values, T, m_instructionCounter, true };
+    if (!previous.valid || previous.pc != PC.w || previous.registers != registers || previous.values != values ||
+        T == previous.T) {
+        return false;
+    }
+
+    m_idleLoop.pc = PC.w;
+    m_idleLoop.cycles = static_cast<uint32_t>(T - previous.T);
+    m_idleLoop.instructions = static_cast<uint32_t>(m_instructionCounter - previous.instructions);
+    m_idleLoop.reads = reads;
+    m_idleLoop.readCount = readCount;
+    m_idleLoopPending = true;
+
+    auto& stats = m_idleLoopStats[PC.w];
+    stats.reads.assign(reads.begin(), reads.begin() + readCount);
+    stats.detections++;
+    return true;
+}
+
+void CPULR35902::skipIdleLoop(uint64_t iterations)
+{
+    m_idleLoopPending = false;
+    m_idleLoopDecided = true;
+    if (!iterations) {
+        return;
+    }
+
+    T += iterations * m_idleLoop.cycles;
+    m_instructionCounter += iterations * m_idleLoop.instructions;
+    m_idleSnapshot.T = T;
+    m_idleSnapshot.instructions = m_instructionCounter;
+
+    auto& stats = m_idleLoopStats[m_idleLoop.pc];
+    stats.skips++;
+    stats.iterations += iterations;
+    stats.cycles += iterations * m_idleLoop.cycles;
+}
+#endif
+
+#ifdef TAMEBOY_RECOMPILER
+uint64_t CPULR35902::runRecompiled(Block& block)
+{
+    // Native code does not check for events, the whole block has to run before the next one is due.
+    // It also maps work RAM directly, which the CPU cannot reach while OAM DMA blocks it.
+    if (m_bus->dmaBlocking() || m_bus->cycles() + block.cycles + Recompiler::takenBranchCycles > m_bus->scheduler().next()) {
+        return 0;
+    }
+
+    const auto native = m_recompiler.lookup(block);
+    if (!native) {
+        return 0;
+    }
+
+    materializeFlags();
+    auto& state = m_recompiler.state();
+    state.a = AF.left;
+    state.f = AF.right;
+    state.b = BC.left;
+    state.c = BC.right;
+    state.d = DE.left;
+    state.e = DE.right;
+    state.h = HL.left;
+    state.l = HL.right;
+    state.sp = SP.w;
+
+    // Work RAM and HRAM are all translated code can write
+    const auto* map = m_bus->getMap();
+    const auto snapshot = [map](std::vector<uint8_t>& memory) {
+        memory.assign(map + 0xC000, map + 0xE000);
+        memory.insert(memory.end(), map + 0xFF80, map + 0xFFFF);
+    };
+    if (m_lockstep) {
+        snapshot(m_lockstepMemory);
+    }
+
+    const auto cycles = native(&state);
+    if (state.instructions == 0) {
+        return 0;
+    }
+    m_recompiler.recordRun(state.instructions, state.instructions < block.instructions.size());
+
+    if (m_lockstep) {
+        snapshot(m_nativeMemory);
+        verifyRecompiled(state, cycles);
+        return cycles;
+    }
+
+    AF.left = state.a;
+    AF.right = state.f;
+    BC.left = state.b;
+    BC.right = state.c;
+    DE.left = state.d;
+    DE.right = state.e;
+    HL.left = state.h;
+    HL.right = state.l;
+    SP.w = state.sp;
+    PC.w = state.pc;
+    T += cycles;
+    m_instructionCounter += state.instructions;
+    m_cursor += state.instructions;
+    return cycles;
+}
+
+// Rewinds the translated run and repeats it on the interpreter, which must end in the same state
+void CPULR35902::verifyRecompiled(const RecompilerState& native, uint32_t cycles)
+{
+    auto* map = m_bus->getMap();
+    std::copy(m_lockstepMemory.begin(), m_lockstepMemory.begin() + 0x2000, map + 0xC000);
+    std::copy(m_lockstepMemory.begin() + 0x2000, m_lockstepMemory.end(), map + 0xFF80);
+
+    const auto blockStart = PC.w;
+    const auto Tstart = T;
+    for (uint32_t i = 0; i < native.instructions; ++i) {
+        executeInstruction<false>();
+    }
+    m_instructionCounter += native.instructions;
+    m_recompiler.recordVerified();
+    materializeFlags();
+
+    std::string mismatch{};
+    const auto compare = [&](const char* name, int interpreted, int translated) {
+        if (interpreted != translated) {
+            mismatch += std::string(" ") + name + "=" + toHexString(interpreted) + "/" + toHexString(translated);
+        }
+    };
+    compare("A", AF.left, native.a);
+    compare("F", AF.right, native.f);
+    compare("B", BC.left, native.b);
+    compare("C", BC.right, native.c);
+    compare("D", DE.left, native.d);
+    compare("E", DE.right, native.e);
+    compare("H", HL.left, native.h);
+    compare("L", HL.right, native.l);
+    compare("SP", SP.w, native.sp);
+    compare("PC", PC.w, native.pc);
+    compare("cycles", static_cast<int>(T - Tstart), static_cast<int>(cycles));
+
+    m_lockstepMemory.assign(map + 0xC000, map + 0xE000);
+    m_lockstepMemory.insert(m_lockstepMemory.end(), map + 0xFF80, map + 0xFFFF);
+    for (size_t i = 0; i < m_nativeMemory.size(); ++i) {
+        if (m_lockstepMemory[i] != m_nativeMemory[i]) {
+            const auto addr = (i < 0x2000) ? 0xC000 + i : 0xFF80 + (i - 0x2000);
+            compare(("[" + toHexString(static_cast<int>(addr)) + "]").c_str(), m_lockstepMemory[i], m_nativeMemory[i]);
+            break;
+        }
+    }
+
+    if (!mismatch.empty()) {
+        throw std::runtime_error("Recompiled block at " + toHexString(blockStart) + " diverged after " + std::to_string(native.instructions) + " instructions, interpreter/native:" + mismatch);
+    }
+}
+#endif
+
 uint16_t CPULR35902::read16(uint16_t addr) {
     return static_cast<uint16_t>(m_bus->read(addr) | (m_bus->read(addr + 1) << 8));
 }
@@ -354,212 +903,219 @@ std::string CPULR35902::toHexString(int value) {
     return ss.str();
 }
 
+template<bool Traced>
 void CPULR35902::OP_00() {
     T += 4;
-    if (m_debug) logInstruction("NOP");
+    if constexpr (Traced) logInstruction("NOP");
 }
+template<bool Traced>
 void CPULR35902::OP_01() {
     T += 12;
-    BC.w = read16(PC.w);
-    PC.w += 2;
-    if (m_debug) logInstruction("LD BC, $" + toHexString(BC.w));
+    BC.w = fetch16();
+    if constexpr (Traced) logInstruction("LD BC, $" + toHexString(BC.w));
 }
+template<bool Traced>
 void CPULR35902::OP_02() {
     T += 8;
     m_bus->write(BC.w, AF.left);
-    if (m_debug) logInstruction("LD (BC), A");
+    if constexpr (Traced) logInstruction("LD (BC), A");
 }
+template<bool Traced>
 void CPULR35902::OP_03() {
     T += 8;
     BC.w++;
-    if (m_debug) logInstruction("INC BC");
+    if constexpr (Traced) logInstruction("INC BC");
 }
+template<bool Traced>
 void CPULR35902::OP_04() {
     T += 4;
-    const bool half = ((BC.left & 0x0F) == 0x0F);
-    BC.left++;
-    setFlags((BC.left == 0), 0, half, -1);
-    if (m_debug) logInstruction("INC B");
+    BC.left = inc8(BC.left);
+    if constexpr (Traced) logInstruction("INC B");
 }
+template<bool Traced>
 void CPULR35902::OP_05() {
     T += 4;
-    const bool half = ((BC.left & 0x0F) == 0);
-    BC.left--;
-    setFlags((BC.left == 0), 1, half, -1);
-    if (m_debug) logInstruction("DEC B");
+    BC.left = dec8(BC.left);
+    if constexpr (Traced) logInstruction("DEC B");
 }
+template<bool Traced>
 void CPULR35902::OP_06() {
     T += 8;
-    BC.left = m_bus->read(PC.w);
-    PC.w++;
-    if (m_debug) logInstruction("LD B, $" + toHexString(BC.left));
+    BC.left = fetch8();
+    if constexpr (Traced) logInstruction("LD B, $" + toHexString(BC.left));
 }
+template<bool Traced>
 void CPULR35902::OP_07() {
     T += 4;
     const uint8_t msb = AF.left >> 7;
     setFlags(0, 0, 0, msb);
     AF.left = (AF.left << 1) | msb;
-    if (m_debug) logInstruction("RLCA");
+    if constexpr (Traced) logInstruction("RLCA");
 }
+template<bool Traced>
 void CPULR35902::OP_08() {
     T += 20;
-    const auto addr = read16(PC.w);
-    PC.w += 2;
+    const auto addr = fetch16();
     write16(addr, SP.w);
-    if (m_debug) logInstruction("LD ($" + toHexString(addr) + "), SP");
+    if constexpr (Traced) logInstruction("LD ($" + toHexString(addr) + "), SP");
 }
+template<bool Traced>
 void CPULR35902::OP_09() {
     T += 8;
     const bool half = ((HL.w & 0x0FFF) + (BC.w & 0x0FFF)) > 0x0FFF;
     const bool carry = (HL.w + BC.w) > 0xFFFF;
     HL.w += BC.w;
     setFlags(-1, 0, half, carry);
-    if (m_debug) logInstruction("ADD HL, BC");
+    if constexpr (Traced) logInstruction("ADD HL, BC");
 }
+template<bool Traced>
 void CPULR35902::OP_0A() {
     T += 8;
     AF.left = m_bus->read(BC.w);
-    if (m_debug) logInstruction("LD A, (BC)");
+    if constexpr (Traced) logInstruction("LD A, (BC)");
 }
+template<bool Traced>
 void CPULR35902::OP_0B() {
     T += 8;
     BC.w--;
-    if (m_debug) logInstruction("DEC BC");
+    if constexpr (Traced) logInstruction("DEC BC");
 }
+template<bool Traced>
 void CPULR35902::OP_0C() {
     T += 4;
-    const bool half = ((BC.right & 0x0F) == 0x0F);
-    BC.right++;
-    setFlags((BC.right == 0), 0, half, -1);
-    if (m_debug) logInstruction("INC C");
+    BC.right = inc8(BC.right);
+    if constexpr (Traced) logInstruction("INC C");
 }
+template<bool Traced>
 void CPULR35902::OP_0D() {
     T += 4;
-    const bool half = ((BC.right & 0x0F) == 0);
-    BC.right--;
-    setFlags((BC.right == 0), 1, half, -1);
-    if (m_debug) logInstruction("DEC C");
+    BC.right = dec8(BC.right);
+    if constexpr (Traced) logInstruction("DEC C");
 }
+template<bool Traced>
 void CPULR35902::OP_0E() {
     T += 8;
-    BC.right = m_bus->read(PC.w);
-    PC.w++;
-    if (m_debug) logInstruction("LD C, $" + toHexString(BC.right));
+    BC.right = fetch8();
+    if constexpr (Traced) logInstruction("LD C, $" + toHexString(BC.right));
 }
+template<bool Traced>
 void CPULR35902::OP_0F() {
     T += 4;
     const uint8_t lsb = AF.left & 0x01;
     setFlags(0, 0, 0, lsb);
     AF.left = (AF.left >> 1) | (lsb << 7);
-    if (m_debug) logInstruction("RRCA");
+    if constexpr (Traced) logInstruction("RRCA");
 }
+template<bool Traced>
 void CPULR35902::OP_10() {
     T += 4;
     m_stop = true;
-    const auto value = m_bus->read(PC.w);
-    PC.w++;
-    if (m_debug) logInstruction("STOP " + toHexString(value));
+    const auto value = fetch8();
+    if constexpr (Traced) logInstruction("STOP " + toHexString(value));
 }
+template<bool Traced>
 void CPULR35902::OP_11() {
     T += 12;
-    DE.w = read16(PC.w);
-    PC.w += 2;
-    if (m_debug) logInstruction("LD DE, $" + toHexString(DE.w));
+    DE.w = fetch16();
+    if constexpr (Traced) logInstruction("LD DE, $" + toHexString(DE.w));
 }
+template<bool Traced>
 void CPULR35902::OP_12() {
     T += 8;
     m_bus->write(DE.w, AF.left);
-    if (m_debug) logInstruction("LD (DE), A");
+    if constexpr (Traced) logInstruction("LD (DE), A");
 }
+template<bool Traced>
 void CPULR35902::OP_13() {
     T += 8;
     DE.w++;
-    if (m_debug) logInstruction("INC DE");
+    if constexpr (Traced) logInstruction("INC DE");
 }
+template<bool Traced>
 void CPULR35902::OP_14() {
     T += 4;
-    const bool half = ((DE.left & 0x0F) == 0x0F);
-    DE.left++;
-    setFlags((DE.left == 0), 0, half, -1);
-    if (m_debug) logInstruction("INC D");
+    DE.left = inc8(DE.left);
+    if constexpr (Traced) logInstruction("INC D");
 }
+template<bool Traced>
 void CPULR35902::OP_15() {
     T += 4;
-    const bool half = ((DE.left & 0x0F) == 0);
-    DE.left--;
-    setFlags((DE.left == 0), 1, half, -1);
-    if (m_debug) logInstruction("DEC D");
+    DE.left = dec8(DE.left);
+    if constexpr (Traced) logInstruction("DEC D");
 }
+template<bool Traced>
 void CPULR35902::OP_16() {
     T += 8;
-    DE.left = m_bus->read(PC.w);
-    PC.w++;
-    if (m_debug) logInstruction("LD D, " + toHexString(DE.left));
+    DE.left = fetch8();
+    if constexpr (Traced) logInstruction("LD D, " + toHexString(DE.left));
 }
+template<bool Traced>
 void CPULR35902::OP_17() {
     T += 4;
     const uint8_t carry = static_cast<uint8_t>(getFlag(Flag::C));
     const bool msb = AF.left >> 7;
     setFlags(0, 0, 0, msb);
     AF.left = (AF.left << 1) | carry;
-    if (m_debug) logInstruction("RLA");
+    if constexpr (Traced) logInstruction("RLA");
 }
+template<bool Traced>
 void CPULR35902::OP_18() {
     T += 12;
-    const auto relative = m_bus->read(PC.w);
-    PC.w++;
+    const auto relative = fetch8();
     PC.w += static_cast<int8_t>(relative);
-    if (m_debug) logInstruction("JR $" + toHexString(relative));
+    if constexpr (Traced) logInstruction("JR $" + toHexString(relative));
 }
+template<bool Traced>
 void CPULR35902::OP_19() {
     T += 8;
     const bool half = ((HL.w & 0x0FFF) + (DE.w & 0x0FFF)) > 0x0FFF;
     const bool carry = (HL.w + DE.w) > 0xFFFF;
     HL.w += DE.w;
     setFlags(-1, 0, half, carry);
-    if (m_debug) logInstruction("ADD HL, DE");
+    if constexpr (Traced) logInstruction("ADD HL, DE");
 }
+template<bool Traced>
 void CPULR35902::OP_1A() {
     T += 8;
     AF.left = m_bus->read(DE.w);
-    if (m_debug) logInstruction("LD A, (DE)");
+    if constexpr (Traced) logInstruction("LD A, (DE)");
 }
+template<bool Traced>
 void CPULR35902::OP_1B() {
     T += 8;
     DE.w--;
-    if (m_debug) logInstruction("DEC DE");
+    if constexpr (Traced) logInstruction("DEC DE");
 }
+template<bool Traced>
 void CPULR35902::OP_1C() {
     T += 4;
-    const bool half = ((DE.right & 0x0F) == 0x0F);
-    DE.right++;
-    setFlags((DE.right == 0), 0, half, -1);
-    if (m_debug) logInstruction("INC E");
+    DE.right = inc8(DE.right);
+    if constexpr (Traced) logInstruction("INC E");
 }
+template<bool Traced>
 void CPULR35902::OP_1D() {
     T += 4;
-    const bool half = ((DE.right & 0x0F) == 0);
-    DE.right--;
-    setFlags((DE.right == 0), 1, half, -1);
-    if (m_debug) logInstruction("DEC E");
+    DE.right = dec8(DE.right);
+    if constexpr (Traced) logInstruction("DEC E");
 }
+template<bool Traced>
 void CPULR35902::OP_1E() {
     T += 8;
-    DE.right = m_bus->read(PC.w);
-    PC.w++;
-    if (m_debug) logInstruction("LD E, $" + toHexString(DE.right));
+    DE.right = fetch8();
+    if constexpr (Traced) logInstruction("LD E, $" + toHexString(DE.right));
 }
+template<bool Traced>
 void CPULR35902::OP_1F() {
     T += 4;
     const uint8_t carry = static_cast<uint8_t>(getFlag(Flag::C));
     const bool lsb = AF.left & 0x01;
     setFlags(0, 0, 0, lsb);
     AF.left = (AF.left >> 1) | (carry << 7);
-    if (m_debug) logInstruction("RRA");
+    if constexpr (Traced) logInstruction("RRA");
 }
+template<bool Traced>
 void CPULR35902::OP_20() { // JP NZ, e8
-    const auto relative = m_bus->read(PC.w);
-    PC.w++;
+    const auto relative = fetch8();
     const auto zero = getFlag(Flag::Z); 
     if(zero) {
         T += 8;
@@ -568,45 +1124,46 @@ void CPULR35902::OP_20() { // JP NZ, e8
         T += 12;
         PC.w += static_cast<int8_t>(relative);
     }
-    if (m_debug) logInstruction("JR NZ, $" + toHexString(relative));
+    if constexpr (Traced) logInstruction("JR NZ, $" + toHexString(relative));
 }
+template<bool Traced>
 void CPULR35902::OP_21() { // LD HL, n16
     T += 12;
-    HL.w = read16(PC.w);
-    PC.w += 2;
-    if (m_debug) logInstruction("LD HL, $" + toHexString(HL.w));
+    HL.w = fetch16();
+    if constexpr (Traced) logInstruction("LD HL, $" + toHexString(HL.w));
 }
+template<bool Traced>
 void CPULR35902::OP_22() {
     T += 8;
     m_bus->write(HL.w, AF.left);
     HL.w++;
-    if (m_debug) logInstruction("LD (HL+), A");
+    if constexpr (Traced) logInstruction("LD (HL+), A");
 }
+template<bool Traced>
 void CPULR35902::OP_23() {
     T += 8;
     HL.w++;
-    if (m_debug) logInstruction("INC HL");
+    if constexpr (Traced) logInstruction("INC HL");
 }
+template<bool Traced>
 void CPULR35902::OP_24() {
     T += 4;
-    const bool half = ((HL.left & 0x0F) == 0x0F);
-    HL.left++;
-    setFlags((HL.left == 0), 0, half, -1);
-    if (m_debug) logInstruction("INC H");
+    HL.left = inc8(HL.left);
+    if constexpr (Traced) logInstruction("INC H");
 }
+template<bool Traced>
 void CPULR35902::OP_25() {
     T += 4;
-    const bool half = ((HL.left & 0x0F) == 0);
-    HL.left--;
-    setFlags((HL.left == 0), 1, half, -1);
-    if (m_debug) logInstruction("DEC H");
+    HL.left = dec8(HL.left);
+    if constexpr (Traced) logInstruction("DEC H");
 }
+template<bool Traced>
 void CPULR35902::OP_26() {
     T += 8;
-    HL.left = m_bus->read(PC.w);
-    PC.w++;
-    if (m_debug) logInstruction("LD H, $" + toHexString(HL.left));
+    HL.left = fetch8();
+    if constexpr (Traced) logInstruction("LD H, $" + toHexString(HL.left));
 }
+template<bool Traced>
 void CPULR35902::OP_27() { // TODO
     T += 4;
     /*
@@ -622,6 +1179,7 @@ void CPULR35902::OP_27() { // TODO
     constexpr uint8_t FLAG_H = 0x20;  // bit 5
     constexpr uint8_t FLAG_C = 0x10;  // bit 4
 
+    materializeFlags();
     uint8_t a = AF.left;
     uint8_t correction = 0;
     bool carry = (AF.right & FLAG_C) != 0;  // old C flag
@@ -657,11 +1215,11 @@ void CPULR35902::OP_27() { // TODO
     AF.left = a;
     AF.right = f;
 
-    if (m_debug) logInstruction("DAA");
+    if constexpr (Traced) logInstruction("DAA");
 }
+template<bool Traced>
 void CPULR35902::OP_28() {
-    const auto relative = m_bus->read(PC.w);
-    PC.w++;
+    const auto relative = fetch8();
     const auto zero = getFlag(Flag::Z); 
     if(zero) {
         T += 12;
@@ -670,56 +1228,58 @@ void CPULR35902::OP_28() {
     else {
         T += 8;
     }
-    if (m_debug) logInstruction("JR Z, $" + toHexString(relative));
+    if constexpr (Traced) logInstruction("JR Z, $" + toHexString(relative));
 }
+template<bool Traced>
 void CPULR35902::OP_29() {
     T += 8;
     const bool half = ((HL.w & 0x0FFF) + (HL.w & 0x0FFF)) > 0x0FFF;
     const bool carry = (HL.w + HL.w) > 0xFFFF;
     HL.w += HL.w;
     setFlags(-1, 0, half, carry);
-    if (m_debug) logInstruction("ADD HL, HL");
+    if constexpr (Traced) logInstruction("ADD HL, HL");
 }
+template<bool Traced>
 void CPULR35902::OP_2A() {
     T += 8;
     AF.left = m_bus->read(HL.w);
     HL.w++;
-    if (m_debug) logInstruction("LD A, (HL+)");
+    if constexpr (Traced) logInstruction("LD A, (HL+)");
 }
+template<bool Traced>
 void CPULR35902::OP_2B() {
     T += 8;
     HL.w--;
-    if (m_debug) logInstruction("DEC HL");
+    if constexpr (Traced) logInstruction("DEC HL");
 }
+template<bool Traced>
 void CPULR35902::OP_2C() {
     T += 4;
-    const bool half = ((HL.right & 0x0F) == 0x0F);
-    HL.right++;
-    setFlags((HL.right == 0), 0, half, -1);
-    if (m_debug) logInstruction("INC L");
+    HL.right = inc8(HL.right);
+    if constexpr (Traced) logInstruction("INC L");
 }
+template<bool Traced>
 void CPULR35902::OP_2D() {
     T += 4;
-    const bool half = ((HL.right & 0x0F) == 0);
-    HL.right--;
-    setFlags((HL.right == 0), 1, half, -1);
-    if (m_debug) logInstruction("DEC L");
+    HL.right = dec8(HL.right);
+    if constexpr (Traced) logInstruction("DEC L");
 }
+template<bool Traced>
 void CPULR35902::OP_2E() {
     T += 8;
-    HL.right = m_bus->read(PC.w);
-    PC.w++;
-    if (m_debug) logInstruction("LD L, $" + toHexString(HL.right));
+    HL.right = fetch8();
+    if constexpr (Traced) logInstruction("LD L, $" + toHexString(HL.right));
 }
+template<bool Traced>
 void CPULR35902::OP_2F() {
     T += 4;
     AF.left = ~AF.left;
     setFlags(-1, 1, 1, -1);
-    if (m_debug) logInstruction("CPL");
+    if constexpr (Traced) logInstruction("CPL");
 }
+template<bool Traced>
 void CPULR35902::OP_30() {
-    const auto relative = m_bus->read(PC.w);
-    PC.w++;
+    const auto relative = fetch8();
     const bool carry = getFlag(Flag::C); 
     if(carry) {
         T += 8;
@@ -728,58 +1288,55 @@ void CPULR35902::OP_30() {
         T += 12;
         PC.w += static_cast<int8_t>(relative);
     }
-    if (m_debug) logInstruction("JR NC, $" + toHexString(relative));
+    if constexpr (Traced) logInstruction("JR NC, $" + toHexString(relative));
 }
+template<bool Traced>
 void CPULR35902::OP_31() {
     T += 12;
-    SP.w = read16(PC.w);
-    PC.w += 2;
-    if (m_debug) logInstruction("LD SP, $" + toHexString(SP.w));
+    SP.w = fetch16();
+    if constexpr (Traced) logInstruction("LD SP, $" + toHexString(SP.w));
 }
+template<bool Traced>
 void CPULR35902::OP_32() {
     T += 8;
     m_bus->write(HL.w, AF.left);
     HL.w--;
-    if (m_debug) logInstruction("LD (HL-), A");
+    if constexpr (Traced) logInstruction("LD (HL-), A");
 }
+template<bool Traced>
 void CPULR35902::OP_33() {
     T += 8;
     SP.w++;
-    if (m_debug) logInstruction("INC SP");
+    if constexpr (Traced) logInstruction("INC SP");
 }
+template<bool Traced>
 void CPULR35902::OP_34() {
     T += 12;
-    auto value = m_bus->read(HL.w);
-    const bool half = ((value & 0x0F) == 0x0F);
-    value++;
-    m_bus->write(HL.w, value);
-    setFlags((value == 0), 0, half, -1);
-    if (m_debug) logInstruction("INC (HL)");
+    m_bus->write(HL.w, inc8(m_bus->read(HL.w)));
+    if constexpr (Traced) logInstruction("INC (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_35() {
     T += 12;
-    auto value = m_bus->read(HL.w);
-    const bool half = ((value & 0x0F) == 0);
-    value--;
-    m_bus->write(HL.w, value);
-    setFlags((value == 0), 1, half, -1);
-    if (m_debug) logInstruction("DEC (HL)");
+    m_bus->write(HL.w, dec8(m_bus->read(HL.w)));
+    if constexpr (Traced) logInstruction("DEC (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_36() {
     T += 12;
-    const auto value  = m_bus->read(PC.w);
-    PC.w++;
+    const auto value  = fetch8();
     m_bus->write(HL.w, value);
-    if (m_debug) logInstruction("LD (HL), " + toHexString(value));
+    if constexpr (Traced) logInstruction("LD (HL), " + toHexString(value));
 }
+template<bool Traced>
 void CPULR35902::OP_37() {
     T += 4;
     setFlags(-1, 0, 0, 1);
-    if (m_debug) logInstruction("SCF");
+    if constexpr (Traced) logInstruction("SCF");
 }
+template<bool Traced>
 void CPULR35902::OP_38() {
-    const auto relative = m_bus->read(PC.w);
-    PC.w++;
+    const auto relative = fetch8();
     const bool carry = getFlag(Flag::C); 
     if(carry) {
         T += 12;
@@ -788,823 +1345,817 @@ void CPULR35902::OP_38() {
     else {
         T += 8;
     }
-    if (m_debug) logInstruction("JR C, $" + toHexString(relative));
+    if constexpr (Traced) logInstruction("JR C, $" + toHexString(relative));
 }
+template<bool Traced>
 void CPULR35902::OP_39() {
     T += 8;
     const bool half = ((HL.w & 0x0FFF) + (SP.w & 0x0FFF)) > 0x0FFF;
     const bool carry = (HL.w + SP.w) > 0xFFFF;
     HL.w += SP.w;
     setFlags(-1, 0, half, carry);
-    if (m_debug) logInstruction("ADD HL, SP");
+    if constexpr (Traced) logInstruction("ADD HL, SP");
 }
+template<bool Traced>
 void CPULR35902::OP_3A() {
     T += 8;
     AF.left = m_bus->read(HL.w);
     HL.w--;
-    if (m_debug) logInstruction("LD A, (HL-)");
+    if constexpr (Traced) logInstruction("LD A, (HL-)");
 }
+template<bool Traced>
 void CPULR35902::OP_3B() {
     T += 8;
     SP.w--;
-    if (m_debug) logInstruction("DEC SP");
+    if constexpr (Traced) logInstruction("DEC SP");
 }
+template<bool Traced>
 void CPULR35902::OP_3C() {
     T += 4;
-    const bool half = ((AF.left & 0x0F) == 0x0F);
-    AF.left++;
-    setFlags((AF.left == 0), 0, half, -1);
-    if (m_debug) logInstruction("INC A");
+    AF.left = inc8(AF.left);
+    if constexpr (Traced) logInstruction("INC A");
 }
+template<bool Traced>
 void CPULR35902::OP_3D() {
     T += 4;
-    const bool half = ((AF.left & 0x0F) == 0);
-    AF.left--;
-    setFlags((AF.left == 0), 1, half, -1);
-    if (m_debug) logInstruction("DEC A");
+    AF.left = dec8(AF.left);
+    if constexpr (Traced) logInstruction("DEC A");
 }
+template<bool Traced>
 void CPULR35902::OP_3E() {
     T += 8;
-    AF.left = m_bus->read(PC.w);
-    PC.w++;
-    if (m_debug) logInstruction("LD A, $" + toHexString(AF.left));
+    AF.left = fetch8();
+    if constexpr (Traced) logInstruction("LD A, $" + toHexString(AF.left));
 }
+template<bool Traced>
 void CPULR35902::OP_3F() {
     T += 4;
     const auto carry = getFlag(Flag::C);
     setFlags(-1, 0, 0, !carry);
-    if (m_debug) logInstruction("CCF");
+    if constexpr (Traced) logInstruction("CCF");
 }
+template<bool Traced>
 void CPULR35902::OP_40() {
     T += 4;
-    if (m_debug) logInstruction("LD B, B");
+    if constexpr (Traced) logInstruction("LD B, B");
 }
+template<bool Traced>
 void CPULR35902::OP_41() {
     T += 4;
     BC.left = BC.right;
-    if (m_debug) logInstruction("LD B, C");
+    if constexpr (Traced) logInstruction("LD B, C");
 }
+template<bool Traced>
 void CPULR35902::OP_42() {
     T += 4;
     BC.left = DE.left;
-    if (m_debug) logInstruction("LD B, D");
+    if constexpr (Traced) logInstruction("LD B, D");
 }
+template<bool Traced>
 void CPULR35902::OP_43() {
     T += 4;
     BC.left = DE.right;
-    if (m_debug) logInstruction("LD B, E");
+    if constexpr (Traced) logInstruction("LD B, E");
 }
+template<bool Traced>
 void CPULR35902::OP_44() {
     T += 4;
     BC.left = HL.left;
-    if (m_debug) logInstruction("LD B, H");
+    if constexpr (Traced) logInstruction("LD B, H");
 }
+template<bool Traced>
 void CPULR35902::OP_45() {
     T += 4;
     BC.left = HL.right;
-    if (m_debug) logInstruction("LD B, L");
+    if constexpr (Traced) logInstruction("LD B, L");
 }
+template<bool Traced>
 void CPULR35902::OP_46() {
     T += 8;
     BC.left = m_bus->read(HL.w);
-    if (m_debug) logInstruction("LD B, (HL)");
+    if constexpr (Traced) logInstruction("LD B, (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_47() {
     T += 4;
     BC.left = AF.left;
-    if (m_debug) logInstruction("LD B, A");
+    if constexpr (Traced) logInstruction("LD B, A");
 }
+template<bool Traced>
 void CPULR35902::OP_48() {
     T += 4;
     BC.right = BC.left;
-    if (m_debug) logInstruction("LD C, B");
+    if constexpr (Traced) logInstruction("LD C, B");
 }
+template<bool Traced>
 void CPULR35902::OP_49() {
     T += 4;
-    if (m_debug) logInstruction("LD C, C");
+    if constexpr (Traced) logInstruction("LD C, C");
 }
+template<bool Traced>
 void CPULR35902::OP_4A() {
     T += 4;
     BC.right = DE.left;
-    if (m_debug) logInstruction("LD C, D");
+    if constexpr (Traced) logInstruction("LD C, D");
 }
+template<bool Traced>
 void CPULR35902::OP_4B() {
     T += 4;
     BC.right = DE.right;
-    if (m_debug) logInstruction("LD C, E");
+    if constexpr (Traced) logInstruction("LD C, E");
 }
+template<bool Traced>
 void CPULR35902::OP_4C() {
     T += 4;
     BC.right = HL.left;
-    if (m_debug) logInstruction("LD C, H");
+    if constexpr (Traced) logInstruction("LD C, H");
 }
+template<bool Traced>
 void CPULR35902::OP_4D() {
     T += 4;
     BC.right = HL.right;
-    if (m_debug) logInstruction("LD C, L");
+    if constexpr (Traced) logInstruction("LD C, L");
 }
+template<bool Traced>
 void CPULR35902::OP_4E() {
     T += 8;
     BC.right = m_bus->read(HL.w);
-    if (m_debug) logInstruction("LD C, (HL)");
+    if constexpr (Traced) logInstruction("LD C, (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_4F() {
     T += 4;
     BC.right = AF.left;
-    if (m_debug) logInstruction("LD C, A");
+    if constexpr (Traced) logInstruction("LD C, A");
 }
+template<bool Traced>
 void CPULR35902::OP_50() {
     T += 4;
     DE.left = BC.left;
-    if (m_debug) logInstruction("LD D, B");
+    if constexpr (Traced) logInstruction("LD D, B");
 }
+template<bool Traced>
 void CPULR35902::OP_51() {
     T += 4;
     DE.left = BC.right;
-    if (m_debug) logInstruction("LD D, C");
+    if constexpr (Traced) logInstruction("LD D, C");
 }
+template<bool Traced>
 void CPULR35902::OP_52() {
     T += 4;
-    if (m_debug) logInstruction("LD D, D");
+    if constexpr (Traced) logInstruction("LD D, D");
 }
+template<bool Traced>
 void CPULR35902::OP_53() {
     T += 4;
     DE.left = DE.right;
-    if (m_debug) logInstruction("LD D, E");
+    if constexpr (Traced) logInstruction("LD D, E");
 }
+template<bool Traced>
 void CPULR35902::OP_54() {
     T += 4;
     DE.left = HL.left;
-    if (m_debug) logInstruction("LD D, H");
+    if constexpr (Traced) logInstruction("LD D, H");
 }
+template<bool Traced>
 void CPULR35902::OP_55() {
     T += 4;
     DE.left = HL.right;
-    if (m_debug) logInstruction("LD D, L");
+    if constexpr (Traced) logInstruction("LD D, L");
 }
+template<bool Traced>
 void CPULR35902::OP_56() {
     T += 8;
     DE.left = m_bus->read(HL.w);
-    if (m_debug) logInstruction("LD D, (HL)");
+    if constexpr (Traced) logInstruction("LD D, (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_57() {
     T += 4;
     DE.left = AF.left;
-    if (m_debug) logInstruction("LD D, A");
+    if constexpr (Traced) logInstruction("LD D, A");
 }
+template<bool Traced>
 void CPULR35902::OP_58() {
     T += 4;
     DE.right = BC.left;
-    if (m_debug) logInstruction("LD E, B");
+    if constexpr (Traced) logInstruction("LD E, B");
 }
+template<bool Traced>
 void CPULR35902::OP_59() {
     T += 4;
     DE.right = BC.right;
-    if (m_debug) logInstruction("LD E, C");
+    if constexpr (Traced) logInstruction("LD E, C");
 }
+template<bool Traced>
 void CPULR35902::OP_5A() {
     T += 4;
     DE.right = DE.left;
-    if (m_debug) logInstruction("LD E, D");
+    if constexpr (Traced) logInstruction("LD E, D");
 }
+template<bool Traced>
 void CPULR35902::OP_5B() {
     T += 4;
-    if (m_debug) logInstruction("LD E, E");
+    if constexpr (Traced) logInstruction("LD E, E");
 }
+template<bool Traced>
 void CPULR35902::OP_5C() {
     T += 4;
     DE.right = HL.left;
-    if (m_debug) logInstruction("LD E, H");
+    if constexpr (Traced) logInstruction("LD E, H");
 }
+template<bool Traced>
 void CPULR35902::OP_5D() {
     T += 4;
     DE.right = HL.right;
-    if (m_debug) logInstruction("LD E, L");
+    if constexpr (Traced) logInstruction("LD E, L");
 }
+template<bool Traced>
 void CPULR35902::OP_5E() {
     T += 8;
     DE.right = m_bus->read(HL.w);
-    if (m_debug) logInstruction("LD E, (HL)");
+    if constexpr (Traced) logInstruction("LD E, (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_5F() {
     T += 4;
     DE.right = AF.left;
-    if (m_debug) logInstruction("LD E, A");
+    if constexpr (Traced) logInstruction("LD E, A");
 }
+template<bool Traced>
 void CPULR35902::OP_60() {
     T += 4;
     HL.left = BC.left;
-    if (m_debug) logInstruction("LD H, B");
+    if constexpr (Traced) logInstruction("LD H, B");
 }
+template<bool Traced>
 void CPULR35902::OP_61() {
     T += 4;
     HL.left = BC.right;
-    if (m_debug) logInstruction("LD H, C");
+    if constexpr (Traced) logInstruction("LD H, C");
 }
+template<bool Traced>
 void CPULR35902::OP_62() {
     T += 4;
     HL.left = DE.left;
-    if (m_debug) logInstruction("LD H, D");
+    if constexpr (Traced) logInstruction("LD H, D");
 }
+template<bool Traced>
 void CPULR35902::OP_63() {
     T += 4;
     HL.left = DE.right;
-    if (m_debug) logInstruction("LD H, E");
+    if constexpr (Traced) logInstruction("LD H, E");
 }
+template<bool Traced>
 void CPULR35902::OP_64() {
     T += 4;
-    if (m_debug) logInstruction("LD H, H");
+    if constexpr (Traced) logInstruction("LD H, H");
 }
+template<bool Traced>
 void CPULR35902::OP_65() {
     T += 4;
     HL.left = HL.right;
-    if (m_debug) logInstruction("LD H, L");
+    if constexpr (Traced) logInstruction("LD H, L");
 }
+template<bool Traced>
 void CPULR35902::OP_66() {
     T += 8;
     HL.left = m_bus->read(HL.w);
-    if (m_debug) logInstruction("LD H, (HL)");
+    if constexpr (Traced) logInstruction("LD H, (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_67() {
     T += 4;
     HL.left = AF.left;
-    if (m_debug) logInstruction("LD H, A");
+    if constexpr (Traced) logInstruction("LD H, A");
 }
+template<bool Traced>
 void CPULR35902::OP_68() {
     T += 4;
     HL.right = BC.left;
-    if (m_debug) logInstruction("LD L, B");
+    if constexpr (Traced) logInstruction("LD L, B");
 }
+template<bool Traced>
 void CPULR35902::OP_69() {
     T += 4;
     HL.right = BC.right;
-    if (m_debug) logInstruction("LD L, C");
+    if constexpr (Traced) logInstruction("LD L, C");
 }
+template<bool Traced>
 void CPULR35902::OP_6A() {
     T += 4;
     HL.right = DE.left;
-    if (m_debug) logInstruction("LD L, D");
+    if constexpr (Traced) logInstruction("LD L, D");
 }
+template<bool Traced>
 void CPULR35902::OP_6B() {
     T += 4;
     HL.right = DE.right;
-    if (m_debug) logInstruction("LD L, E");
+    if constexpr (Traced) logInstruction("LD L, E");
 }
+template<bool Traced>
 void CPULR35902::OP_6C() {
     T += 4;
     HL.right = HL.left;
-    if (m_debug) logInstruction("LD L, H");
+    if constexpr (Traced) logInstruction("LD L, H");
 }
+template<bool Traced>
 void CPULR35902::OP_6D() {
     T += 4;
-    if (m_debug) logInstruction("LD L, L");
+    if constexpr (Traced) logInstruction("LD L, L");
 }
+template<bool Traced>
 void CPULR35902::OP_6E() {
     T += 8;
     HL.right = m_bus->read(HL.w);
-    if (m_debug) logInstruction("LD L, (HL)");
+    if constexpr (Traced) logInstruction("LD L, (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_6F() {
     T += 4;
     HL.right = AF.left;
-    if (m_debug) logInstruction("LD L, A");
+    if constexpr (Traced) logInstruction("LD L, A");
 }
+template<bool Traced>
 void CPULR35902::OP_70() {
     T += 8;
     m_bus->write(HL.w, BC.left);
-    if (m_debug) logInstruction("LD (HL), B");
+    if constexpr (Traced) logInstruction("LD (HL), B");
 }
+template<bool Traced>
 void CPULR35902::OP_71() {
     T += 8;
     m_bus->write(HL.w, BC.right);
-    if (m_debug) logInstruction("LD (HL), C");
+    if constexpr (Traced) logInstruction("LD (HL), C");
 }
+template<bool Traced>
 void CPULR35902::OP_72() {
     T += 8;
     m_bus->write(HL.w, DE.left);
-    if (m_debug) logInstruction("LD (HL), D");
+    if constexpr (Traced) logInstruction("LD (HL), D");
 }
+template<bool Traced>
 void CPULR35902::OP_73() {
     T += 8;
     m_bus->write(HL.w, DE.right);
-    if (m_debug) logInstruction("LD (HL), E");
+    if constexpr (Traced) logInstruction("LD (HL), E");
 }
+template<bool Traced>
 void CPULR35902::OP_74() {
     T += 8;
     m_bus->write(HL.w, HL.left);
-    if (m_debug) logInstruction("LD (HL), H");
+    if constexpr (Traced) logInstruction("LD (HL), H");
 }
+template<bool Traced>
 void CPULR35902::OP_75() {
     T += 8;
     m_bus->write(HL.w, HL.right);
-    if (m_debug) logInstruction("LD (HL), L");
+    if constexpr (Traced) logInstruction("LD (HL), L");
 }
+template<bool Traced>
 void CPULR35902::OP_76() {
     T += 4;
     m_halt = true;
-    if (m_debug) logInstruction("HALT");
+    if constexpr (Traced) logInstruction("HALT");
 }
+template<bool Traced>
 void CPULR35902::OP_77() {
     T += 8;
     m_bus->write(HL.w, AF.left);
-    if (m_debug) logInstruction("LD (HL), A");
+    if constexpr (Traced) logInstruction("LD (HL), A");
 }
+template<bool Traced>
 void CPULR35902::OP_78() {
     T += 4;
     AF.left = BC.left;
-    if (m_debug) logInstruction("LD A, B");
+    if constexpr (Traced) logInstruction("LD A, B");
 }
+template<bool Traced>
 void CPULR35902::OP_79() {
     T += 4;
     AF.left = BC.right;
-    if (m_debug) logInstruction("LD A, C");
+    if constexpr (Traced) logInstruction("LD A, C");
 }
+template<bool Traced>
 void CPULR35902::OP_7A() {
     T += 4;
     AF.left = DE.left;
-    if (m_debug) logInstruction("LD A, D");
+    if constexpr (Traced) logInstruction("LD A, D");
 }
+template<bool Traced>
 void CPULR35902::OP_7B() {
     T += 4;
     AF.left = DE.right;
-    if (m_debug) logInstruction("LD A, E");
+    if constexpr (Traced) logInstruction("LD A, E");
 }
+template<bool Traced>
 void CPULR35902::OP_7C() {
     T += 4;
     AF.left = HL.left;
-    if (m_debug) logInstruction("LD A, H");
+    if constexpr (Traced) logInstruction("LD A, H");
 }
+template<bool Traced>
 void CPULR35902::OP_7D() {
     T += 4;
     AF.left = HL.right;
-    if (m_debug) logInstruction("LD A, L");
+    if constexpr (Traced) logInstruction("LD A, L");
 }
+template<bool Traced>
 void CPULR35902::OP_7E() {
     T += 8;
     AF.left = m_bus->read(HL.w);
-    if (m_debug) logInstruction("LD A, (HL)");
+    if constexpr (Traced) logInstruction("LD A, (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_7F() {
     T += 4;
-    if (m_debug) logInstruction("LD A, A");
+    if constexpr (Traced) logInstruction("LD A, A");
 }
+template<bool Traced>
 void CPULR35902::OP_80() {
     T += 4;
-    const bool carry = (AF.left + BC.left) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (BC.left & 0xF)) > 0xF;
-    AF.left += BC.left;
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADD A, B");
+    add8(BC.left);
+    if constexpr (Traced) logInstruction("ADD A, B");
 }
+template<bool Traced>
 void CPULR35902::OP_81() {
     T += 4;
-    const bool carry = (AF.left + BC.right) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (BC.right & 0xF)) > 0xF;
-    AF.left += BC.right;
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADD A, C");
+    add8(BC.right);
+    if constexpr (Traced) logInstruction("ADD A, C");
 }
+template<bool Traced>
 void CPULR35902::OP_82() {
     T += 4;
-    const bool carry = (AF.left + DE.left) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (DE.left & 0xF)) > 0xF;
-    AF.left += DE.left;
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADD A, D");
+    add8(DE.left);
+    if constexpr (Traced) logInstruction("ADD A, D");
 }
+template<bool Traced>
 void CPULR35902::OP_83() {
     T += 4;
-    const bool carry = (AF.left + DE.right) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (DE.right & 0xF)) > 0xF;
-    AF.left += DE.right;
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADD A, E");
+    add8(DE.right);
+    if constexpr (Traced) logInstruction("ADD A, E");
 }
+template<bool Traced>
 void CPULR35902::OP_84() {
     T += 4;
-    const bool carry = (AF.left + HL.left) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (HL.left & 0xF)) > 0xF;
-    AF.left += HL.left;
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADD A, H");
+    add8(HL.left);
+    if constexpr (Traced) logInstruction("ADD A, H");
 }
+template<bool Traced>
 void CPULR35902::OP_85() {
     T += 4;
-    const bool carry = (AF.left + HL.right) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (HL.right & 0xF)) > 0xF;
-    AF.left += HL.right;
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADD A, L");
+    add8(HL.right);
+    if constexpr (Traced) logInstruction("ADD A, L");
 }
+template<bool Traced>
 void CPULR35902::OP_86() {
     T += 8;
-    const auto value = m_bus->read(HL.w);
-    const bool carry = (AF.left + value) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (value & 0xF)) > 0xF;
-    AF.left += value;
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADD A, (HL)");
+    add8(m_bus->read(HL.w));
+    if constexpr (Traced) logInstruction("ADD A, (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_87() {
     T += 4;
-    const bool carry = (AF.left + AF.left) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (AF.left & 0xF)) > 0xF;
-    AF.left += AF.left;
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADD A, A");
+    add8(AF.left);
+    if constexpr (Traced) logInstruction("ADD A, A");
 }
+template<bool Traced>
 void CPULR35902::OP_88() {
     T += 4;
-    const bool carry = (AF.left + BC.left + getFlag(Flag::C)) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (BC.left & 0xF) + getFlag(Flag::C)) > 0xF;
-    AF.left += BC.left + getFlag(Flag::C);
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADC A, B");
+    add8(BC.left, getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("ADC A, B");
 }
+template<bool Traced>
 void CPULR35902::OP_89() {
     T += 4;
-    const bool carry = (AF.left + BC.right + getFlag(Flag::C)) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (BC.right & 0xF) + getFlag(Flag::C)) > 0xF;
-    AF.left += BC.right + getFlag(Flag::C);
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADC A, C");
+    add8(BC.right, getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("ADC A, C");
 }
+template<bool Traced>
 void CPULR35902::OP_8A() {
     T += 4;
-    const bool carry = (AF.left + DE.left + getFlag(Flag::C)) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (DE.left & 0xF) + getFlag(Flag::C)) > 0xF;
-    AF.left += DE.left + getFlag(Flag::C);
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADC A, D");
+    add8(DE.left, getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("ADC A, D");
 }
+template<bool Traced>
 void CPULR35902::OP_8B() {
     T += 4;
-    const bool carry = (AF.left + DE.right + getFlag(Flag::C)) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (DE.right & 0xF) + getFlag(Flag::C)) > 0xF;
-    AF.left += DE.right + getFlag(Flag::C);
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADC A, E");
+    add8(DE.right, getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("ADC A, E");
 }
+template<bool Traced>
 void CPULR35902::OP_8C() {
     T += 4;
-    const bool carry = (AF.left + HL.left + getFlag(Flag::C)) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (HL.left & 0xF) + getFlag(Flag::C)) > 0xF;
-    AF.left += HL.left + getFlag(Flag::C);
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADC A, H");
+    add8(HL.left, getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("ADC A, H");
 }
+template<bool Traced>
 void CPULR35902::OP_8D() {
     T += 4;
-    const bool carry = (AF.left + HL.right + getFlag(Flag::C)) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (HL.right & 0xF) + getFlag(Flag::C)) > 0xF;
-    AF.left += HL.right + getFlag(Flag::C);
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADC A, L");
+    add8(HL.right, getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("ADC A, L");
 }
+template<bool Traced>
 void CPULR35902::OP_8E() {
     T += 8;
-    const auto value = m_bus->read(HL.w);
-    const bool carry = (AF.left + value + getFlag(Flag::C)) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (value & 0xF) + getFlag(Flag::C)) > 0xF;
-    AF.left += value + getFlag(Flag::C);
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADC A, (HL)");
+    add8(m_bus->read(HL.w), getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("ADC A, (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_8F() {
     T += 4;
-    const bool carry = (AF.left + AF.left + getFlag(Flag::C)) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (AF.left & 0xF) + getFlag(Flag::C)) > 0xF;
-    AF.left += AF.left + getFlag(Flag::C);
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADC A, A");
+    add8(AF.left, getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("ADC A, A");
 }
+template<bool Traced>
 void CPULR35902::OP_90() {
     T += 4;
-    const bool carry = AF.left < BC.left;
-    const bool half = (AF.left & 0xF) < (BC.left & 0xF);
-    AF.left -= BC.left;
-    setFlags((AF.left == 0), 1, half, carry);
-    if (m_debug) logInstruction("SUB A, B");
+    sub8(BC.left);
+    if constexpr (Traced) logInstruction("SUB A, B");
 }
+template<bool Traced>
 void CPULR35902::OP_91() {
     T += 4;
-    const bool carry = AF.left < BC.right;
-    const bool half = (AF.left & 0xF) < (BC.right & 0xF);
-    AF.left -= BC.right;
-    setFlags((AF.left == 0), 1, half, carry);
-    if (m_debug) logInstruction("SUB A, C");
+    sub8(BC.right);
+    if constexpr (Traced) logInstruction("SUB A, C");
 }
+template<bool Traced>
 void CPULR35902::OP_92() {
     T += 4;
-    const bool carry = AF.left < DE.left;
-    const bool half = (AF.left & 0xF) < (DE.left & 0xF);
-    AF.left -= DE.left;
-    setFlags((AF.left == 0), 1, half, carry);
-    if (m_debug) logInstruction("SUB A, D");
+    sub8(DE.left);
+    if constexpr (Traced) logInstruction("SUB A, D");
 }
+template<bool Traced>
 void CPULR35902::OP_93() {
     T += 4;
-    const bool carry = AF.left < DE.right;
-    const bool half = (AF.left & 0xF) < (DE.right & 0xF);
-    AF.left -= DE.right;
-    setFlags((AF.left == 0), 1, half, carry);
-    if (m_debug) logInstruction("SUB A, E");
+    sub8(DE.right);
+    if constexpr (Traced) logInstruction("SUB A, E");
 }
+template<bool Traced>
 void CPULR35902::OP_94() {
     T += 4;
-    const bool carry = AF.left < HL.left;
-    const bool half = (AF.left & 0xF) < (HL.left & 0xF);
-    AF.left -= HL.left;
-    setFlags((AF.left == 0), 1, half, carry);
-    if (m_debug) logInstruction("SUB A, H");
+    sub8(HL.left);
+    if constexpr (Traced) logInstruction("SUB A, H");
 }
+template<bool Traced>
 void CPULR35902::OP_95() {
     T += 4;
-    const bool carry = AF.left < HL.right;
-    const bool half = (AF.left & 0xF) < (HL.right & 0xF);
-    AF.left -= HL.right;
-    setFlags((AF.left == 0), 1, half, carry);
-    if (m_debug) logInstruction("SUB A, L");
+    sub8(HL.right);
+    if constexpr (Traced) logInstruction("SUB A, L");
 }
+template<bool Traced>
 void CPULR35902::OP_96() {
     T += 8;
-    const auto value = m_bus->read(HL.w);
-    const bool carry = AF.left < value;
-    const bool half = (AF.left & 0xF) < (value & 0xF);
-    AF.left -= value;
-    setFlags((AF.left == 0), 1, half, carry);
-    if (m_debug) logInstruction("SUB A, (HL)");
+    sub8(m_bus->read(HL.w));
+    if constexpr (Traced) logInstruction("SUB A, (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_97() {
     T += 4;
-    AF.left = 0;
-    setFlags(1, 1, 0, 0);
-    if (m_debug) logInstruction("SUB A, A");
+    sub8(AF.left);
+    if constexpr (Traced) logInstruction("SUB A, A");
 }
+template<bool Traced>
 void CPULR35902::OP_98() {
     T += 4;
-    const bool carry = AF.left < (BC.left + getFlag(Flag::C));
-    const bool half = (AF.left & 0xF) < ((BC.left & 0xF) + getFlag(Flag::C));
-    AF.left -= (BC.left + getFlag(Flag::C));
-    setFlags((AF.left == 0), 1, half, carry);
-    if (m_debug) logInstruction("SBC A, B");
+    sub8(BC.left, getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("SBC A, B");
 }
+template<bool Traced>
 void CPULR35902::OP_99() {
     T += 4;
-    const bool carry = AF.left < (BC.right + getFlag(Flag::C));
-    const bool half = (AF.left & 0xF) < ((BC.right & 0xF) + getFlag(Flag::C));
-    AF.left -= (BC.right + getFlag(Flag::C));
-    setFlags((AF.left == 0), 1, half, carry);
-    if (m_debug) logInstruction("SBC A, C");
+    sub8(BC.right, getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("SBC A, C");
 }
+template<bool Traced>
 void CPULR35902::OP_9A() {
     T += 4;
-    const bool carry = AF.left < (DE.left + getFlag(Flag::C));
-    const bool half = (AF.left & 0xF) < ((DE.left & 0xF) + getFlag(Flag::C));
-    AF.left -= (DE.left + getFlag(Flag::C));
-    setFlags((AF.left == 0), 1, half, carry);
-    if (m_debug) logInstruction("SBC A, D");
+    sub8(DE.left, getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("SBC A, D");
 }
+template<bool Traced>
 void CPULR35902::OP_9B() {
     T += 4;
-    const bool carry = AF.left < (DE.right + getFlag(Flag::C));
-    const bool half = (AF.left & 0xF) < ((DE.right & 0xF) + getFlag(Flag::C));
-    AF.left -= (DE.right + getFlag(Flag::C));
-    setFlags((AF.left == 0), 1, half, carry);
-    if (m_debug) logInstruction("SBC A, E");
+    sub8(DE.right, getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("SBC A, E");
 }
+template<bool Traced>
 void CPULR35902::OP_9C() {
     T += 4;
-    const bool carry = AF.left < (HL.left + getFlag(Flag::C));
-    const bool half = (AF.left & 0xF) < ((HL.left & 0xF) + getFlag(Flag::C));
-    AF.left -= (HL.left + getFlag(Flag::C));
-    setFlags((AF.left == 0), 1, half, carry);
-    if (m_debug) logInstruction("SBC A, H");
+    sub8(HL.left, getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("SBC A, H");
 }
+template<bool Traced>
 void CPULR35902::OP_9D() {
     T += 4;
-    const bool carry = AF.left < (HL.right + getFlag(Flag::C));
-    const bool half = (AF.left & 0xF) < ((HL.right & 0xF) + getFlag(Flag::C));
-    AF.left -= (HL.right + getFlag(Flag::C));
-    setFlags((AF.left == 0), 1, half, carry);
-    if (m_debug) logInstruction("SBC A, L");
+    sub8(HL.right, getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("SBC A, L");
 }
+template<bool Traced>
 void CPULR35902::OP_9E() {
     T += 8;
-    const auto value = m_bus->read(HL.w);
-    const bool carry = AF.left < (value + getFlag(Flag::C));
-    const bool half = (AF.left & 0xF) < ((value & 0xF) + getFlag(Flag::C));
-    AF.left -= (value + getFlag(Flag::C));
-    setFlags((AF.left == 0), 1, half, carry);
-    if (m_debug) logInstruction("SBC A, (HL)");
+    sub8(m_bus->read(HL.w), getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("SBC A, (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_9F() {
     T += 4;
-    const auto carry = static_cast<uint8_t>(getFlag(Flag::C));
-    const uint8_t result = AF.left - AF.left - carry;
-    bool half = ((AF.left & 0xF) < ((AF.left & 0xF) + carry));
-    bool newCarry = (AF.left < (AF.left + carry));
-    AF.left = result;
-    setFlags(result == 0, 1, half, newCarry);
-    if (m_debug) logInstruction("SBC A, A");
+    sub8(AF.left, getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("SBC A, A");
 }
+template<bool Traced>
 void CPULR35902::OP_A0() {
     T += 4;
-    AF.left &= BC.left;
-    setFlags((AF.left == 0), 0, 1, 0);
-    if (m_debug) logInstruction("AND A, B");
+    and8(BC.left);
+    if constexpr (Traced) logInstruction("AND A, B");
 }
+template<bool Traced>
 void CPULR35902::OP_A1() {
     T += 4;
-    AF.left &= BC.right;
-    setFlags((AF.left == 0), 0, 1, 0);
-    if (m_debug) logInstruction("AND A, C");
+    and8(BC.right);
+    if constexpr (Traced) logInstruction("AND A, C");
 }
+template<bool Traced>
 void CPULR35902::OP_A2() {
     T += 4;
-    AF.left &= DE.left;
-    setFlags((AF.left == 0), 0, 1, 0);
-    if (m_debug) logInstruction("AND A, D");
+    and8(DE.left);
+    if constexpr (Traced) logInstruction("AND A, D");
 }
+template<bool Traced>
 void CPULR35902::OP_A3() {
     T += 4;
-    AF.left &= DE.right;
-    setFlags((AF.left == 0), 0, 1, 0);
-    if (m_debug) logInstruction("AND A, E");
+    and8(DE.right);
+    if constexpr (Traced) logInstruction("AND A, E");
 }
+template<bool Traced>
 void CPULR35902::OP_A4() {
     T += 4;
-    AF.left &= HL.left;
-    setFlags((AF.left == 0), 0, 1, 0);
-    if (m_debug) logInstruction("AND A, H");
+    and8(HL.left);
+    if constexpr (Traced) logInstruction("AND A, H");
 }
+template<bool Traced>
 void CPULR35902::OP_A5() {
     T += 4;
-    AF.left &= HL.right;
-    setFlags((AF.left == 0), 0, 1, 0);
-    if (m_debug) logInstruction("AND A, L");
+    and8(HL.right);
+    if constexpr (Traced) logInstruction("AND A, L");
 }
+template<bool Traced>
 void CPULR35902::OP_A6() {
     T += 8;
-    AF.left &= m_bus->read(HL.w);
-    setFlags((AF.left == 0), 0, 1, 0);
-    if (m_debug) logInstruction("AND A, (HL)");
+    and8(m_bus->read(HL.w));
+    if constexpr (Traced) logInstruction("AND A, (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_A7() {
     T += 4;
-    setFlags((AF.left == 0), 0, 1, 0);
-    if (m_debug) logInstruction("AND A, A");
+    and8(AF.left);
+    if constexpr (Traced) logInstruction("AND A, A");
 }
+template<bool Traced>
 void CPULR35902::OP_A8() {
     T += 4;
-    AF.left ^= BC.left;
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("XOR A, B");
+    xor8(BC.left);
+    if constexpr (Traced) logInstruction("XOR A, B");
 }
+template<bool Traced>
 void CPULR35902::OP_A9() {    
     T += 4;
-    AF.left ^= BC.right;
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("XOR A, C");
+    xor8(BC.right);
+    if constexpr (Traced) logInstruction("XOR A, C");
 }
+template<bool Traced>
 void CPULR35902::OP_AA() {
     T += 4;
-    AF.left ^= DE.left;
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("XOR A, D");
+    xor8(DE.left);
+    if constexpr (Traced) logInstruction("XOR A, D");
 }
+template<bool Traced>
 void CPULR35902::OP_AB() {
     T += 4;
-    AF.left ^= DE.right;
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("XOR A, E");
+    xor8(DE.right);
+    if constexpr (Traced) logInstruction("XOR A, E");
 }
+template<bool Traced>
 void CPULR35902::OP_AC() {
     T += 4;
-    AF.left ^= HL.left;
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("XOR A, H");
+    xor8(HL.left);
+    if constexpr (Traced) logInstruction("XOR A, H");
 }
+template<bool Traced>
 void CPULR35902::OP_AD() {
     T += 4;
-    AF.left ^= HL.right;
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("XOR A, L");
+    xor8(HL.right);
+    if constexpr (Traced) logInstruction("XOR A, L");
 }
+template<bool Traced>
 void CPULR35902::OP_AE() {
     T += 8;
-    AF.left ^= m_bus->read(HL.w);
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("XOR A, (HL)");
+    xor8(m_bus->read(HL.w));
+    if constexpr (Traced) logInstruction("XOR A, (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_AF() {
     T += 4;
-    AF.left ^= AF.left;
-    setFlags(1, 0, 0, 0);
-    if (m_debug) logInstruction("XOR A, A");
+    xor8(AF.left);
+    if constexpr (Traced) logInstruction("XOR A, A");
 }
+template<bool Traced>
 void CPULR35902::OP_B0() {
     T += 4;
-    AF.left |= BC.left;
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("OR A, B");
+    or8(BC.left);
+    if constexpr (Traced) logInstruction("OR A, B");
 }
+template<bool Traced>
 void CPULR35902::OP_B1() {
     T += 4;
-    AF.left |= BC.right;
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("OR A, C");
+    or8(BC.right);
+    if constexpr (Traced) logInstruction("OR A, C");
 }
+template<bool Traced>
 void CPULR35902::OP_B2() {
     T += 4;
-    AF.left |= DE.left;
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("OR A, D");
+    or8(DE.left);
+    if constexpr (Traced) logInstruction("OR A, D");
 }
+template<bool Traced>
 void CPULR35902::OP_B3() {
     T += 4;
-    AF.left |= DE.right;
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("OR A, E");
+    or8(DE.right);
+    if constexpr (Traced) logInstruction("OR A, E");
 }
+template<bool Traced>
 void CPULR35902::OP_B4() {
     T += 4;
-    AF.left |= HL.left;
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("OR A, H");
+    or8(HL.left);
+    if constexpr (Traced) logInstruction("OR A, H");
 }
+template<bool Traced>
 void CPULR35902::OP_B5() {
     T += 4;
-    AF.left |= HL.right;
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("OR A, L");
+    or8(HL.right);
+    if constexpr (Traced) logInstruction("OR A, L");
 }
+template<bool Traced>
 void CPULR35902::OP_B6() {
     T += 8;
-    AF.left |= m_bus->read(HL.w);
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("OR A, (HL)");
+    or8(m_bus->read(HL.w));
+    if constexpr (Traced) logInstruction("OR A, (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_B7() {
     T += 4;
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("OR A, A");
+    or8(AF.left);
+    if constexpr (Traced) logInstruction("OR A, A");
 }
+template<bool Traced>
 void CPULR35902::OP_B8() {
     T += 4;
-    const bool carry = AF.left < BC.left;
-    const bool half = (AF.left & 0xF) < (BC.left & 0xF);
-    setFlags((AF.left == BC.left), 1, half, carry);
-    if (m_debug) logInstruction("CP A, B");
+    cp8(BC.left);
+    if constexpr (Traced) logInstruction("CP A, B");
 }
+template<bool Traced>
 void CPULR35902::OP_B9() {
     T += 4;
-    const bool carry = AF.left < BC.right;
-    const bool half = (AF.left & 0xF) < (BC.right & 0xF);
-    setFlags((AF.left == BC.right), 1, half, carry);
-    if (m_debug) logInstruction("CP A, C");
+    cp8(BC.right);
+    if constexpr (Traced) logInstruction("CP A, C");
 }
+template<bool Traced>
 void CPULR35902::OP_BA() {
     T += 4;
-    const bool carry = AF.left < DE.left;
-    const bool half = (AF.left & 0xF) < (DE.left & 0xF);
-    setFlags((AF.left == DE.left), 1, half, carry);
-    if (m_debug) logInstruction("CP A, D");
+    cp8(DE.left);
+    if constexpr (Traced) logInstruction("CP A, D");
 }
+template<bool Traced>
 void CPULR35902::OP_BB() {
     T += 4;
-    const bool carry = AF.left < DE.right;
-    const bool half = (AF.left & 0xF) < (DE.right & 0xF);
-    setFlags((AF.left == DE.right), 1, half, carry);
-    if (m_debug) logInstruction("CP A, E");
+    cp8(DE.right);
+    if constexpr (Traced) logInstruction("CP A, E");
 }
+template<bool Traced>
 void CPULR35902::OP_BC() {
     T += 4;
-    const bool carry = AF.left < HL.left;
-    const bool half = (AF.left & 0xF) < (HL.left & 0xF);
-    setFlags((AF.left == HL.left), 1, half, carry);
-    if (m_debug) logInstruction("CP A, H");
+    cp8(HL.left);
+    if constexpr (Traced) logInstruction("CP A, H");
 }
+template<bool Traced>
 void CPULR35902::OP_BD() {
     T += 4;
-    const bool carry = AF.left < HL.right;
-    const bool half = (AF.left & 0xF) < (HL.right & 0xF);
-    setFlags((AF.left == HL.right), 1, half, carry);
-    if (m_debug) logInstruction("CP A, L");
+    cp8(HL.right);
+    if constexpr (Traced) logInstruction("CP A, L");
 }
+template<bool Traced>
 void CPULR35902::OP_BE() {
     T += 8;
-    const auto value = m_bus->read(HL.w); 
-    const bool carry = AF.left < value;
-    const bool half = (AF.left & 0xF) < (value & 0xF);
-    setFlags((AF.left == value), 1, half, carry);
-    if (m_debug) logInstruction("CP A, (HL)");
+    cp8(m_bus->read(HL.w));
+    if constexpr (Traced) logInstruction("CP A, (HL)");
 }
+template<bool Traced>
 void CPULR35902::OP_BF() {
     T += 4;
-    setFlags(1, 1, 0, 0);
-    if (m_debug) logInstruction("CP A, A");
+    cp8(AF.left);
+    if constexpr (Traced) logInstruction("CP A, A");
 }
+template<bool Traced>
 void CPULR35902::OP_C0() {
     const auto zero = getFlag(Flag::Z);
     if(zero) {
@@ -1615,17 +2166,18 @@ void CPULR35902::OP_C0() {
         PC.w = read16(SP.w);
         SP.w += 2;
     }
-    if (m_debug) logInstruction("RET NZ");
+    if constexpr (Traced) logInstruction("RET NZ");
 }
+template<bool Traced>
 void CPULR35902::OP_C1() {
     T += 12;
     BC.w = read16(SP.w);
     SP.w += 2;
-    if (m_debug) logInstruction("POP BC");
+    if constexpr (Traced) logInstruction("POP BC");
 }
+template<bool Traced>
 void CPULR35902::OP_C2() {
-    const auto addr = read16(PC.w);
-    PC.w += 2;
+    const auto addr = fetch16();
     const auto zero = getFlag(Flag::Z);
     if(zero) {
         T += 12;
@@ -1634,16 +2186,17 @@ void CPULR35902::OP_C2() {
         T += 16;
         PC.w = addr;
     }
-    if (m_debug) logInstruction("JP NZ, $" + toHexString(addr));
+    if constexpr (Traced) logInstruction("JP NZ, $" + toHexString(addr));
 }
+template<bool Traced>
 void CPULR35902::OP_C3() {  
     T += 16;
-    PC.w = read16(PC.w);
-    if (m_debug) logInstruction("JP, $" + toHexString(PC.w));
+    PC.w = fetch16();
+    if constexpr (Traced) logInstruction("JP, $" + toHexString(PC.w));
 }
+template<bool Traced>
 void CPULR35902::OP_C4() {
-    const auto addr = read16(PC.w);
-    PC.w += 2;
+    const auto addr = fetch16();
     const auto zero = getFlag(Flag::Z);
     if(zero) {
         T += 12;
@@ -1654,31 +2207,31 @@ void CPULR35902::OP_C4() {
         write16(SP.w, PC.w);
         PC.w = addr;
     }
-    if (m_debug) logInstruction("CALL NZ, $" + toHexString(addr));
+    if constexpr (Traced) logInstruction("CALL NZ, $" + toHexString(addr));
 }
+template<bool Traced>
 void CPULR35902::OP_C5() {
     T += 16;
     SP.w -= 2;
     write16(SP.w, BC.w);
-    if (m_debug) logInstruction("PUSH BC");
+    if constexpr (Traced) logInstruction("PUSH BC");
 }
+template<bool Traced>
 void CPULR35902::OP_C6() {
     T += 8;
-    const auto value = m_bus->read(PC.w);
-    PC.w++;
-    const bool carry = (AF.left + value) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (value & 0xF)) > 0xF;
-    AF.left += value;
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADD A, $" + toHexString(value));
+    const auto value = fetch8();
+    add8(value);
+    if constexpr (Traced) logInstruction("ADD A, $" + toHexString(value));
 }
+template<bool Traced>
 void CPULR35902::OP_C7() {
     T += 16;
     SP.w -= 2;
     write16(SP.w, PC.w);
     PC.w = 0x00;
-    if (m_debug) logInstruction("RST $00");
+    if constexpr (Traced) logInstruction("RST $00");
 }
+template<bool Traced>
 void CPULR35902::OP_C8() {
     const auto zero = getFlag(Flag::Z);
     if(zero) {
@@ -1689,17 +2242,18 @@ void CPULR35902::OP_C8() {
     else {
         T += 8;
     }
-    if (m_debug) logInstruction("RET Z");
+    if constexpr (Traced) logInstruction("RET Z");
 }
+template<bool Traced>
 void CPULR35902::OP_C9() {
     T += 16;
     PC.w = read16(SP.w);
     SP.w += 2;
-    if (m_debug) logInstruction("RET");
+    if constexpr (Traced) logInstruction("RET");
 }
+template<bool Traced>
 void CPULR35902::OP_CA() {
-    const auto addr = read16(PC.w);
-    PC.w += 2;
+    const auto addr = fetch16();
     const auto zero = getFlag(Flag::Z);
     if(zero) {
         T += 16;
@@ -1708,15 +2262,16 @@ void CPULR35902::OP_CA() {
     else {
         T += 12;
     }
-    if (m_debug) logInstruction("JP Z, $" + toHexString(addr));
+    if constexpr (Traced) logInstruction("JP Z, $" + toHexString(addr));
 }
+template<bool Traced>
 void CPULR35902::OP_CB() {
     T += 4;
-    if (m_debug) logInstruction("PREFIX");
+    if constexpr (Traced) logInstruction("PREFIX");
 }
+template<bool Traced>
 void CPULR35902::OP_CC() {
-    const auto addr = read16(PC.w);
-    PC.w += 2;
+    const auto addr = fetch16();
     const auto zero = getFlag(Flag::Z);
     if(zero) {
         T += 24;
@@ -1727,34 +2282,33 @@ void CPULR35902::OP_CC() {
     else {
         T += 12;    
     }
-    if (m_debug) logInstruction("CALL Z, $" + toHexString(addr));
+    if constexpr (Traced) logInstruction("CALL Z, $" + toHexString(addr));
 }
+template<bool Traced>
 void CPULR35902::OP_CD() {
     T += 24;
-    const auto addr = read16(PC.w);
-    PC.w += 2;
+    const auto addr = fetch16();
     SP.w -= 2;
     write16(SP.w, PC.w);
     PC.w = addr;
-    if (m_debug) logInstruction("CALL, $" + toHexString(addr));
+    if constexpr (Traced) logInstruction("CALL, $" + toHexString(addr));
 }
+template<bool Traced>
 void CPULR35902::OP_CE() {
     T += 8;
-    const auto value = m_bus->read(PC.w);
-    PC.w++;
-    const bool carry = (AF.left + value + getFlag(Flag::C)) > 0xFF;
-    const bool half = ((AF.left & 0xF) + (value & 0xF) + getFlag(Flag::C)) > 0xF;
-    AF.left += value + getFlag(Flag::C);
-    setFlags((AF.left == 0), 0, half, carry);
-    if (m_debug) logInstruction("ADC A, $" + toHexString(value));
+    const auto value = fetch8();
+    add8(value, getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("ADC A, $" + toHexString(value));
 }
+template<bool Traced>
 void CPULR35902::OP_CF() {
     T += 16;
     SP.w -= 2;
     write16(SP.w, PC.w);
     PC.w = 0x08;
-    if (m_debug) logInstruction("RST $08");
+    if constexpr (Traced) logInstruction("RST $08");
 }
+template<bool Traced>
 void CPULR35902::OP_D0() {
     const bool carry = getFlag(Flag::C);
     if(carry) {
@@ -1765,17 +2319,18 @@ void CPULR35902::OP_D0() {
         PC.w = read16(SP.w);
         SP.w += 2;
     }
-    if (m_debug) logInstruction("RET NC");
+    if constexpr (Traced) logInstruction("RET NC");
 }
+template<bool Traced>
 void CPULR35902::OP_D1() {
     T += 12;
     DE.w = read16(SP.w);
     SP.w += 2;
-    if (m_debug) logInstruction("POP DE");
+    if constexpr (Traced) logInstruction("POP DE");
 }
+template<bool Traced>
 void CPULR35902::OP_D2() {
-    const auto addr = read16(PC.w);
-    PC.w += 2;
+    const auto addr = fetch16();
     const bool carry = getFlag(Flag::C);
     if(carry) {
         T += 12;
@@ -1784,14 +2339,15 @@ void CPULR35902::OP_D2() {
         T += 16;
         PC.w = addr;
     }
-    if (m_debug) logInstruction("JP NC, $" + toHexString(addr));
+    if constexpr (Traced) logInstruction("JP NC, $" + toHexString(addr));
 }
+template<bool Traced>
 void CPULR35902::OP_D3() {
     throw std::runtime_error("Illegal instruction D3");
 }
+template<bool Traced>
 void CPULR35902::OP_D4() {
-    const auto addr = read16(PC.w);
-    PC.w += 2;
+    const auto addr = fetch16();
     const bool carry = getFlag(Flag::C);
     if(carry) {
         T += 12;
@@ -1802,31 +2358,31 @@ void CPULR35902::OP_D4() {
         write16(SP.w, PC.w);
         PC.w = addr;
     }
-    if (m_debug) logInstruction("CALL NC, $" + toHexString(addr));
+    if constexpr (Traced) logInstruction("CALL NC, $" + toHexString(addr));
 }
+template<bool Traced>
 void CPULR35902::OP_D5() {
     T += 16;
     SP.w -= 2;
     write16(SP.w, DE.w);
-    if (m_debug) logInstruction("PUSH DE");
+    if constexpr (Traced) logInstruction("PUSH DE");
 }
+template<bool Traced>
 void CPULR35902::OP_D6() {
     T += 8;
-    const auto value = m_bus->read(PC.w);
-    PC.w++;
-    const bool carry = AF.left < value; 
-    const bool half = (AF.left & 0xF) < (value & 0xF);
-    AF.left -= value; 
-    setFlags((AF.left == 0), 1, half, carry);
-    if (m_debug) logInstruction("SUB A, $" + toHexString(value));
+    const auto value = fetch8();
+    sub8(value);
+    if constexpr (Traced) logInstruction("SUB A, $" + toHexString(value));
 }
+template<bool Traced>
 void CPULR35902::OP_D7() {
     T += 16;
     SP.w -= 2;
     write16(SP.w, PC.w);
     PC.w = 0x10;
-    if (m_debug) logInstruction("RST $10");
+    if constexpr (Traced) logInstruction("RST $10");
 }
+template<bool Traced>
 void CPULR35902::OP_D8() {
     const bool carry = getFlag(Flag::C);
     if(carry) {
@@ -1837,18 +2393,19 @@ void CPULR35902::OP_D8() {
     else {
         T += 8;
     }
-    if (m_debug) logInstruction("RET C");
+    if constexpr (Traced) logInstruction("RET C");
 }
+template<bool Traced>
 void CPULR35902::OP_D9() {
     T += 16;
     PC.w = read16(SP.w);
     SP.w += 2;
     m_interruptMasterEnable = true;
-    if (m_debug) logInstruction("RETI");
+    if constexpr (Traced) logInstruction("RETI");
 }
+template<bool Traced>
 void CPULR35902::OP_DA() {
-    const auto addr = read16(PC.w);
-    PC.w += 2;
+    const auto addr = fetch16();
     const bool carry = getFlag(Flag::C);
     if(carry) {
         T += 16;
@@ -1857,14 +2414,15 @@ void CPULR35902::OP_DA() {
     else {
         T += 12;
     }
-    if (m_debug) logInstruction("JP C, $" + toHexString(addr));
+    if constexpr (Traced) logInstruction("JP C, $" + toHexString(addr));
 }
+template<bool Traced>
 void CPULR35902::OP_DB() {
     throw std::runtime_error("Illegal instruction DB");    
 }
+template<bool Traced>
 void CPULR35902::OP_DC() {
-    const auto addr = read16(PC.w);
-    PC.w += 2;
+    const auto addr = fetch16();
     const bool carry = getFlag(Flag::C);
     if(carry) {
         T += 24;
@@ -1875,259 +2433,285 @@ void CPULR35902::OP_DC() {
     else {
         T += 12;
     }
-    if (m_debug) logInstruction("CALL C, $" + toHexString(addr));
+    if constexpr (Traced) logInstruction("CALL C, $" + toHexString(addr));
 }
+template<bool Traced>
 void CPULR35902::OP_DD() {
     throw std::runtime_error("Illegal instruction DD");
 }
+template<bool Traced>
 void CPULR35902::OP_DE() {
     T += 8;
-    const auto value = m_bus->read(PC.w);
-    PC.w++;
-    const bool carry = AF.left < (value + getFlag(Flag::C));
-    const bool half = (AF.left & 0xF) < ((value & 0xF) + getFlag(Flag::C));
-    AF.left -= (value + getFlag(Flag::C));
-    setFlags((AF.left == 0), 1, half, carry);
-    if (m_debug) logInstruction("SBC A, $" + toHexString(value));
+    const auto value = fetch8();
+    sub8(value, getFlag(Flag::C));
+    if constexpr (Traced) logInstruction("SBC A, $" + toHexString(value));
 }
+template<bool Traced>
 void CPULR35902::OP_DF() {
     T += 16;
     SP.w -= 2;
     write16(SP.w, PC.w);
     PC.w = 0x18;
-    if (m_debug) logInstruction("RST $18");
+    if constexpr (Traced) logInstruction("RST $18");
 }
+template<bool Traced>
 void CPULR35902::OP_E0() { 
-    const auto value = m_bus->read(PC.w);
-    PC.w++;
+    T += 12;
+    const auto value = fetch8();
     m_bus->write(0xFF00 + value, AF.left);
-    if (m_debug) logInstruction("LDH ($FF00+$" + toHexString(value) + "), A");
+    if constexpr (Traced) logInstruction("LDH ($FF00+$" + toHexString(value) + "), A");
 }
+template<bool Traced>
 void CPULR35902::OP_E1() {
     T += 12;
     HL.w = read16(SP.w);
     SP.w += 2;
-    if (m_debug) logInstruction("POP HL");
+    if constexpr (Traced) logInstruction("POP HL");
 }
+template<bool Traced>
 void CPULR35902::OP_E2() {
     T += 8;
     m_bus->write(0xFF00 + BC.right, AF.left);
-    if (m_debug) logInstruction("LD (SFF00+C), A");
+    if constexpr (Traced) logInstruction("LD (SFF00+C), A");
 }
+template<bool Traced>
 void CPULR35902::OP_E3() {
     throw std::runtime_error("Illegal instruction E3");
 }
+template<bool Traced>
 void CPULR35902::OP_E4() {
     throw std::runtime_error("Illegal instruction E4");
 }
+template<bool Traced>
 void CPULR35902::OP_E5() {
     T += 16;
     SP.w -= 2;
     write16(SP.w, HL.w);
-    if (m_debug) logInstruction("PUSH HL");
+    if constexpr (Traced) logInstruction("PUSH HL");
 }
+template<bool Traced>
 void CPULR35902::OP_E6() {
     T += 8;
-    const auto value = m_bus->read(PC.w);
-    PC.w++;
-    AF.left &= value;
-    setFlags((AF.left == 0), 0, 1, 0);
-    if (m_debug) logInstruction("AND A, $" + toHexString(value));
+    const auto value = fetch8();
+    and8(value);
+    if constexpr (Traced) logInstruction("AND A, $" + toHexString(value));
 }
+template<bool Traced>
 void CPULR35902::OP_E7() {
     T += 16;
     SP.w -= 2;
     write16(SP.w, PC.w);
     PC.w = 0x20;
-    if (m_debug) logInstruction("RST $20");
+    if constexpr (Traced) logInstruction("RST $20");
 }
+template<bool Traced>
 void CPULR35902::OP_E8() {
     T+=16;
-    const auto unsignedValue = m_bus->read(PC.w);
-    PC.w++;
+    const auto unsignedValue = fetch8();
     const auto value = static_cast<int8_t>(unsignedValue);
     const bool half = ((SP.w & 0xF) + (value & 0xF)) > 0xF;
     const bool carry = ((SP.w & 0xFF) + (value & 0xFF)) > 0xFF;
     SP.w += static_cast<int16_t>(value);
     setFlags(0, 0, half, carry);
-    if (m_debug) logInstruction("ADD SP, $" + toHexString(value));
+    if constexpr (Traced) logInstruction("ADD SP, $" + toHexString(value));
 }
+template<bool Traced>
 void CPULR35902::OP_E9() {
     T += 4;
     PC.w = HL.w;
-    if (m_debug) logInstruction("JP HL");
+    if constexpr (Traced) logInstruction("JP HL");
 }
+template<bool Traced>
 void CPULR35902::OP_EA() {
     T += 16;
-    const auto addr = read16(PC.w);
-    PC.w += 2;
+    const auto addr = fetch16();
     m_bus->write(addr, AF.left);
-    if (m_debug) logInstruction("LD ($" + toHexString(addr) + "), A");
+    if constexpr (Traced) logInstruction("LD ($" + toHexString(addr) + "), A");
 }
+template<bool Traced>
 void CPULR35902::OP_EB() {
     throw std::runtime_error("Illegal instruction EB");
 }
+template<bool Traced>
 void CPULR35902::OP_EC() {
     throw std::runtime_error("Illegal instruction EC");
 }
+template<bool Traced>
 void CPULR35902::OP_ED() {
     throw std::runtime_error("Illegal instruction ED");
     T += 4;
-    if (m_debug) logInstruction("Illegal instruction ED");
+    if constexpr (Traced) logInstruction("Illegal instruction ED");
 }
+template<bool Traced>
 void CPULR35902::OP_EE() {
     T += 8;
-    const auto value = m_bus->read(PC.w);
-    PC.w ++;
-    AF.left ^= value;
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("XOR A, $" + toHexString(value));
+    const auto value = fetch8();
+    xor8(value);
+    if constexpr (Traced) logInstruction("XOR A, $" + toHexString(value));
 }
+template<bool Traced>
 void CPULR35902::OP_EF() {
     T += 16;
     SP.w -= 2;
     write16(SP.w, PC.w);
     PC.w = 0x28;
-    if (m_debug) logInstruction("RST $28");
+    if constexpr (Traced) logInstruction("RST $28");
 }
+template<bool Traced>
 void CPULR35902::OP_F0() {
     T += 12;
-    const auto value = m_bus->read(PC.w);
-    PC.w++;
+    const auto value = fetch8();
     AF.left = m_bus->read(0xFF00 + value);
-    if (m_debug) logInstruction("LDH A, ($FF00+" + toHexString(value) + ")");
+    if constexpr (Traced) logInstruction("LDH A, ($FF00+" + toHexString(value) + ")");
 }
+template<bool Traced>
 void CPULR35902::OP_F1() {
     T += 12;
+    discardFlags();
     AF.w = read16(SP.w);
     SP.w += 2;
     AF.right &= 0xF0;
-    if (m_debug) logInstruction("POP AF");
+    if constexpr (Traced) logInstruction("POP AF");
 }
+template<bool Traced>
 void CPULR35902::OP_F2() {
     T += 8;
     AF.left = m_bus->read(0xFF00 + BC.right);
-    if (m_debug) logInstruction("LD A, (SFF00+C)");
+    if constexpr (Traced) logInstruction("LD A, (SFF00+C)");
 }
+template<bool Traced>
 void CPULR35902::OP_F3() {
     m_interruptMasterEnable = false;
-    if (m_debug) logInstruction("DI");
+    if constexpr (Traced) logInstruction("DI");
 }
+template<bool Traced>
 void CPULR35902::OP_F4() {
     throw std::runtime_error("Illegal instruction F4");
 }
+template<bool Traced>
 void CPULR35902::OP_F5() {
     T += 16;
     SP.w -= 2;
+    materializeFlags();
     write16(SP.w, AF.w);
-    if (m_debug) logInstruction("PUSH AF");
+    if constexpr (Traced) logInstruction("PUSH AF");
 }
+template<bool Traced>
 void CPULR35902::OP_F6() {
     T += 8;
-    const auto value = m_bus->read(PC.w);
-    PC.w++;
-    AF.left |= value;
-    setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("OR A, $" + toHexString(value));
+    const auto value = fetch8();
+    or8(value);
+    if constexpr (Traced) logInstruction("OR A, $" + toHexString(value));
 }
+template<bool Traced>
 void CPULR35902::OP_F7() {
     T += 16;
     SP.w -= 2;
     write16(SP.w, PC.w);
     PC.w = 0x30;
-    if (m_debug) logInstruction("RST $30");
+    if constexpr (Traced) logInstruction("RST $30");
 }
+template<bool Traced>
 void CPULR35902::OP_F8() {
     T+=12;
-    const auto unsignedValue = m_bus->read(PC.w);
-    PC.w++;
+    const auto unsignedValue = fetch8();
     const auto value = static_cast<int8_t>(unsignedValue);
     const bool half = ((SP.w & 0xF) + (value & 0xF)) > 0xF;
     const bool carry = ((SP.w & 0xFF) + (value & 0xFF)) > 0xFF;
     HL.w = SP.w + static_cast<int16_t>(value);
     setFlags(0, 0, half, carry);
-    if (m_debug) logInstruction("LD HL, SP + $" + toHexString(value));
+    if constexpr (Traced) logInstruction("LD HL, SP + $" + toHexString(value));
 }
+template<bool Traced>
 void CPULR35902::OP_F9() {
     T += 8;
     SP.w = HL.w;
-    if (m_debug) logInstruction("LD SP, HL");
+    if constexpr (Traced) logInstruction("LD SP, HL");
 }
+template<bool Traced>
 void CPULR35902::OP_FA() {
     T += 16;
-    const auto addr = read16(PC.w);
-    PC.w += 2;
+    const auto addr = fetch16();
     AF.left = m_bus->read(addr);
-    if (m_debug) logInstruction("LD A, ($" + toHexString(addr) + ")");
+    if constexpr (Traced) logInstruction("LD A, ($" + toHexString(addr) + ")");
 }
+template<bool Traced>
 void CPULR35902::OP_FB() {
     m_interruptMasterEnable = true;
-    if (m_debug) logInstruction("EI");
+    if constexpr (Traced) logInstruction("EI");
 }
+template<bool Traced>
 void CPULR35902::OP_FC() {
     throw std::runtime_error("Illegal instruction FC");
 }
+template<bool Traced>
 void CPULR35902::OP_FD() {
     throw std::runtime_error("Illegal instruction FD");
 }
+template<bool Traced>
 void CPULR35902::OP_FE() {
     T += 8;
-    const auto value = m_bus->read(PC.w);
-    PC.w++;
-    const bool carry = AF.left < value;
-    const bool half = (AF.left & 0xF) < (value & 0xF);
-    setFlags((AF.left == value), 1, half, carry);
-    if (m_debug) logInstruction("CP A, $" + toHexString(value));
+    const auto value = fetch8();
+    cp8(value);
+    if constexpr (Traced) logInstruction("CP A, $" + toHexString(value));
 }
+template<bool Traced>
 void CPULR35902::OP_FF() {
     T += 16;
     SP.w -= 2;
     write16(SP.w, PC.w);
     PC.w = 0x00;
-    if (m_debug) logInstruction("RST $38");
+    if constexpr (Traced) logInstruction("RST $38");
 }
+template<bool Traced>
 void CPULR35902::PR_00() {
     T += 8;
     const auto msb = (BC.left & 0b10000000) >> 7;
     BC.left = (BC.left << 1) | msb;
     setFlags((BC.left == 0), 0, 0, msb);
-    if (m_debug) logInstruction("RLC B");
+    if constexpr (Traced) logInstruction("RLC B");
 }
+template<bool Traced>
 void CPULR35902::PR_01() {
     T += 8;
     const auto msb = (BC.right & 0b10000000) >> 7;
     BC.right = (BC.right << 1) | msb;
     setFlags((BC.right == 0), 0, 0, msb);
-    if (m_debug) logInstruction("RLC C");
+    if constexpr (Traced) logInstruction("RLC C");
 }
+template<bool Traced>
 void CPULR35902::PR_02() {
     T += 8;
     const auto msb = (DE.left & 0b10000000) >> 7;
     DE.left = (DE.left << 1) | msb;
     setFlags((DE.left == 0), 0, 0, msb);
-    if (m_debug) logInstruction("RLC D");
+    if constexpr (Traced) logInstruction("RLC D");
 }
+template<bool Traced>
 void CPULR35902::PR_03() {
     T += 8;
     const auto msb = (DE.right & 0b10000000) >> 7;
     DE.right = (DE.right << 1) | msb;
     setFlags((DE.right == 0), 0, 0, msb);
-    if (m_debug) logInstruction("RLC E");
+    if constexpr (Traced) logInstruction("RLC E");
 }
+template<bool Traced>
 void CPULR35902::PR_04() {
     T += 8;
     const auto msb = (HL.left & 0b10000000) >> 7;
     HL.left = (HL.left << 1) | msb;
     setFlags((HL.left == 0), 0, 0, msb);
-    if (m_debug) logInstruction("RLC H");
+    if constexpr (Traced) logInstruction("RLC H");
 }
+template<bool Traced>
 void CPULR35902::PR_05() {
     T += 8;
     const auto msb = (HL.right & 0b10000000) >> 7;
     HL.right = (HL.right << 1) | msb;
     setFlags((HL.right == 0), 0, 0, msb);
-    if (m_debug) logInstruction("RLC L");
+    if constexpr (Traced) logInstruction("RLC L");
 }
+template<bool Traced>
 void CPULR35902::PR_06() {
     T += 16;
     auto value = m_bus->read(HL.w);
@@ -2135,57 +2719,65 @@ void CPULR35902::PR_06() {
     value = (value << 1) | msb;
     setFlags((value == 0), 0, 0, msb);
     m_bus->write(HL.w, value);
-    if (m_debug) logInstruction("RLC (HL)");
+    if constexpr (Traced) logInstruction("RLC (HL)");
 }
+template<bool Traced>
 void CPULR35902::PR_07() {
     T += 8;
     const auto msb = (AF.left & 0b10000000) >> 7;
     AF.left = (AF.left << 1) | msb;
     setFlags((AF.left == 0), 0, 0, msb);
-    if (m_debug) logInstruction("RLC A");
+    if constexpr (Traced) logInstruction("RLC A");
 }
+template<bool Traced>
 void CPULR35902::PR_08() {
     T += 8;
     const auto lsb = (BC.left & 0b00000001);
     BC.left = (BC.left >> 1) | (lsb << 7);
     setFlags((BC.left == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("RRC B");
+    if constexpr (Traced) logInstruction("RRC B");
 }
+template<bool Traced>
 void CPULR35902::PR_09() {
     T += 8;
     const auto lsb = (BC.right & 0b00000001);
     BC.right = (BC.right >> 1) | (lsb << 7);
     setFlags((BC.right == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("RRC C");
+    if constexpr (Traced) logInstruction("RRC C");
 }
+template<bool Traced>
 void CPULR35902::PR_0A() {
     T += 8;
     const auto lsb = (DE.left & 0b00000001);
     DE.left = (DE.left >> 1) | (lsb << 7);
     setFlags((DE.left == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("RRC D");
+    if constexpr (Traced) logInstruction("RRC D");
 }
+template<bool Traced>
 void CPULR35902::PR_0B() {
     T += 8;
     const auto lsb = (DE.right & 0b00000001);
     DE.right = (DE.right >> 1) | (lsb << 7);
     setFlags((DE.right == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("RRC E");
+    if constexpr (Traced) logInstruction("RRC E");
 }
+template<bool Traced>
 void CPULR35902::PR_0C() {
     T += 8;
     const auto lsb = (HL.left & 0b00000001);
     HL.left = (HL.left >> 1) | (lsb << 7);
     setFlags((HL.left == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("RRC H");
+    if constexpr (Traced) logInstruction("RRC H");
 }
+template<bool Traced>
 void CPULR35902::PR_0D() {
     T += 8;
     const auto lsb = (HL.right & 0b00000001);
     HL.right = (HL.right >> 1) | (lsb << 7);
     setFlags((HL.right == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("RRC L");
+    if constexpr (Traced) logInstruction("RRC L");
 }
+template<bool Traced>
 void CPULR35902::PR_0E() {
     T += 16;
     auto value = m_bus->read(HL.w);
@@ -2193,57 +2785,65 @@ void CPULR35902::PR_0E() {
     value = (value >> 1) | (lsb << 7);
     setFlags((value == 0), 0, 0, lsb);
     m_bus->write(HL.w, value);
-    if (m_debug) logInstruction("RRC (HL)");
+    if constexpr (Traced) logInstruction("RRC (HL)");
 }
+template<bool Traced>
 void CPULR35902::PR_0F() {
     T += 8;
     const auto lsb = (AF.left & 0b00000001);
     AF.left = (AF.left >> 1) | (lsb << 7);
     setFlags((AF.left == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("RRC A");
+    if constexpr (Traced) logInstruction("RRC A");
 }
+template<bool Traced>
 void CPULR35902::PR_10() {
     T += 8;
     const auto msb = (BC.left & 0b10000000) >> 7;
     BC.left = (BC.left << 1) | static_cast<uint8_t>(getFlag(Flag::C));
     setFlags((BC.left == 0), 0, 0, msb);
-    if (m_debug) logInstruction("RL B");
+    if constexpr (Traced) logInstruction("RL B");
 }
+template<bool Traced>
 void CPULR35902::PR_11() {
     T += 8;
     const auto msb = (BC.right & 0b10000000) >> 7;
     BC.right = (BC.right << 1) | static_cast<uint8_t>(getFlag(Flag::C));
     setFlags((BC.right == 0), 0, 0, msb);
-    if (m_debug) logInstruction("RL C");
+    if constexpr (Traced) logInstruction("RL C");
 }
+template<bool Traced>
 void CPULR35902::PR_12() {
     T += 8;
     const auto msb = (DE.left & 0b10000000) >> 7;
     DE.left = (DE.left << 1) | static_cast<uint8_t>(getFlag(Flag::C));
     setFlags((DE.left == 0), 0, 0, msb);
-    if (m_debug) logInstruction("RL D");
+    if constexpr (Traced) logInstruction("RL D");
 }
+template<bool Traced>
 void CPULR35902::PR_13() {
     T += 8;
     const auto msb = (DE.right & 0b10000000) >> 7;
     DE.right = (DE.right << 1) | static_cast<uint8_t>(getFlag(Flag::C));
     setFlags((DE.right == 0), 0, 0, msb);
-    if (m_debug) logInstruction("RL E");
+    if constexpr (Traced) logInstruction("RL E");
 }
+template<bool Traced>
 void CPULR35902::PR_14() {
     T += 8;
     const auto msb = (HL.left & 0b10000000) >> 7;
     HL.left = (HL.left << 1) | static_cast<uint8_t>(getFlag(Flag::C));
     setFlags((HL.left == 0), 0, 0, msb);
-    if (m_debug) logInstruction("RL H");
+    if constexpr (Traced) logInstruction("RL H");
 }
+template<bool Traced>
 void CPULR35902::PR_15() {
     T += 8;
     const auto msb = (HL.right & 0b10000000) >> 7;
     HL.right = (HL.right << 1) | static_cast<uint8_t>(getFlag(Flag::C));
     setFlags((HL.right == 0), 0, 0, msb);
-    if (m_debug) logInstruction("RL L");
+    if constexpr (Traced) logInstruction("RL L");
 }
+template<bool Traced>
 void CPULR35902::PR_16() {
     T += 16;
     auto value = m_bus->read(HL.w);
@@ -2251,57 +2851,65 @@ void CPULR35902::PR_16() {
     value = (value << 1) | static_cast<uint8_t>(getFlag(Flag::C));
     setFlags((value == 0), 0, 0, msb);
     m_bus->write(HL.w, value);
-    if (m_debug) logInstruction("RL (HL)");
+    if constexpr (Traced) logInstruction("RL (HL)");
 }
+template<bool Traced>
 void CPULR35902::PR_17() {
     T += 8;
     const auto msb = (AF.left & 0b10000000) >> 7;
     AF.left = (AF.left << 1) | static_cast<uint8_t>(getFlag(Flag::C));
     setFlags((AF.left == 0), 0, 0, msb);
-    if (m_debug) logInstruction("RL A");
+    if constexpr (Traced) logInstruction("RL A");
 }
+template<bool Traced>
 void CPULR35902::PR_18() {
     T += 8;
     const auto lsb = (BC.left & 0b00000001);
     BC.left = (BC.left >> 1) | (static_cast<uint8_t>(getFlag(Flag::C)) << 7);
     setFlags((BC.left == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("RR B");
+    if constexpr (Traced) logInstruction("RR B");
 }
+template<bool Traced>
 void CPULR35902::PR_19() {
     T += 8;
     const auto lsb = (BC.right & 0b00000001);
     BC.right = (BC.right >> 1) | (static_cast<uint8_t>(getFlag(Flag::C)) << 7);
     setFlags((BC.right == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("RR C");
+    if constexpr (Traced) logInstruction("RR C");
 }
+template<bool Traced>
 void CPULR35902::PR_1A() {
     T += 8;
     const auto lsb = (DE.left & 0b00000001);
     DE.left = (DE.left >> 1) | (static_cast<uint8_t>(getFlag(Flag::C)) << 7);
     setFlags((DE.left == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("RR D");
+    if constexpr (Traced) logInstruction("RR D");
 }
+template<bool Traced>
 void CPULR35902::PR_1B() {
     T += 8;
     const auto lsb = (DE.right & 0b00000001);
     DE.right = (DE.right >> 1) | (static_cast<uint8_t>(getFlag(Flag::C)) << 7);
     setFlags((DE.right == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("RR E");
+    if constexpr (Traced) logInstruction("RR E");
 }
+template<bool Traced>
 void CPULR35902::PR_1C() {
     T += 8;
     const auto lsb = (HL.left & 0b00000001);
     HL.left = (HL.left >> 1) | (static_cast<uint8_t>(getFlag(Flag::C)) << 7);
     setFlags((HL.left == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("RR H");
+    if constexpr (Traced) logInstruction("RR H");
 }
+template<bool Traced>
 void CPULR35902::PR_1D() {
     T += 8;
     const auto lsb = (HL.right & 0b00000001);
     HL.right = (HL.right >> 1) | (static_cast<uint8_t>(getFlag(Flag::C)) << 7);
     setFlags((HL.right == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("RR L");
+    if constexpr (Traced) logInstruction("RR L");
 }
+template<bool Traced>
 void CPULR35902::PR_1E() {
     T += 16;
     auto value = m_bus->read(HL.w);
@@ -2309,57 +2917,65 @@ void CPULR35902::PR_1E() {
     value = (value >> 1) | (static_cast<uint8_t>(getFlag(Flag::C)) << 7);
     setFlags((value == 0), 0, 0, lsb);
     m_bus->write(HL.w, value);
-    if (m_debug) logInstruction("RR (HL)");
+    if constexpr (Traced) logInstruction("RR (HL)");
 }
+template<bool Traced>
 void CPULR35902::PR_1F() {
     T += 8;
     const auto lsb = (AF.left & 0b00000001);
     AF.left = (AF.left >> 1) | (static_cast<uint8_t>(getFlag(Flag::C)) << 7);
     setFlags((AF.left == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("RR A");
+    if constexpr (Traced) logInstruction("RR A");
 }
+template<bool Traced>
 void CPULR35902::PR_20() {
     T += 8;
     const auto msb = BC.left & 0b10000000;
     BC.left <<= 1;
     setFlags((BC.left == 0), 0, 0, msb);
-    if (m_debug) logInstruction("SLA B");
+    if constexpr (Traced) logInstruction("SLA B");
 }
+template<bool Traced>
 void CPULR35902::PR_21() {
     T += 8;
     const auto msb = BC.right & 0b10000000;
     BC.right <<= 1;
     setFlags((BC.right == 0), 0, 0, msb);
-    if (m_debug) logInstruction("SLA C");
+    if constexpr (Traced) logInstruction("SLA C");
 }
+template<bool Traced>
 void CPULR35902::PR_22() {
     T += 8;
     const auto msb = DE.left & 0b10000000;
     DE.left <<= 1;
     setFlags((DE.left == 0), 0, 0, msb);
-    if (m_debug) logInstruction("SLA D");
+    if constexpr (Traced) logInstruction("SLA D");
 }
+template<bool Traced>
 void CPULR35902::PR_23() {
     T += 8;
     const auto msb = DE.right & 0b10000000;
     DE.right <<= 1;
     setFlags((DE.right == 0), 0, 0, msb);
-    if (m_debug) logInstruction("SLA E");
+    if constexpr (Traced) logInstruction("SLA E");
 }
+template<bool Traced>
 void CPULR35902::PR_24() {
     T += 8;
     const auto msb = HL.left & 0b10000000;
     HL.left <<= 1;
     setFlags((HL.left == 0), 0, 0, msb);
-    if (m_debug) logInstruction("SLA H");
+    if constexpr (Traced) logInstruction("SLA H");
 }
+template<bool Traced>
 void CPULR35902::PR_25() {
     T += 8;
     const auto msb = HL.right & 0b10000000;
     HL.right <<= 1;
     setFlags((HL.right == 0), 0, 0, msb);
-    if (m_debug) logInstruction("SLA L");
+    if constexpr (Traced) logInstruction("SLA L");
 }
+template<bool Traced>
 void CPULR35902::PR_26() {
     T += 16;
     auto value = m_bus->read(HL.w);
@@ -2367,63 +2983,71 @@ void CPULR35902::PR_26() {
     value <<= 1;
     setFlags((value == 0), 0, 0, msb);
     m_bus->write(HL.w, value);
-    if (m_debug) logInstruction("SLA (HL)");
+    if constexpr (Traced) logInstruction("SLA (HL)");
 }
+template<bool Traced>
 void CPULR35902::PR_27() {
     T += 8;
     const auto msb = AF.left & 0b10000000;
     AF.left <<= 1;
     setFlags((AF.left == 0), 0, 0, msb);
-    if (m_debug) logInstruction("SLA A");
+    if constexpr (Traced) logInstruction("SLA A");
 }
+template<bool Traced>
 void CPULR35902::PR_28() {
     T += 8;
     const auto msb = BC.left & 0b10000000;
     const auto lsb = BC.left & 0b00000001;
     BC.left = (BC.left >> 1) | msb;
     setFlags((BC.left == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("SRA B");
+    if constexpr (Traced) logInstruction("SRA B");
 }
+template<bool Traced>
 void CPULR35902::PR_29() {
     T += 8;
     const auto msb = BC.right & 0b10000000;
     const auto lsb = BC.right & 0b00000001;
     BC.right = (BC.right >> 1) | msb;
     setFlags((BC.right == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("SRA C");
+    if constexpr (Traced) logInstruction("SRA C");
 }
+template<bool Traced>
 void CPULR35902::PR_2A() {
     T += 8;
     const auto msb = DE.left & 0b10000000;
     const auto lsb = DE.left & 0b00000001;
     DE.left = (DE.left >> 1) | msb;
     setFlags((DE.left == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("SRA D");
+    if constexpr (Traced) logInstruction("SRA D");
 }
+template<bool Traced>
 void CPULR35902::PR_2B() {
     T += 8;
     const auto msb = DE.right & 0b10000000;
     const auto lsb = DE.right & 0b00000001;
     DE.right = (DE.right >> 1) | msb;
     setFlags((DE.right == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("SRA E");
+    if constexpr (Traced) logInstruction("SRA E");
 }
+template<bool Traced>
 void CPULR35902::PR_2C() {
     T += 8;
     const auto msb = HL.left & 0b10000000;
     const auto lsb = HL.left & 0b00000001;
     HL.left = (HL.left >> 1) | msb;
     setFlags((HL.left == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("SRA H");
+    if constexpr (Traced) logInstruction("SRA H");
 }
+template<bool Traced>
 void CPULR35902::PR_2D() {
     T += 8;
     const auto msb = HL.right & 0b10000000;
     const auto lsb = HL.right & 0b00000001;
     HL.right = (HL.right >> 1) | msb;
     setFlags((HL.right == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("SRA L");
+    if constexpr (Traced) logInstruction("SRA L");
 }
+template<bool Traced>
 void CPULR35902::PR_2E() {
     T += 16;
     auto value = m_bus->read(HL.w);
@@ -2432,108 +3056,124 @@ void CPULR35902::PR_2E() {
     value = (value >> 1) | msb;
     setFlags((value == 0), 0, 0, lsb);
     m_bus->write(HL.w, value);
-    if (m_debug) logInstruction("SRA (HL)");
+    if constexpr (Traced) logInstruction("SRA (HL)");
 }
+template<bool Traced>
 void CPULR35902::PR_2F() {
     T += 8;
     const auto msb = AF.left & 0b10000000;
     const auto lsb = AF.left & 0b00000001;
     AF.left = (AF.left >> 1) | msb;
     setFlags((AF.left == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("SRA A");
+    if constexpr (Traced) logInstruction("SRA A");
 }
+template<bool Traced>
 void CPULR35902::PR_30() {
     T += 8;
     BC.left = (BC.left << 4) | (BC.left >> 4);
     setFlags((BC.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("SWAP B");
+    if constexpr (Traced) logInstruction("SWAP B");
 }
+template<bool Traced>
 void CPULR35902::PR_31() {
     T += 8;
     BC.right = (BC.right << 4) | (BC.right >> 4);
     setFlags((BC.right == 0), 0, 0, 0);
-    if (m_debug) logInstruction("SWAP C");
+    if constexpr (Traced) logInstruction("SWAP C");
 }
+template<bool Traced>
 void CPULR35902::PR_32() {
     T += 8;
     DE.left = (DE.left << 4) | (DE.left >> 4);
     setFlags((DE.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("SWAP D");
+    if constexpr (Traced) logInstruction("SWAP D");
 }
+template<bool Traced>
 void CPULR35902::PR_33() {
     T += 8;
     DE.right = (DE.right << 4) | (DE.right >> 4);
     setFlags((DE.right == 0), 0, 0, 0);
-    if (m_debug) logInstruction("SWAP E");
+    if constexpr (Traced) logInstruction("SWAP E");
 }
+template<bool Traced>
 void CPULR35902::PR_34() {
     T += 8;
     HL.left = (HL.left << 4) | (HL.left >> 4);
     setFlags((HL.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("SWAP H");
+    if constexpr (Traced) logInstruction("SWAP H");
 }
+template<bool Traced>
 void CPULR35902::PR_35() {
     T += 8;
     HL.right = (HL.right << 4) | (HL.right >> 4);
     setFlags((HL.right == 0), 0, 0, 0);
-    if (m_debug) logInstruction("SWAP L");
+    if constexpr (Traced) logInstruction("SWAP L");
 }
+template<bool Traced>
 void CPULR35902::PR_36() {
     T += 16;
     auto value = m_bus->read(HL.w);
     value = (value << 4) | (value >> 4);
     setFlags((value == 0), 0, 0, 0);
     m_bus->write(HL.w, value);
-    if (m_debug) logInstruction("SWAP (HL)");
+    if constexpr (Traced) logInstruction("SWAP (HL)");
 }
+template<bool Traced>
 void CPULR35902::PR_37() {
     T += 8;
     AF.left = (AF.left << 4) | (AF.left >> 4);
     setFlags((AF.left == 0), 0, 0, 0);
-    if (m_debug) logInstruction("SWAP A");
+    if constexpr (Traced) logInstruction("SWAP A");
 }
+template<bool Traced>
 void CPULR35902::PR_38() {
     T += 8;
     const auto lsb = BC.left & 0b00000001;
     BC.left >>= 1;
     setFlags((BC.left == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("SRL B");
+    if constexpr (Traced) logInstruction("SRL B");
 }
+template<bool Traced>
 void CPULR35902::PR_39() {
     T += 8;
     const auto lsb = BC.right & 0b00000001;
     BC.right >>= 1;
     setFlags((BC.right == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("SRL C");
+    if constexpr (Traced) logInstruction("SRL C");
 }
+template<bool Traced>
 void CPULR35902::PR_3A() {
     T += 8;
     const auto lsb = DE.left & 0b00000001;
     DE.left >>= 1;
     setFlags((DE.left == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("SRL D");
+    if constexpr (Traced) logInstruction("SRL D");
 }
+template<bool Traced>
 void CPULR35902::PR_3B() {
     T += 8;
     const auto lsb = DE.right & 0b00000001;
     DE.right >>= 1;
     setFlags((DE.right == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("SRL E");
+    if constexpr (Traced) logInstruction("SRL E");
 }
+template<bool Traced>
 void CPULR35902::PR_3C() {
     T += 8;
     const auto lsb = HL.left & 0b00000001;
     HL.left >>= 1;
     setFlags((HL.left == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("SRL H");
+    if constexpr (Traced) logInstruction("SRL H");
 }
+template<bool Traced>
 void CPULR35902::PR_3D() {
     T += 8;
     const auto lsb = HL.right & 0b00000001;
     HL.right >>= 1;
     setFlags((HL.right == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("SRL L");
+    if constexpr (Traced) logInstruction("SRL L");
 }
+template<bool Traced>
 void CPULR35902::PR_3E() {
     T += 16;
     auto value = m_bus->read(HL.w);
@@ -2541,1578 +3181,2298 @@ void CPULR35902::PR_3E() {
     value >>= 1;
     setFlags((value == 0), 0, 0, lsb);
     m_bus->write(HL.w, value);
-    if (m_debug) logInstruction("SRL (HL)");
+    if constexpr (Traced) logInstruction("SRL (HL)");
 }
+template<bool Traced>
 void CPULR35902::PR_3F() {
     T += 8;
     const auto lsb = AF.left & 0b00000001;
     AF.left >>= 1;
     setFlags((AF.left == 0), 0, 0, lsb);
-    if (m_debug) logInstruction("SRL A");
+    if constexpr (Traced) logInstruction("SRL A");
 }
+template<bool Traced>
 void CPULR35902::PR_40() {
     T += 8;
     const auto zero = (BC.left & 0b00000001) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 0, B");
+    if constexpr (Traced) logInstruction("BIT 0, B");
 }
+template<bool Traced>
 void CPULR35902::PR_41() {
     T += 8;
     const auto zero = (BC.right & 0b00000001) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 0, C");
+    if constexpr (Traced) logInstruction("BIT 0, C");
 }
+template<bool Traced>
 void CPULR35902::PR_42() {
     T += 8;
     const auto zero = (DE.left & 0b00000001) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 0, D");
+    if constexpr (Traced) logInstruction("BIT 0, D");
 }
+template<bool Traced>
 void CPULR35902::PR_43() {
     T += 8;
     const auto zero = (DE.right & 0b00000001) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 0, E");
+    if constexpr (Traced) logInstruction("BIT 0, E");
 }
+template<bool Traced>
 void CPULR35902::PR_44() {
     T += 8;
     const auto zero = (HL.left & 0b00000001) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 0, H");
+    if constexpr (Traced) logInstruction("BIT 0, H");
 }
+template<bool Traced>
 void CPULR35902::PR_45() {
     T += 8;
     const auto zero = (HL.right & 0b00000001) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 0, L");
+    if constexpr (Traced) logInstruction("BIT 0, L");
 }
+template<bool Traced>
 void CPULR35902::PR_46() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     const auto zero = (value & 0b00000001) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 0, (HL)");
+    if constexpr (Traced) logInstruction("BIT 0, (HL)");
 }
+template<bool Traced>
 void CPULR35902::PR_47() {
     T += 8;
     const auto zero = (AF.left & 0b00000001) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 0, A");
+    if constexpr (Traced) logInstruction("BIT 0, A");
 }
 
+template<bool Traced>
 void CPULR35902::PR_48() {
     T += 8;
     const auto zero = (BC.left & 0b00000010) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 1, B");
+    if constexpr (Traced) logInstruction("BIT 1, B");
 }
+template<bool Traced>
 void CPULR35902::PR_49() {
     T += 8;
     const auto zero = (BC.right & 0b00000010) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 1, C");
+    if constexpr (Traced) logInstruction("BIT 1, C");
 }
+template<bool Traced>
 void CPULR35902::PR_4A() {
     T += 8;
     const auto zero = (DE.left & 0b00000010) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 1, D");
+    if constexpr (Traced) logInstruction("BIT 1, D");
 }
+template<bool Traced>
 void CPULR35902::PR_4B() {
     T += 8;
     const auto zero = (DE.right & 0b00000010) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 1, E");
+    if constexpr (Traced) logInstruction("BIT 1, E");
 }
+template<bool Traced>
 void CPULR35902::PR_4C() {
     T += 8;
     const auto zero = (HL.left & 0b00000010) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 1, H");
+    if constexpr (Traced) logInstruction("BIT 1, H");
 }
+template<bool Traced>
 void CPULR35902::PR_4D() {
     T += 8;
     const auto zero = (HL.right & 0b00000010) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 1, L");
+    if constexpr (Traced) logInstruction("BIT 1, L");
 }
+template<bool Traced>
 void CPULR35902::PR_4E() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     const auto zero = (value & 0b00000010) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 1, (HL)");
+    if constexpr (Traced) logInstruction("BIT 1, (HL)");
 }
+template<bool Traced>
 void CPULR35902::PR_4F() {
     T += 8;
     const auto zero = (AF.left & 0b00000010) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 1, A");
+    if constexpr (Traced) logInstruction("BIT 1, A");
 }
+template<bool Traced>
 void CPULR35902::PR_50() {
     T += 8;
     const auto zero = (BC.left & 0b00000100) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 2, B");
+    if constexpr (Traced) logInstruction("BIT 2, B");
 }
+template<bool Traced>
 void CPULR35902::PR_51() {
     T += 8;
     const auto zero = (BC.right & 0b00000100) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 2, C");
+    if constexpr (Traced) logInstruction("BIT 2, C");
 }
+template<bool Traced>
 void CPULR35902::PR_52() {
     T += 8;
     const auto zero = (DE.left & 0b00000100) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 2, D");
+    if constexpr (Traced) logInstruction("BIT 2, D");
 }
+template<bool Traced>
 void CPULR35902::PR_53() {
     T += 8;
     const auto zero = (DE.right & 0b00000100) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 2, E");
+    if constexpr (Traced) logInstruction("BIT 2, E");
 }
+template<bool Traced>
 void CPULR35902::PR_54() {
     T += 8;
     const auto zero = (HL.left & 0b00000100) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 2, H");
+    if constexpr (Traced) logInstruction("BIT 2, H");
 }
+template<bool Traced>
 void CPULR35902::PR_55() {
     T += 8;
     const auto zero = (HL.right & 0b00000100) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 2, L");
+    if constexpr (Traced) logInstruction("BIT 2, L");
 }
+template<bool Traced>
 void CPULR35902::PR_56() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     const auto zero = (value & 0b00000100) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 2, (HL)");
+    if constexpr (Traced) logInstruction("BIT 2, (HL)");
 }
+template<bool Traced>
 void CPULR35902::PR_57() {
     T += 8;
     const auto zero = (AF.left & 0b00000100) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 2, A");
+    if constexpr (Traced) logInstruction("BIT 2, A");
 }
+template<bool Traced>
 void CPULR35902::PR_58() {
     T += 8;
     const auto zero = (BC.left & 0b00001000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 3, B");
+    if constexpr (Traced) logInstruction("BIT 3, B");
 }
+template<bool Traced>
 void CPULR35902::PR_59() {
     T += 8;
     const auto zero = (BC.right & 0b00001000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 3, C");
+    if constexpr (Traced) logInstruction("BIT 3, C");
 }
+template<bool Traced>
 void CPULR35902::PR_5A() {
     T += 8;
     const auto zero = (DE.left & 0b00001000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 3, D");
+    if constexpr (Traced) logInstruction("BIT 3, D");
 }
+template<bool Traced>
 void CPULR35902::PR_5B() {
     T += 8;
     const auto zero = (DE.right & 0b00001000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 3, E");
+    if constexpr (Traced) logInstruction("BIT 3, E");
 }
+template<bool Traced>
 void CPULR35902::PR_5C() {
     T += 8;
     const auto zero = (HL.left & 0b00001000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 3, H");
+    if constexpr (Traced) logInstruction("BIT 3, H");
 }
+template<bool Traced>
 void CPULR35902::PR_5D() {
     T += 8;
     const auto zero = (HL.right & 0b00001000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 3, L");
+    if constexpr (Traced) logInstruction("BIT 3, L");
 }
+template<bool Traced>
 void CPULR35902::PR_5E() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     const auto zero = (value & 0b00001000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 3, (HL)");
+    if constexpr (Traced) logInstruction("BIT 3, (HL)");
 }
+template<bool Traced>
 void CPULR35902::PR_5F() {
     T += 8;
     const auto zero = (AF.left & 0b00001000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 3, A");
+    if constexpr (Traced) logInstruction("BIT 3, A");
 }
+template<bool Traced>
 void CPULR35902::PR_60() {
     T += 8;
     const auto zero = (BC.left & 0b00010000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 4, B");
+    if constexpr (Traced) logInstruction("BIT 4, B");
 }
+template<bool Traced>
 void CPULR35902::PR_61() {
     T += 8;
     const auto zero = (BC.right & 0b00010000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 4, C");
+    if constexpr (Traced) logInstruction("BIT 4, C");
 }
+template<bool Traced>
 void CPULR35902::PR_62() {
     T += 8;
     const auto zero = (DE.left & 0b00010000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 4, D");
+    if constexpr (Traced) logInstruction("BIT 4, D");
 }
+template<bool Traced>
 void CPULR35902::PR_63() {
     T += 8;
     const auto zero = (DE.right & 0b00010000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 4, E");
+    if constexpr (Traced) logInstruction("BIT 4, E");
 }
+template<bool Traced>
 void CPULR35902::PR_64() {
     T += 8;
     const auto zero = (HL.left & 0b00010000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 4, H");
+    if constexpr (Traced) logInstruction("BIT 4, H");
 }
+template<bool Traced>
 void CPULR35902::PR_65() {
     T += 8;
     const auto zero = (HL.right & 0b00010000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 4, L");
+    if constexpr (Traced) logInstruction("BIT 4, L");
 }
+template<bool Traced>
 void CPULR35902::PR_66() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     const auto zero = (value & 0b00010000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 4, (HL)");
+    if constexpr (Traced) logInstruction("BIT 4, (HL)");
 }
+template<bool Traced>
 void CPULR35902::PR_67() {
     T += 8;
     const auto zero = (AF.left & 0b00010000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 4, A");
+    if constexpr (Traced) logInstruction("BIT 4, A");
 }
+template<bool Traced>
 void CPULR35902::PR_68() {
     T += 8;
     const auto zero = (BC.left & 0b00100000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 5, B");
+    if constexpr (Traced) logInstruction("BIT 5, B");
 }
+template<bool Traced>
 void CPULR35902::PR_69() {
     T += 8;
     const auto zero = (BC.right & 0b00100000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 5, C");
+    if constexpr (Traced) logInstruction("BIT 5, C");
 }
+template<bool Traced>
 void CPULR35902::PR_6A() {
     T += 8;
     const auto zero = (DE.left & 0b00100000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 5, D");
+    if constexpr (Traced) logInstruction("BIT 5, D");
 }
+template<bool Traced>
 void CPULR35902::PR_6B() {
     T += 8;
     const auto zero = (DE.right & 0b00100000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 5, E");
+    if constexpr (Traced) logInstruction("BIT 5, E");
 }
+template<bool Traced>
 void CPULR35902::PR_6C() {
     T += 8;
     const auto zero = (HL.left & 0b00100000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 5, H");
+    if constexpr (Traced) logInstruction("BIT 5, H");
 }
+template<bool Traced>
 void CPULR35902::PR_6D() {
     T += 8;
     const auto zero = (HL.right & 0b00100000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 5, L");
+    if constexpr (Traced) logInstruction("BIT 5, L");
 }
+template<bool Traced>
 void CPULR35902::PR_6E() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     const auto zero = (value & 0b00100000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 5, (HL)");
+    if constexpr (Traced) logInstruction("BIT 5, (HL)");
 }
+template<bool Traced>
 void CPULR35902::PR_6F() {
     T += 8;
     const auto zero = (AF.left & 0b00100000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 5, A");
+    if constexpr (Traced) logInstruction("BIT 5, A");
 }
+template<bool Traced>
 void CPULR35902::PR_70() {
     T += 8;
     const auto zero = (BC.left & 0b01000000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 6, B");
+    if constexpr (Traced) logInstruction("BIT 6, B");
 }
+template<bool Traced>
 void CPULR35902::PR_71() {
     T += 8;
     const auto zero = (BC.right & 0b01000000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 6, C");
+    if constexpr (Traced) logInstruction("BIT 6, C");
 }
+template<bool Traced>
 void CPULR35902::PR_72() {
     T += 8;
     const auto zero = (DE.left & 0b01000000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 6, D");
+    if constexpr (Traced) logInstruction("BIT 6, D");
 }
+template<bool Traced>
 void CPULR35902::PR_73() {
     T += 8;
     const auto zero = (DE.right & 0b01000000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 6, E");
+    if constexpr (Traced) logInstruction("BIT 6, E");
 }
+template<bool Traced>
 void CPULR35902::PR_74() {
     T += 8;
     const auto zero = (HL.left & 0b01000000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 6, H");
+    if constexpr (Traced) logInstruction("BIT 6, H");
 }
+template<bool Traced>
 void CPULR35902::PR_75() {
     T += 8;
     const auto zero = (HL.right & 0b01000000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 6, L");
+    if constexpr (Traced) logInstruction("BIT 6, L");
 }
+template<bool Traced>
 void CPULR35902::PR_76() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     const auto zero = (value & 0b01000000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 6, (HL)");
+    if constexpr (Traced) logInstruction("BIT 6, (HL)");
 }
+template<bool Traced>
 void CPULR35902::PR_77() {
     T += 8;
     const auto zero = (AF.left & 0b01000000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 6, A");
+    if constexpr (Traced) logInstruction("BIT 6, A");
 }
+template<bool Traced>
 void CPULR35902::PR_78() {
     T += 8;
     const auto zero = (BC.left & 0b10000000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 7, B");
+    if constexpr (Traced) logInstruction("BIT 7, B");
 }
+template<bool Traced>
 void CPULR35902::PR_79() {
     T += 8;
     const auto zero = (BC.right & 0b10000000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 7, C");
+    if constexpr (Traced) logInstruction("BIT 7, C");
 }
+template<bool Traced>
 void CPULR35902::PR_7A() {
     T += 8;
     const auto zero = (DE.left & 0b10000000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 7, D");
+    if constexpr (Traced) logInstruction("BIT 7, D");
 }
+template<bool Traced>
 void CPULR35902::PR_7B() {
     T += 8;
     const auto zero = (DE.right & 0b10000000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 7, E");
+    if constexpr (Traced) logInstruction("BIT 7, E");
 }
+template<bool Traced>
 void CPULR35902::PR_7C() {
     T += 8;
     const auto zero = (HL.left & 0b10000000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 7, H");
+    if constexpr (Traced) logInstruction("BIT 7, H");
 }
+template<bool Traced>
 void CPULR35902::PR_7D() {
     T += 8;
     const auto zero = (HL.right & 0b10000000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 7, L");
+    if constexpr (Traced) logInstruction("BIT 7, L");
 }
+template<bool Traced>
 void CPULR35902::PR_7E() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     const auto zero = (value & 0b10000000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 7, (HL)");
+    if constexpr (Traced) logInstruction("BIT 7, (HL)");
 }
+template<bool Traced>
 void CPULR35902::PR_7F() {
     T += 8;
     const auto zero = (AF.left & 0b10000000) == 0;
     setFlags(zero, 0, 1, -1);
-    if (m_debug) logInstruction("BIT 7, A");
+    if constexpr (Traced) logInstruction("BIT 7, A");
 }
+template<bool Traced>
 void CPULR35902::PR_80() {
     T += 8;
     BC.left &= 0b11111110;
-    if (m_debug) logInstruction("RES 0, B");
+    if constexpr (Traced) logInstruction("RES 0, B");
 }
+template<bool Traced>
 void CPULR35902::PR_81() {
     T += 8;
     BC.right &= 0b11111110;
-    if (m_debug) logInstruction("RES 0, C");
+    if constexpr (Traced) logInstruction("RES 0, C");
 }
+template<bool Traced>
 void CPULR35902::PR_82() {
     T += 8;
     DE.left &= 0b11111110;
-    if (m_debug) logInstruction("RES 0, D");
+    if constexpr (Traced) logInstruction("RES 0, D");
 }
+template<bool Traced>
 void CPULR35902::PR_83() {
     T += 8;
     DE.right &= 0b11111110;
-    if (m_debug) logInstruction("RES 0, E");
+    if constexpr (Traced) logInstruction("RES 0, E");
 }
+template<bool Traced>
 void CPULR35902::PR_84() {
     T += 8;
     HL.left &= 0b11111110;
-    if (m_debug) logInstruction("RES 0, H");
+    if constexpr (Traced) logInstruction("RES 0, H");
 }
+template<bool Traced>
 void CPULR35902::PR_85() {
     T += 8;
     HL.right &= 0b11111110;
-    if (m_debug) logInstruction("RES 0, L");
+    if constexpr (Traced) logInstruction("RES 0, L");
 }
+template<bool Traced>
 void CPULR35902::PR_86() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     m_bus->write(HL.w, value & 0b11111110);
-    if (m_debug) logInstruction("RES 0, HL");
+    if constexpr (Traced) logInstruction("RES 0, HL");
 }
+template<bool Traced>
 void CPULR35902::PR_87() {
     T += 8;
     AF.left &= 0b11111110;
-    if (m_debug) logInstruction("RES 0, A");
+    if constexpr (Traced) logInstruction("RES 0, A");
 }
+template<bool Traced>
 void CPULR35902::PR_88() {
     T += 8;
     BC.left &= 0b11111101;
-    if (m_debug) logInstruction("RES 1, B");
+    if constexpr (Traced) logInstruction("RES 1, B");
 }
+template<bool Traced>
 void CPULR35902::PR_89() {
     T += 8;
     BC.right &= 0b11111101;
-    if (m_debug) logInstruction("RES 1, C");
+    if constexpr (Traced) logInstruction("RES 1, C");
 }
+template<bool Traced>
 void CPULR35902::PR_8A() {
     T += 8;
     DE.left &= 0b11111101;
-    if (m_debug) logInstruction("RES 1, D");
+    if constexpr (Traced) logInstruction("RES 1, D");
 }
+template<bool Traced>
 void CPULR35902::PR_8B() {
     T += 8;
     DE.right &= 0b11111101;
-    if (m_debug) logInstruction("RES 1, E");
+    if constexpr (Traced) logInstruction("RES 1, E");
 }
+template<bool Traced>
 void CPULR35902::PR_8C() {
     T += 8;
     HL.left &= 0b11111101;
-    if (m_debug) logInstruction("RES 1, H");
+    if constexpr (Traced) logInstruction("RES 1, H");
 }
+template<bool Traced>
 void CPULR35902::PR_8D() {
     T += 8;
     HL.right &= 0b11111101;
-    if (m_debug) logInstruction("RES 1, L");
+    if constexpr (Traced) logInstruction("RES 1, L");
 }
+template<bool Traced>
 void CPULR35902::PR_8E() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     m_bus->write(HL.w, value & 0b11111101);
-    if (m_debug) logInstruction("RES 1, HL");
+    if constexpr (Traced) logInstruction("RES 1, HL");
 }
+template<bool Traced>
 void CPULR35902::PR_8F() {
     T += 8;
     AF.left &= 0b11111101;
-    if (m_debug) logInstruction("RES 1, A");
+    if constexpr (Traced) logInstruction("RES 1, A");
 }
+template<bool Traced>
 void CPULR35902::PR_90() {
     T += 8;
     BC.left &= 0b11111011;
-    if (m_debug) logInstruction("RES 2, B");
+    if constexpr (Traced) logInstruction("RES 2, B");
 }
+template<bool Traced>
 void CPULR35902::PR_91() {
     T += 8;
     BC.right &= 0b11111011;
-    if (m_debug) logInstruction("RES 2, C");
+    if constexpr (Traced) logInstruction("RES 2, C");
 }
+template<bool Traced>
 void CPULR35902::PR_92() {
     T += 8;
     DE.left &= 0b11111011;
-    if (m_debug) logInstruction("RES 2, D");
+    if constexpr (Traced) logInstruction("RES 2, D");
 }
+template<bool Traced>
 void CPULR35902::PR_93() {
     T += 8;
     DE.right &= 0b11111011;
-    if (m_debug) logInstruction("RES 2, E");
+    if constexpr (Traced) logInstruction("RES 2, E");
 }
+template<bool Traced>
 void CPULR35902::PR_94() {
     T += 8;
     HL.left &= 0b11111011;
-    if (m_debug) logInstruction("RES 2, H");
+    if constexpr (Traced) logInstruction("RES 2, H");
 }
+template<bool Traced>
 void CPULR35902::PR_95() {
     T += 8;
     HL.right &= 0b11111011;
-    if (m_debug) logInstruction("RES 2, L");
+    if constexpr (Traced) logInstruction("RES 2, L");
 }
+template<bool Traced>
 void CPULR35902::PR_96() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     m_bus->write(HL.w, value & 0b11111011);
-    if (m_debug) logInstruction("RES 2, HL");
+    if constexpr (Traced) logInstruction("RES 2, HL");
 }
+template<bool Traced>
 void CPULR35902::PR_97() {
     T += 8;
     AF.left &= 0b11111011;
-    if (m_debug) logInstruction("RES 2, A");
+    if constexpr (Traced) logInstruction("RES 2, A");
 }
+template<bool Traced>
 void CPULR35902::PR_98() {
     T += 8;
     BC.left &= 0b11110111;
-    if (m_debug) logInstruction("RES 3, B");
+    if constexpr (Traced) logInstruction("RES 3, B");
 }
+template<bool Traced>
 void CPULR35902::PR_99() {
     T += 8;
     BC.right &= 0b11110111;
-    if (m_debug) logInstruction("RES 3, C");
+    if constexpr (Traced) logInstruction("RES 3, C");
 }
+template<bool Traced>
 void CPULR35902::PR_9A() {
     T += 8;
     DE.left &= 0b11110111;
-    if (m_debug) logInstruction("RES 3, D");
+    if constexpr (Traced) logInstruction("RES 3, D");
 }
+template<bool Traced>
 void CPULR35902::PR_9B() {
     T += 8;
     DE.right &= 0b11110111;
-    if (m_debug) logInstruction("RES 3, E");
+    if constexpr (Traced) logInstruction("RES 3, E");
 }
+template<bool Traced>
 void CPULR35902::PR_9C() {
     T += 8;
     HL.left &= 0b11110111;
-    if (m_debug) logInstruction("RES 3, H");
+    if constexpr (Traced) logInstruction("RES 3, H");
 }
+template<bool Traced>
 void CPULR35902::PR_9D() {
     T += 8;
     HL.right &= 0b11110111;
-    if (m_debug) logInstruction("RES 3, L");
+    if constexpr (Traced) logInstruction("RES 3, L");
 }
+template<bool Traced>
 void CPULR35902::PR_9E() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     m_bus->write(HL.w, value & 0b11110111);
-    if (m_debug) logInstruction("RES 3, HL");
+    if constexpr (Traced) logInstruction("RES 3, HL");
 }
+template<bool Traced>
 void CPULR35902::PR_9F() {
     T += 8;
     AF.left &= 0b11110111;
-    if (m_debug) logInstruction("RES 3, A");
+    if constexpr (Traced) logInstruction("RES 3, A");
 }
+template<bool Traced>
 void CPULR35902::PR_A0() {
     T += 8;
     BC.left &= 0b11101111;
-    if (m_debug) logInstruction("RES 4, B");
+    if constexpr (Traced) logInstruction("RES 4, B");
 }
+template<bool Traced>
 void CPULR35902::PR_A1() {
     T += 8;
     BC.right &= 0b11101111;
-    if (m_debug) logInstruction("RES 4, C");
+    if constexpr (Traced) logInstruction("RES 4, C");
 }
+template<bool Traced>
 void CPULR35902::PR_A2() {
     T += 8;
     DE.left &= 0b11101111;
-    if (m_debug) logInstruction("RES 4, D");
+    if constexpr (Traced) logInstruction("RES 4, D");
 }
+template<bool Traced>
 void CPULR35902::PR_A3() {
     T += 8;
     DE.right &= 0b11101111;
-    if (m_debug) logInstruction("RES 4, E");
+    if constexpr (Traced) logInstruction("RES 4, E");
 }
+template<bool Traced>
 void CPULR35902::PR_A4() {
     T += 8;
     HL.left &= 0b11101111;
-    if (m_debug) logInstruction("RES 4, H");
+    if constexpr (Traced) logInstruction("RES 4, H");
 }
+template<bool Traced>
 void CPULR35902::PR_A5() {
     T += 8;
     HL.right &= 0b11101111;
-    if (m_debug) logInstruction("RES 4, L");
+    if constexpr (Traced) logInstruction("RES 4, L");
 }
+template<bool Traced>
 void CPULR35902::PR_A6() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     m_bus->write(HL.w, value & 0b11101111);
-    if (m_debug) logInstruction("RES 4, HL");
+    if constexpr (Traced) logInstruction("RES 4, HL");
 }
+template<bool Traced>
 void CPULR35902::PR_A7() {
     T += 8;
     AF.left &= 0b11101111;
-    if (m_debug) logInstruction("RES 4, A");
+    if constexpr (Traced) logInstruction("RES 4, A");
 }
+template<bool Traced>
 void CPULR35902::PR_A8() {
     T += 8;
     BC.left &= 0b11011111;
-    if (m_debug) logInstruction("RES 5, B");
+    if constexpr (Traced) logInstruction("RES 5, B");
 }
+template<bool Traced>
 void CPULR35902::PR_A9() {
     T += 8;
     BC.right &= 0b11011111;
-    if (m_debug) logInstruction("RES 5, C");
+    if constexpr (Traced) logInstruction("RES 5, C");
 }
+template<bool Traced>
 void CPULR35902::PR_AA() {
     T += 8;
     DE.left &= 0b11011111;
-    if (m_debug) logInstruction("RES 5, D");
+    if constexpr (Traced) logInstruction("RES 5, D");
 }
+template<bool Traced>
 void CPULR35902::PR_AB() {
     T += 8;
     DE.right &= 0b11011111;
-    if (m_debug) logInstruction("RES 5, E");
+    if constexpr (Traced) logInstruction("RES 5, E");
 }
+template<bool Traced>
 void CPULR35902::PR_AC() {
     T += 8;
     HL.left &= 0b11011111;
-    if (m_debug) logInstruction("RES 5, H");
+    if constexpr (Traced) logInstruction("RES 5, H");
 }
+template<bool Traced>
 void CPULR35902::PR_AD() {
     T += 8;
     HL.right &= 0b11011111;
-    if (m_debug) logInstruction("RES 5, L");
+    if constexpr (Traced) logInstruction("RES 5, L");
 }
+template<bool Traced>
 void CPULR35902::PR_AE() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     m_bus->write(HL.w, value & 0b11011111);
-    if (m_debug) logInstruction("RES 5, HL");
+    if constexpr (Traced) logInstruction("RES 5, HL");
 }
+template<bool Traced>
 void CPULR35902::PR_AF() {
     T += 8;
     AF.left &= 0b11011111;
-    if (m_debug) logInstruction("RES 5, A");
+    if constexpr (Traced) logInstruction("RES 5, A");
 }
+template<bool Traced>
 void CPULR35902::PR_B0() {
     T += 8;
     BC.left &= 0b10111111;
-    if (m_debug) logInstruction("RES 6, B");
+    if constexpr (Traced) logInstruction("RES 6, B");
 }
+template<bool Traced>
 void CPULR35902::PR_B1() {
     T += 8;
     BC.right &= 0b10111111;
-    if (m_debug) logInstruction("RES 6, C");
+    if constexpr (Traced) logInstruction("RES 6, C");
 }
+template<bool Traced>
 void CPULR35902::PR_B2() {
     T += 8;
     DE.left &= 0b10111111;
-    if (m_debug) logInstruction("RES 6, D");
+    if constexpr (Traced) logInstruction("RES 6, D");
 }
+template<bool Traced>
 void CPULR35902::PR_B3() {
     T += 8;
     DE.right &= 0b10111111;
-    if (m_debug) logInstruction("RES 6, E");
+    if constexpr (Traced) logInstruction("RES 6, E");
 }
+template<bool Traced>
 void CPULR35902::PR_B4() {
     T += 8;
     HL.left &= 0b10111111;
-    if (m_debug) logInstruction("RES 6, H");
+    if constexpr (Traced) logInstruction("RES 6, H");
 }
+template<bool Traced>
 void CPULR35902::PR_B5() {
     T += 8;
     HL.right &= 0b10111111;
-    if (m_debug) logInstruction("RES 6, L");
+    if constexpr (Traced) logInstruction("RES 6, L");
 }
+template<bool Traced>
 void CPULR35902::PR_B6() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     m_bus->write(HL.w, value & 0b10111111);
-    if (m_debug) logInstruction("RES 6, HL");
+    if constexpr (Traced) logInstruction("RES 6, HL");
 }
+template<bool Traced>
 void CPULR35902::PR_B7() {
     T += 8;
     AF.left &= 0b10111111;
-    if (m_debug) logInstruction("RES 6, A");
+    if constexpr (Traced) logInstruction("RES 6, A");
 }
+template<bool Traced>
 void CPULR35902::PR_B8() {
     T += 8;
     BC.left &= 0b01111111;
-    if (m_debug) logInstruction("RES 7, B");
+    if constexpr (Traced) logInstruction("RES 7, B");
 }
+template<bool Traced>
 void CPULR35902::PR_B9() {
     T += 8;
     BC.right &= 0b01111111;
-    if (m_debug) logInstruction("RES 7, C");
+    if constexpr (Traced) logInstruction("RES 7, C");
 }
+template<bool Traced>
 void CPULR35902::PR_BA() {
     T += 8;
     DE.left &= 0b01111111;
-    if (m_debug) logInstruction("RES 7, D");
+    if constexpr (Traced) logInstruction("RES 7, D");
 }
+template<bool Traced>
 void CPULR35902::PR_BB() {
     T += 8;
     DE.right &= 0b01111111;
-    if (m_debug) logInstruction("RES 7, E");
+    if constexpr (Traced) logInstruction("RES 7, E");
 }
+template<bool Traced>
 void CPULR35902::PR_BC() {
     T += 8;
     HL.left &= 0b01111111;
-    if (m_debug) logInstruction("RES 7, H");
+    if constexpr (Traced) logInstruction("RES 7, H");
 }
+template<bool Traced>
 void CPULR35902::PR_BD() {
     T += 8;
     HL.right &= 0b01111111;
-    if (m_debug) logInstruction("RES 7, L");
+    if constexpr (Traced) logInstruction("RES 7, L");
 }
+template<bool Traced>
 void CPULR35902::PR_BE() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     m_bus->write(HL.w, value & 0b01111111);
-    if (m_debug) logInstruction("RES 7, HL");
+    if constexpr (Traced) logInstruction("RES 7, HL");
 }
+template<bool Traced>
 void CPULR35902::PR_BF() {
     T += 8;
     AF.left &= 0b01111111;
-    if (m_debug) logInstruction("RES 7, A");
+    if constexpr (Traced) logInstruction("RES 7, A");
 }
+template<bool Traced>
 void CPULR35902::PR_C0() {
     T += 8;
     BC.left |= 0b00000001;
-    if (m_debug) logInstruction("SET 0, B");
+    if constexpr (Traced) logInstruction("SET 0, B");
 }
+template<bool Traced>
 void CPULR35902::PR_C1() {
     T += 8;
     BC.right |= 0b00000001;
-    if (m_debug) logInstruction("SET 0, C");
+    if constexpr (Traced) logInstruction("SET 0, C");
 }
+template<bool Traced>
 void CPULR35902::PR_C2() {
     T += 8;
     DE.left |= 0b00000001;
-    if (m_debug) logInstruction("SET 0, D");
+    if constexpr (Traced) logInstruction("SET 0, D");
 }
+template<bool Traced>
 void CPULR35902::PR_C3() {
     T += 8;
     DE.right |= 0b00000001;
-    if (m_debug) logInstruction("SET 0, E");
+    if constexpr (Traced) logInstruction("SET 0, E");
 }
+template<bool Traced>
 void CPULR35902::PR_C4() {
     T += 8;
     HL.left |= 0b00000001;
-    if (m_debug) logInstruction("SET 0, H");
+    if constexpr (Traced) logInstruction("SET 0, H");
 }
+template<bool Traced>
 void CPULR35902::PR_C5() {
     T += 8;
     HL.right |= 0b00000001;
-    if (m_debug) logInstruction("SET 0, L");
+    if constexpr (Traced) logInstruction("SET 0, L");
 }
+template<bool Traced>
 void CPULR35902::PR_C6() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     m_bus->write(HL.w, value | 0b00000001);
-    if (m_debug) logInstruction("SET 0, HL");
+    if constexpr (Traced) logInstruction("SET 0, HL");
 }
+template<bool Traced>
 void CPULR35902::PR_C7() {
     T += 8;
     AF.left |= 0b00000001;
-    if (m_debug) logInstruction("SET 0, A");
+    if constexpr (Traced) logInstruction("SET 0, A");
 }
+template<bool Traced>
 void CPULR35902::PR_C8() {
     T += 8;
     BC.left |= 0b00000010;
-    if (m_debug) logInstruction("SET 1, B");
+    if constexpr (Traced) logInstruction("SET 1, B");
 }
+template<bool Traced>
 void CPULR35902::PR_C9() {
     T += 8;
     BC.right |= 0b00000010;
-    if (m_debug) logInstruction("SET 1, C");
+    if constexpr (Traced) logInstruction("SET 1, C");
 }
+template<bool Traced>
 void CPULR35902::PR_CA() {
     T += 8;
     DE.left |= 0b00000010;
-    if (m_debug) logInstruction("SET 1, D");
+    if constexpr (Traced) logInstruction("SET 1, D");
 }
+template<bool Traced>
 void CPULR35902::PR_CB() {
     T += 8;
     DE.right |= 0b00000010;
-    if (m_debug) logInstruction("SET 1, E");
+    if constexpr (Traced) logInstruction("SET 1, E");
 }
+template<bool Traced>
 void CPULR35902::PR_CC() {
     T += 8;
     HL.left |= 0b00000010;
-    if (m_debug) logInstruction("SET 1, H");
+    if constexpr (Traced) logInstruction("SET 1, H");
 }
+template<bool Traced>
 void CPULR35902::PR_CD() {
     T += 8;
     HL.right |= 0b00000010;
-    if (m_debug) logInstruction("SET 1, L");
+    if constexpr (Traced) logInstruction("SET 1, L");
 }
+template<bool Traced>
 void CPULR35902::PR_CE() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     m_bus->write(HL.w, value | 0b00000010);
-    if (m_debug) logInstruction("SET 1, HL");
+    if constexpr (Traced) logInstruction("SET 1, HL");
 }
+template<bool Traced>
 void CPULR35902::PR_CF() {
     T += 8;
     AF.left |= 0b00000010;
-    if (m_debug) logInstruction("SET 1, A");
+    if constexpr (Traced) logInstruction("SET 1, A");
 }
+template<bool Traced>
 void CPULR35902::PR_D0() {
     T += 8;
     BC.left |= 0b00000100;
-    if (m_debug) logInstruction("SET 2, B");
+    if constexpr (Traced) logInstruction("SET 2, B");
 }
+template<bool Traced>
 void CPULR35902::PR_D1() {
     T += 8;
     BC.right |= 0b00000100;
-    if (m_debug) logInstruction("SET 2, C");
+    if constexpr (Traced) logInstruction("SET 2, C");
 }
+template<bool Traced>
 void CPULR35902::PR_D2() {
     T += 8;
     DE.left |= 0b00000100;
-    if (m_debug) logInstruction("SET 2, D");
+    if constexpr (Traced) logInstruction("SET 2, D");
 }
+template<bool Traced>
 void CPULR35902::PR_D3() {
     T += 8;
     DE.right |= 0b00000100;
-    if (m_debug) logInstruction("SET 2, E");
+    if constexpr (Traced) logInstruction("SET 2, E");
 }
+template<bool Traced>
 void CPULR35902::PR_D4() {
     T += 8;
     HL.left |= 0b00000100;
-    if (m_debug) logInstruction("SET 2, H");
+    if constexpr (Traced) logInstruction("SET 2, H");
 }
+template<bool Traced>
 void CPULR35902::PR_D5() {
     T += 8;
     HL.right |= 0b00000100;
-    if (m_debug) logInstruction("SET 2, L");
+    if constexpr (Traced) logInstruction("SET 2, L");
 }
+template<bool Traced>
 void CPULR35902::PR_D6() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     m_bus->write(HL.w, value | 0b00000100);
-    if (m_debug) logInstruction("SET 2, HL");
+    if constexpr (Traced) logInstruction("SET 2, HL");
 }
+template<bool Traced>
 void CPULR35902::PR_D7() {
     T += 8;
     AF.left |= 0b00000100;
-    if (m_debug) logInstruction("SET 2, A");
+    if constexpr (Traced) logInstruction("SET 2, A");
 }
+template<bool Traced>
 void CPULR35902::PR_D8() {
     T += 8;
     BC.left |= 0b00001000;
-    if (m_debug) logInstruction("SET 3, B");
+    if constexpr (Traced) logInstruction("SET 3, B");
 }
+template<bool Traced>
 void CPULR35902::PR_D9() {
     T += 8;
     BC.right |= 0b00001000;
-    if (m_debug) logInstruction("SET 3, C");
+    if constexpr (Traced) logInstruction("SET 3, C");
 }
+template<bool Traced>
 void CPULR35902::PR_DA() {
     T += 8;
     DE.left |= 0b00001000;
-    if (m_debug) logInstruction("SET 3, D");
+    if constexpr (Traced) logInstruction("SET 3, D");
 }
+template<bool Traced>
 void CPULR35902::PR_DB() {
     T += 8;
     DE.right |= 0b00001000;
-    if (m_debug) logInstruction("SET 3, E");
+    if constexpr (Traced) logInstruction("SET 3, E");
 }
+template<bool Traced>
 void CPULR35902::PR_DC() {
     T += 8;
     HL.left |= 0b00001000;
-    if (m_debug) logInstruction("SET 3, H");
+    if constexpr (Traced) logInstruction("SET 3, H");
 }
+template<bool Traced>
 void CPULR35902::PR_DD() {
     T += 8;
     HL.right |= 0b00001000;
-    if (m_debug) logInstruction("SET 3, L");
+    if constexpr (Traced) logInstruction("SET 3, L");
 }
+template<bool Traced>
 void CPULR35902::PR_DE() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     m_bus->write(HL.w, value | 0b00001000);
-    if (m_debug) logInstruction("SET 3, HL");
+    if constexpr (Traced) logInstruction("SET 3, HL");
 }
+template<bool Traced>
 void CPULR35902::PR_DF() {
     T += 8;
     AF.left |= 0b00001000;
-    if (m_debug) logInstruction("SET 3, A");
+    if constexpr (Traced) logInstruction("SET 3, A");
 }
+template<bool Traced>
 void CPULR35902::PR_E0() {
     T += 8;
     BC.left |= 0b00010000;
-    if (m_debug) logInstruction("SET 4, B");
+    if constexpr (Traced) logInstruction("SET 4, B");
 }
+template<bool Traced>
 void CPULR35902::PR_E1() {
     T += 8;
     BC.right |= 0b00010000;
-    if (m_debug) logInstruction("SET 4, C");
+    if constexpr (Traced) logInstruction("SET 4, C");
 }
+template<bool Traced>
 void CPULR35902::PR_E2() {
     T += 8;
     DE.left |= 0b00010000;
-    if (m_debug) logInstruction("SET 4, D");
+    if constexpr (Traced) logInstruction("SET 4, D");
 }
+template<bool Traced>
 void CPULR35902::PR_E3() {
     T += 8;
     DE.right |= 0b00010000;
-    if (m_debug) logInstruction("SET 4, E");
+    if constexpr (Traced) logInstruction("SET 4, E");
 }
+template<bool Traced>
 void CPULR35902::PR_E4() {
     T += 8;
     HL.left |= 0b00010000;
-    if (m_debug) logInstruction("SET 4, H");
+    if constexpr (Traced) logInstruction("SET 4, H");
 }
+template<bool Traced>
 void CPULR35902::PR_E5() {
     T += 8;
     HL.right |= 0b00010000;
-    if (m_debug) logInstruction("SET 4, L");
+    if constexpr (Traced) logInstruction("SET 4, L");
 }
+template<bool Traced>
 void CPULR35902::PR_E6() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     m_bus->write(HL.w, value | 0b00010000);
-    if (m_debug) logInstruction("SET 4, HL");
+    if constexpr (Traced) logInstruction("SET 4, HL");
 }
+template<bool Traced>
 void CPULR35902::PR_E7() {
     T += 8;
     AF.left |= 0b00010000;
-    if (m_debug) logInstruction("SET 4, A");
+    if constexpr (Traced) logInstruction("SET 4, A");
 }
+template<bool Traced>
 void CPULR35902::PR_E8() {
     T += 8;
     BC.left |= 0b00100000;
-    if (m_debug) logInstruction("SET 5, B");
+    if constexpr (Traced) logInstruction("SET 5, B");
 }
+template<bool Traced>
 void CPULR35902::PR_E9() {
     T += 8;
     BC.right |= 0b00100000;
-    if (m_debug) logInstruction("SET 5, C");
+    if constexpr (Traced) logInstruction("SET 5, C");
 }
+template<bool Traced>
 void CPULR35902::PR_EA() {
     T += 8;
     DE.left |= 0b00100000;
-    if (m_debug) logInstruction("SET 5, D");
+    if constexpr (Traced) logInstruction("SET 5, D");
 }
+template<bool Traced>
 void CPULR35902::PR_EB() {
     T += 8;
     DE.right |= 0b00100000;
-    if (m_debug) logInstruction("SET 5, E");
+    if constexpr (Traced) logInstruction("SET 5, E");
 }
+template<bool Traced>
 void CPULR35902::PR_EC() {
     T += 8;
     HL.left |= 0b00100000;
-    if (m_debug) logInstruction("SET 5, H");
+    if constexpr (Traced) logInstruction("SET 5, H");
 }
+template<bool Traced>
 void CPULR35902::PR_ED() {
     T += 8;
     HL.right |= 0b00100000;
-    if (m_debug) logInstruction("SET 5, L");
+    if constexpr (Traced) logInstruction("SET 5, L");
 }
+template<bool Traced>
 void CPULR35902::PR_EE() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     m_bus->write(HL.w, value | 0b00100000);
-    if (m_debug) logInstruction("SET 5, HL");
+    if constexpr (Traced) logInstruction("SET 5, HL");
 }
+template<bool Traced>
 void CPULR35902::PR_EF() {
     T += 8;
     AF.left |= 0b00100000;
-    if (m_debug) logInstruction("SET 5, A");
+    if constexpr (Traced) logInstruction("SET 5, A");
 }
+template<bool Traced>
 void CPULR35902::PR_F0() {
     T += 8;
     BC.left |= 0b01000000;
-    if (m_debug) logInstruction("SET 6, B");
+    if constexpr (Traced) logInstruction("SET 6, B");
 }
+template<bool Traced>
 void CPULR35902::PR_F1() {
     T += 8;
     BC.right |= 0b01000000;
-    if (m_debug) logInstruction("SET 6, C");
+    if constexpr (Traced) logInstruction("SET 6, C");
 }
+template<bool Traced>
 void CPULR35902::PR_F2() {
     T += 8;
     DE.left |= 0b01000000;
-    if (m_debug) logInstruction("SET 6, D");
+    if constexpr (Traced) logInstruction("SET 6, D");
 }
+template<bool Traced>
 void CPULR35902::PR_F3() {
     T += 8;
     DE.right |= 0b01000000;
-    if (m_debug) logInstruction("SET 6, E");
+    if constexpr (Traced) logInstruction("SET 6, E");
 }
+template<bool Traced>
 void CPULR35902::PR_F4() {
     T += 8;
     HL.left |= 0b01000000;
-    if (m_debug) logInstruction("SET 6, H");
+    if constexpr (Traced) logInstruction("SET 6, H");
 }
+template<bool Traced>
 void CPULR35902::PR_F5() {
     T += 8;
     HL.right |= 0b01000000;
-    if (m_debug) logInstruction("SET 6, L");
+    if constexpr (Traced) logInstruction("SET 6, L");
 }
+template<bool Traced>
 void CPULR35902::PR_F6() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     m_bus->write(HL.w, value | 0b01000000);
-    if (m_debug) logInstruction("SET 6, HL");
+    if constexpr (Traced) logInstruction("SET 6, HL");
 }
+template<bool Traced>
 void CPULR35902::PR_F7() {
     T += 8;
     AF.left |= 0b01000000;
-    if (m_debug) logInstruction("SET 6, A");
+    if constexpr (Traced) logInstruction("SET 6, A");
 }
+template<bool Traced>
 void CPULR35902::PR_F8() {
     T += 8;
     BC.left |= 0b10000000;
-    if (m_debug) logInstruction("SET 7, B");
+    if constexpr (Traced) logInstruction("SET 7, B");
 }
+template<bool Traced>
 void CPULR35902::PR_F9() {
     T += 8;
     BC.right |= 0b10000000;
-    if (m_debug) logInstruction("SET 7, C");
+    if constexpr (Traced) logInstruction("SET 7, C");
 }
+template<bool Traced>
 void CPULR35902::PR_FA() {
     T += 8;
     DE.left |= 0b10000000;
-    if (m_debug) logInstruction("SET 7, D");
+    if constexpr (Traced) logInstruction("SET 7, D");
 }
+template<bool Traced>
 void CPULR35902::PR_FB() {
     T += 8;
     DE.right |= 0b10000000;
-    if (m_debug) logInstruction("SET 7, E");
+    if constexpr (Traced) logInstruction("SET 7, E");
 }
+template<bool Traced>
 void CPULR35902::PR_FC() {
     T += 8;
     HL.left |= 0b10000000;
-    if (m_debug) logInstruction("SET 7, H");
+    if constexpr (Traced) logInstruction("SET 7, H");
 }
+template<bool Traced>
 void CPULR35902::PR_FD() {
     T += 8;
     HL.right |= 0b10000000;
-    if (m_debug) logInstruction("SET 7, L");
+    if constexpr (Traced) logInstruction("SET 7, L");
 }
+template<bool Traced>
 void CPULR35902::PR_FE() {
     T += 8;
     const auto value = m_bus->read(HL.w);
     m_bus->write(HL.w, value | 0b10000000);
-    if (m_debug) logInstruction("SET 7, HL");
+    if constexpr (Traced) logInstruction("SET 7, HL");
 }
+template<bool Traced>
 void CPULR35902::PR_FF() {
     T += 8;
     AF.left |= 0b10000000;
-    if (m_debug) logInstruction("SET 7, A");
+    if constexpr (Traced) logInstruction("SET 7, A");
 }
 
-void CPULR35902::initOpcodeHandlers() {
-    m_opcodeHandler[0x00] = std::bind(&CPULR35902::OP_00, this);
-    m_opcodeHandler[0x01] = std::bind(&CPULR35902::OP_01, this);
-    m_opcodeHandler[0x02] = std::bind(&CPULR35902::OP_02, this);
-    m_opcodeHandler[0x03] = std::bind(&CPULR35902::OP_03, this);
-    m_opcodeHandler[0x04] = std::bind(&CPULR35902::OP_04, this);
-    m_opcodeHandler[0x05] = std::bind(&CPULR35902::OP_05, this);
-    m_opcodeHandler[0x06] = std::bind(&CPULR35902::OP_06, this);
-    m_opcodeHandler[0x07] = std::bind(&CPULR35902::OP_07, this);
-    m_opcodeHandler[0x08] = std::bind(&CPULR35902::OP_08, this);
-    m_opcodeHandler[0x09] = std::bind(&CPULR35902::OP_09, this);
-    m_opcodeHandler[0x0A] = std::bind(&CPULR35902::OP_0A, this);
-    m_opcodeHandler[0x0B] = std::bind(&CPULR35902::OP_0B, this);
-    m_opcodeHandler[0x0C] = std::bind(&CPULR35902::OP_0C, this);
-    m_opcodeHandler[0x0D] = std::bind(&CPULR35902::OP_0D, this);
-    m_opcodeHandler[0x0E] = std::bind(&CPULR35902::OP_0E, this);
-    m_opcodeHandler[0x0F] = std::bind(&CPULR35902::OP_0F, this);
-    m_opcodeHandler[0x10] = std::bind(&CPULR35902::OP_10, this);
-    m_opcodeHandler[0x11] = std::bind(&CPULR35902::OP_11, this);
-    m_opcodeHandler[0x12] = std::bind(&CPULR35902::OP_12, this);
-    m_opcodeHandler[0x13] = std::bind(&CPULR35902::OP_13, this);
-    m_opcodeHandler[0x14] = std::bind(&CPULR35902::OP_14, this);
-    m_opcodeHandler[0x15] = std::bind(&CPULR35902::OP_15, this);
-    m_opcodeHandler[0x16] = std::bind(&CPULR35902::OP_16, this);
-    m_opcodeHandler[0x17] = std::bind(&CPULR35902::OP_17, this);
-    m_opcodeHandler[0x18] = std::bind(&CPULR35902::OP_18, this);
-    m_opcodeHandler[0x19] = std::bind(&CPULR35902::OP_19, this);
-    m_opcodeHandler[0x1A] = std::bind(&CPULR35902::OP_1A, this);
-    m_opcodeHandler[0x1B] = std::bind(&CPULR35902::OP_1B, this);
-    m_opcodeHandler[0x1C] = std::bind(&CPULR35902::OP_1C, this);
-    m_opcodeHandler[0x1D] = std::bind(&CPULR35902::OP_1D, this);
-    m_opcodeHandler[0x1E] = std::bind(&CPULR35902::OP_1E, this);
-    m_opcodeHandler[0x1F] = std::bind(&CPULR35902::OP_1F, this);
-    m_opcodeHandler[0x20] = std::bind(&CPULR35902::OP_20, this);
-    m_opcodeHandler[0x21] = std::bind(&CPULR35902::OP_21, this);
-    m_opcodeHandler[0x22] = std::bind(&CPULR35902::OP_22, this);
-    m_opcodeHandler[0x23] = std::bind(&CPULR35902::OP_23, this);
-    m_opcodeHandler[0x24] = std::bind(&CPULR35902::OP_24, this);
-    m_opcodeHandler[0x25] = std::bind(&CPULR35902::OP_25, this);
-    m_opcodeHandler[0x26] = std::bind(&CPULR35902::OP_26, this);
-    m_opcodeHandler[0x27] = std::bind(&CPULR35902::OP_27, this);
-    m_opcodeHandler[0x28] = std::bind(&CPULR35902::OP_28, this);
-    m_opcodeHandler[0x29] = std::bind(&CPULR35902::OP_29, this);
-    m_opcodeHandler[0x2A] = std::bind(&CPULR35902::OP_2A, this);
-    m_opcodeHandler[0x2B] = std::bind(&CPULR35902::OP_2B, this);
-    m_opcodeHandler[0x2C] = std::bind(&CPULR35902::OP_2C, this);
-    m_opcodeHandler[0x2D] = std::bind(&CPULR35902::OP_2D, this);
-    m_opcodeHandler[0x2E] = std::bind(&CPULR35902::OP_2E, this);
-    m_opcodeHandler[0x2F] = std::bind(&CPULR35902::OP_2F, this);
-    m_opcodeHandler[0x30] = std::bind(&CPULR35902::OP_30, this);
-    m_opcodeHandler[0x31] = std::bind(&CPULR35902::OP_31, this);
-    m_opcodeHandler[0x32] = std::bind(&CPULR35902::OP_32, this);
-    m_opcodeHandler[0x33] = std::bind(&CPULR35902::OP_33, this);
-    m_opcodeHandler[0x34] = std::bind(&CPULR35902::OP_34, this);
-    m_opcodeHandler[0x35] = std::bind(&CPULR35902::OP_35, this);
-    m_opcodeHandler[0x36] = std::bind(&CPULR35902::OP_36, this);
-    m_opcodeHandler[0x37] = std::bind(&CPULR35902::OP_37, this);
-    m_opcodeHandler[0x38] = std::bind(&CPULR35902::OP_38, this);
-    m_opcodeHandler[0x39] = std::bind(&CPULR35902::OP_39, this);
-    m_opcodeHandler[0x3A] = std::bind(&CPULR35902::OP_3A, this);
-    m_opcodeHandler[0x3B] = std::bind(&CPULR35902::OP_3B, this);
-    m_opcodeHandler[0x3C] = std::bind(&CPULR35902::OP_3C, this);
-    m_opcodeHandler[0x3D] = std::bind(&CPULR35902::OP_3D, this);
-    m_opcodeHandler[0x3E] = std::bind(&CPULR35902::OP_3E, this);
-    m_opcodeHandler[0x3F] = std::bind(&CPULR35902::OP_3F, this);
-    m_opcodeHandler[0x40] = std::bind(&CPULR35902::OP_40, this);
-    m_opcodeHandler[0x41] = std::bind(&CPULR35902::OP_41, this);
-    m_opcodeHandler[0x42] = std::bind(&CPULR35902::OP_42, this);
-    m_opcodeHandler[0x43] = std::bind(&CPULR35902::OP_43, this);
-    m_opcodeHandler[0x44] = std::bind(&CPULR35902::OP_44, this);
-    m_opcodeHandler[0x45] = std::bind(&CPULR35902::OP_45, this);
-    m_opcodeHandler[0x46] = std::bind(&CPULR35902::OP_46, this);
-    m_opcodeHandler[0x47] = std::bind(&CPULR35902::OP_47, this);
-    m_opcodeHandler[0x48] = std::bind(&CPULR35902::OP_48, this);
-    m_opcodeHandler[0x49] = std::bind(&CPULR35902::OP_49, this);
-    m_opcodeHandler[0x4A] = std::bind(&CPULR35902::OP_4A, this);
-    m_opcodeHandler[0x4B] = std::bind(&CPULR35902::OP_4B, this);
-    m_opcodeHandler[0x4C] = std::bind(&CPULR35902::OP_4C, this);
-    m_opcodeHandler[0x4D] = std::bind(&CPULR35902::OP_4D, this);
-    m_opcodeHandler[0x4E] = std::bind(&CPULR35902::OP_4E, this);
-    m_opcodeHandler[0x4F] = std::bind(&CPULR35902::OP_4F, this);
-    m_opcodeHandler[0x50] = std::bind(&CPULR35902::OP_50, this);
-    m_opcodeHandler[0x51] = std::bind(&CPULR35902::OP_51, this);
-    m_opcodeHandler[0x52] = std::bind(&CPULR35902::OP_52, this);
-    m_opcodeHandler[0x53] = std::bind(&CPULR35902::OP_53, this);
-    m_opcodeHandler[0x54] = std::bind(&CPULR35902::OP_54, this);
-    m_opcodeHandler[0x55] = std::bind(&CPULR35902::OP_55, this);
-    m_opcodeHandler[0x56] = std::bind(&CPULR35902::OP_56, this);
-    m_opcodeHandler[0x57] = std::bind(&CPULR35902::OP_57, this);
-    m_opcodeHandler[0x58] = std::bind(&CPULR35902::OP_58, this);
-    m_opcodeHandler[0x59] = std::bind(&CPULR35902::OP_59, this);
-    m_opcodeHandler[0x5A] = std::bind(&CPULR35902::OP_5A, this);
-    m_opcodeHandler[0x5B] = std::bind(&CPULR35902::OP_5B, this);
-    m_opcodeHandler[0x5C] = std::bind(&CPULR35902::OP_5C, this);
-    m_opcodeHandler[0x5D] = std::bind(&CPULR35902::OP_5D, this);
-    m_opcodeHandler[0x5E] = std::bind(&CPULR35902::OP_5E, this);
-    m_opcodeHandler[0x5F] = std::bind(&CPULR35902::OP_5F, this);
-    m_opcodeHandler[0x60] = std::bind(&CPULR35902::OP_60, this);
-    m_opcodeHandler[0x61] = std::bind(&CPULR35902::OP_61, this);
-    m_opcodeHandler[0x62] = std::bind(&CPULR35902::OP_62, this);
-    m_opcodeHandler[0x63] = std::bind(&CPULR35902::OP_63, this);
-    m_opcodeHandler[0x64] = std::bind(&CPULR35902::OP_64, this);
-    m_opcodeHandler[0x65] = std::bind(&CPULR35902::OP_65, this);
-    m_opcodeHandler[0x66] = std::bind(&CPULR35902::OP_66, this);
-    m_opcodeHandler[0x67] = std::bind(&CPULR35902::OP_67, this);
-    m_opcodeHandler[0x68] = std::bind(&CPULR35902::OP_68, this);
-    m_opcodeHandler[0x69] = std::bind(&CPULR35902::OP_69, this);
-    m_opcodeHandler[0x6A] = std::bind(&CPULR35902::OP_6A, this);
-    m_opcodeHandler[0x6B] = std::bind(&CPULR35902::OP_6B, this);
-    m_opcodeHandler[0x6C] = std::bind(&CPULR35902::OP_6C, this);
-    m_opcodeHandler[0x6D] = std::bind(&CPULR35902::OP_6D, this);
-    m_opcodeHandler[0x6E] = std::bind(&CPULR35902::OP_6E, this);
-    m_opcodeHandler[0x6F] = std::bind(&CPULR35902::OP_6F, this);
-    m_opcodeHandler[0x70] = std::bind(&CPULR35902::OP_70, this);
-    m_opcodeHandler[0x71] = std::bind(&CPULR35902::OP_71, this);
-    m_opcodeHandler[0x72] = std::bind(&CPULR35902::OP_72, this);
-    m_opcodeHandler[0x73] = std::bind(&CPULR35902::OP_73, this);
-    m_opcodeHandler[0x74] = std::bind(&CPULR35902::OP_74, this);
-    m_opcodeHandler[0x75] = std::bind(&CPULR35902::OP_75, this);
-    m_opcodeHandler[0x76] = std::bind(&CPULR35902::OP_76, this);
-    m_opcodeHandler[0x77] = std::bind(&CPULR35902::OP_77, this);
-    m_opcodeHandler[0x78] = std::bind(&CPULR35902::OP_78, this);
-    m_opcodeHandler[0x79] = std::bind(&CPULR35902::OP_79, this);
-    m_opcodeHandler[0x7A] = std::bind(&CPULR35902::OP_7A, this);
-    m_opcodeHandler[0x7B] = std::bind(&CPULR35902::OP_7B, this);
-    m_opcodeHandler[0x7C] = std::bind(&CPULR35902::OP_7C, this);
-    m_opcodeHandler[0x7D] = std::bind(&CPULR35902::OP_7D, this);
-    m_opcodeHandler[0x7E] = std::bind(&CPULR35902::OP_7E, this);
-    m_opcodeHandler[0x7F] = std::bind(&CPULR35902::OP_7F, this);
-    m_opcodeHandler[0x80] = std::bind(&CPULR35902::OP_80, this);
-    m_opcodeHandler[0x81] = std::bind(&CPULR35902::OP_81, this);
-    m_opcodeHandler[0x82] = std::bind(&CPULR35902::OP_82, this);
-    m_opcodeHandler[0x83] = std::bind(&CPULR35902::OP_83, this);
-    m_opcodeHandler[0x84] = std::bind(&CPULR35902::OP_84, this);
-    m_opcodeHandler[0x85] = std::bind(&CPULR35902::OP_85, this);
-    m_opcodeHandler[0x86] = std::bind(&CPULR35902::OP_86, this);
-    m_opcodeHandler[0x87] = std::bind(&CPULR35902::OP_87, this);
-    m_opcodeHandler[0x88] = std::bind(&CPULR35902::OP_88, this);
-    m_opcodeHandler[0x89] = std::bind(&CPULR35902::OP_89, this);
-    m_opcodeHandler[0x8A] = std::bind(&CPULR35902::OP_8A, this);
-    m_opcodeHandler[0x8B] = std::bind(&CPULR35902::OP_8B, this);
-    m_opcodeHandler[0x8C] = std::bind(&CPULR35902::OP_8C, this);
-    m_opcodeHandler[0x8D] = std::bind(&CPULR35902::OP_8D, this);
-    m_opcodeHandler[0x8E] = std::bind(&CPULR35902::OP_8E, this);
-    m_opcodeHandler[0x8F] = std::bind(&CPULR35902::OP_8F, this);
-    m_opcodeHandler[0x90] = std::bind(&CPULR35902::OP_90, this);
-    m_opcodeHandler[0x91] = std::bind(&CPULR35902::OP_91, this);
-    m_opcodeHandler[0x92] = std::bind(&CPULR35902::OP_92, this);
-    m_opcodeHandler[0x93] = std::bind(&CPULR35902::OP_93, this);
-    m_opcodeHandler[0x94] = std::bind(&CPULR35902::OP_94, this);
-    m_opcodeHandler[0x95] = std::bind(&CPULR35902::OP_95, this);
-    m_opcodeHandler[0x96] = std::bind(&CPULR35902::OP_96, this);
-    m_opcodeHandler[0x97] = std::bind(&CPULR35902::OP_97, this);
-    m_opcodeHandler[0x98] = std::bind(&CPULR35902::OP_98, this);
-    m_opcodeHandler[0x99] = std::bind(&CPULR35902::OP_99, this);
-    m_opcodeHandler[0x9A] = std::bind(&CPULR35902::OP_9A, this);
-    m_opcodeHandler[0x9B] = std::bind(&CPULR35902::OP_9B, this);
-    m_opcodeHandler[0x9C] = std::bind(&CPULR35902::OP_9C, this);
-    m_opcodeHandler[0x9D] = std::bind(&CPULR35902::OP_9D, this);
-    m_opcodeHandler[0x9E] = std::bind(&CPULR35902::OP_9E, this);
-    m_opcodeHandler[0x9F] = std::bind(&CPULR35902::OP_9F, this);
-    m_opcodeHandler[0xA0] = std::bind(&CPULR35902::OP_A0, this);
-    m_opcodeHandler[0xA1] = std::bind(&CPULR35902::OP_A1, this);
-    m_opcodeHandler[0xA2] = std::bind(&CPULR35902::OP_A2, this);
-    m_opcodeHandler[0xA3] = std::bind(&CPULR35902::OP_A3, this);
-    m_opcodeHandler[0xA4] = std::bind(&CPULR35902::OP_A4, this);
-    m_opcodeHandler[0xA5] = std::bind(&CPULR35902::OP_A5, this);
-    m_opcodeHandler[0xA6] = std::bind(&CPULR35902::OP_A6, this);
-    m_opcodeHandler[0xA7] = std::bind(&CPULR35902::OP_A7, this);
-    m_opcodeHandler[0xA8] = std::bind(&CPULR35902::OP_A8, this);
-    m_opcodeHandler[0xA9] = std::bind(&CPULR35902::OP_A9, this);
-    m_opcodeHandler[0xAA] = std::bind(&CPULR35902::OP_AA, this);
-    m_opcodeHandler[0xAB] = std::bind(&CPULR35902::OP_AB, this);
-    m_opcodeHandler[0xAC] = std::bind(&CPULR35902::OP_AC, this);
-    m_opcodeHandler[0xAD] = std::bind(&CPULR35902::OP_AD, this);
-    m_opcodeHandler[0xAE] = std::bind(&CPULR35902::OP_AE, this);
-    m_opcodeHandler[0xAF] = std::bind(&CPULR35902::OP_AF, this);
-    m_opcodeHandler[0xB0] = std::bind(&CPULR35902::OP_B0, this);
-    m_opcodeHandler[0xB1] = std::bind(&CPULR35902::OP_B1, this);
-    m_opcodeHandler[0xB2] = std::bind(&CPULR35902::OP_B2, this);
-    m_opcodeHandler[0xB3] = std::bind(&CPULR35902::OP_B3, this);
-    m_opcodeHandler[0xB4] = std::bind(&CPULR35902::OP_B4, this);
-    m_opcodeHandler[0xB5] = std::bind(&CPULR35902::OP_B5, this);
-    m_opcodeHandler[0xB6] = std::bind(&CPULR35902::OP_B6, this);
-    m_opcodeHandler[0xB7] = std::bind(&CPULR35902::OP_B7, this);
-    m_opcodeHandler[0xB8] = std::bind(&CPULR35902::OP_B8, this);
-    m_opcodeHandler[0xB9] = std::bind(&CPULR35902::OP_B9, this);
-    m_opcodeHandler[0xBA] = std::bind(&CPULR35902::OP_BA, this);
-    m_opcodeHandler[0xBB] = std::bind(&CPULR35902::OP_BB, this);
-    m_opcodeHandler[0xBC] = std::bind(&CPULR35902::OP_BC, this);
-    m_opcodeHandler[0xBD] = std::bind(&CPULR35902::OP_BD, this);
-    m_opcodeHandler[0xBE] = std::bind(&CPULR35902::OP_BE, this);
-    m_opcodeHandler[0xBF] = std::bind(&CPULR35902::OP_BF, this);
-    m_opcodeHandler[0xC0] = std::bind(&CPULR35902::OP_C0, this);
-    m_opcodeHandler[0xC1] = std::bind(&CPULR35902::OP_C1, this);
-    m_opcodeHandler[0xC2] = std::bind(&CPULR35902::OP_C2, this);
-    m_opcodeHandler[0xC3] = std::bind(&CPULR35902::OP_C3, this);
-    m_opcodeHandler[0xC4] = std::bind(&CPULR35902::OP_C4, this);
-    m_opcodeHandler[0xC5] = std::bind(&CPULR35902::OP_C5, this);
-    m_opcodeHandler[0xC6] = std::bind(&CPULR35902::OP_C6, this);
-    m_opcodeHandler[0xC7] = std::bind(&CPULR35902::OP_C7, this);
-    m_opcodeHandler[0xC8] = std::bind(&CPULR35902::OP_C8, this);
-    m_opcodeHandler[0xC9] = std::bind(&CPULR35902::OP_C9, this);
-    m_opcodeHandler[0xCA] = std::bind(&CPULR35902::OP_CA, this);
-    m_opcodeHandler[0xCB] = std::bind(&CPULR35902::OP_CB, this);
-    m_opcodeHandler[0xCC] = std::bind(&CPULR35902::OP_CC, this);
-    m_opcodeHandler[0xCD] = std::bind(&CPULR35902::OP_CD, this);
-    m_opcodeHandler[0xCE] = std::bind(&CPULR35902::OP_CE, this);
-    m_opcodeHandler[0xCF] = std::bind(&CPULR35902::OP_CF, this);
-    m_opcodeHandler[0xD0] = std::bind(&CPULR35902::OP_D0, this);
-    m_opcodeHandler[0xD1] = std::bind(&CPULR35902::OP_D1, this);
-    m_opcodeHandler[0xD2] = std::bind(&CPULR35902::OP_D2, this);
-    m_opcodeHandler[0xD3] = std::bind(&CPULR35902::OP_D3, this);
-    m_opcodeHandler[0xD4] = std::bind(&CPULR35902::OP_D4, this);
-    m_opcodeHandler[0xD5] = std::bind(&CPULR35902::OP_D5, this);
-    m_opcodeHandler[0xD6] = std::bind(&CPULR35902::OP_D6, this);
-    m_opcodeHandler[0xD7] = std::bind(&CPULR35902::OP_D7, this);
-    m_opcodeHandler[0xD8] = std::bind(&CPULR35902::OP_D8, this);
-    m_opcodeHandler[0xD9] = std::bind(&CPULR35902::OP_D9, this);
-    m_opcodeHandler[0xDA] = std::bind(&CPULR35902::OP_DA, this);
-    m_opcodeHandler[0xDB] = std::bind(&CPULR35902::OP_DB, this);
-    m_opcodeHandler[0xDC] = std::bind(&CPULR35902::OP_DC, this);
-    m_opcodeHandler[0xDD] = std::bind(&CPULR35902::OP_DD, this);
-    m_opcodeHandler[0xDE] = std::bind(&CPULR35902::OP_DE, this);
-    m_opcodeHandler[0xDF] = std::bind(&CPULR35902::OP_DF, this);
-    m_opcodeHandler[0xE0] = std::bind(&CPULR35902::OP_E0, this);
-    m_opcodeHandler[0xE1] = std::bind(&CPULR35902::OP_E1, this);
-    m_opcodeHandler[0xE2] = std::bind(&CPULR35902::OP_E2, this);
-    m_opcodeHandler[0xE3] = std::bind(&CPULR35902::OP_E3, this);
-    m_opcodeHandler[0xE4] = std::bind(&CPULR35902::OP_E4, this);
-    m_opcodeHandler[0xE5] = std::bind(&CPULR35902::OP_E5, this);
-    m_opcodeHandler[0xE6] = std::bind(&CPULR35902::OP_E6, this);
-    m_opcodeHandler[0xE7] = std::bind(&CPULR35902::OP_E7, this);
-    m_opcodeHandler[0xE8] = std::bind(&CPULR35902::OP_E8, this);
-    m_opcodeHandler[0xE9] = std::bind(&CPULR35902::OP_E9, this);
-    m_opcodeHandler[0xEA] = std::bind(&CPULR35902::OP_EA, this);
-    m_opcodeHandler[0xEB] = std::bind(&CPULR35902::OP_EB, this);
-    m_opcodeHandler[0xEC] = std::bind(&CPULR35902::OP_EC, this);
-    m_opcodeHandler[0xED] = std::bind(&CPULR35902::OP_ED, this);
-    m_opcodeHandler[0xEE] = std::bind(&CPULR35902::OP_EE, this);
-    m_opcodeHandler[0xEF] = std::bind(&CPULR35902::OP_EF, this);
-    m_opcodeHandler[0xF0] = std::bind(&CPULR35902::OP_F0, this);
-    m_opcodeHandler[0xF1] = std::bind(&CPULR35902::OP_F1, this);
-    m_opcodeHandler[0xF2] = std::bind(&CPULR35902::OP_F2, this);
-    m_opcodeHandler[0xF3] = std::bind(&CPULR35902::OP_F3, this);
-    m_opcodeHandler[0xF4] = std::bind(&CPULR35902::OP_F4, this);
-    m_opcodeHandler[0xF5] = std::bind(&CPULR35902::OP_F5, this);
-    m_opcodeHandler[0xF6] = std::bind(&CPULR35902::OP_F6, this);
-    m_opcodeHandler[0xF7] = std::bind(&CPULR35902::OP_F7, this);
-    m_opcodeHandler[0xF8] = std::bind(&CPULR35902::OP_F8, this);
-    m_opcodeHandler[0xF9] = std::bind(&CPULR35902::OP_F9, this);
-    m_opcodeHandler[0xFA] = std::bind(&CPULR35902::OP_FA, this);
-    m_opcodeHandler[0xFB] = std::bind(&CPULR35902::OP_FB, this);
-    m_opcodeHandler[0xFC] = std::bind(&CPULR35902::OP_FC, this);
-    m_opcodeHandler[0xFD] = std::bind(&CPULR35902::OP_FD, this);
-    m_opcodeHandler[0xFE] = std::bind(&CPULR35902::OP_FE, this);
-    m_opcodeHandler[0xFF] = std::bind(&CPULR35902::OP_FF, this);
+#ifdef TAMEBOY_SWITCH_DISPATCH
+// Dense switches over the opcode bodies; unlike the std::function tables these can be inlined
+template<bool Traced>
+void CPULR35902::dispatch(uint8_t opcode) {
+    switch (opcode) {
+        case 0x00: OP_00<Traced>(); break;
+        case 0x01: OP_01<Traced>(); break;
+        case 0x02: OP_02<Traced>(); break;
+        case 0x03: OP_03<Traced>(); break;
+        case 0x04: OP_04<Traced>(); break;
+        case 0x05: OP_05<Traced>(); break;
+        case 0x06: OP_06<Traced>(); break;
+        case 0x07: OP_07<Traced>(); break;
+        case 0x08: OP_08<Traced>(); break;
+        case 0x09: OP_09<Traced>(); break;
+        case 0x0A: OP_0A<Traced>(); break;
+        case 0x0B: OP_0B<Traced>(); break;
+        case 0x0C: OP_0C<Traced>(); break;
+        case 0x0D: OP_0D<Traced>(); break;
+        case 0x0E: OP_0E<Traced>(); break;
+        case 0x0F: OP_0F<Traced>(); break;
+        case 0x10: OP_10<Traced>(); break;
+        case 0x11: OP_11<Traced>(); break;
+        case 0x12: OP_12<Traced>(); break;
+        case 0x13: OP_13<Traced>(); break;
+        case 0x14: OP_14<Traced>(); break;
+        case 0x15: OP_15<Traced>(); break;
+        case 0x16: OP_16<Traced>(); break;
+        case 0x17: OP_17<Traced>(); break;
+        case 0x18: OP_18<Traced>(); break;
+        case 0x19: OP_19<Traced>(); break;
+        case 0x1A: OP_1A<Traced>(); break;
+        case 0x1B: OP_1B<Traced>(); break;
+        case 0x1C: OP_1C<Traced>(); break;
+        case 0x1D: OP_1D<Traced>(); break;
+        case 0x1E: OP_1E<Traced>(); break;
+        case 0x1F: OP_1F<Traced>(); break;
+        case 0x20: OP_20<Traced>(); break;
+        case 0x21: OP_21<Traced>(); break;
+        case 0x22: OP_22<Traced>(); break;
+        case 0x23: OP_23<Traced>(); break;
+        case 0x24: OP_24<Traced>(); break;
+        case 0x25: OP_25<Traced>(); break;
+        case 0x26: OP_26<Traced>(); break;
+        case 0x27: OP_27<Traced>(); break;
+        case 0x28: OP_28<Traced>(); break;
+        case 0x29: OP_29<Traced>(); break;
+        case 0x2A: OP_2A<Traced>(); break;
+        case 0x2B: OP_2B<Traced>(); break;
+        case 0x2C: OP_2C<Traced>(); break;
+        case 0x2D: OP_2D<Traced>(); break;
+        case 0x2E: OP_2E<Traced>(); break;
+        case 0x2F: OP_2F<Traced>(); break;
+        case 0x30: OP_30<Traced>(); break;
+        case 0x31: OP_31<Traced>(); break;
+        case 0x32: OP_32<Traced>(); break;
+        case 0x33: OP_33<Traced>(); break;
+        case 0x34: OP_34<Traced>(); break;
+        case 0x35: OP_35<Traced>(); break;
+        case 0x36: OP_36<Traced>(); break;
+        case 0x37: OP_37<Traced>(); break;
+        case 0x38: OP_38<Traced>(); break;
+        case 0x39: OP_39<Traced>(); break;
+        case 0x3A: OP_3A<Traced>(); break;
+        case 0x3B: OP_3B<Traced>(); break;
+        case 0x3C: OP_3C<Traced>(); break;
+        case 0x3D: OP_3D<Traced>(); break;
+        case 0x3E: OP_3E<Traced>(); break;
+        case 0x3F: OP_3F<Traced>(); break;
+        case 0x40: OP_40<Traced>(); break;
+        case 0x41: OP_41<Traced>(); break;
+        case 0x42: OP_42<Traced>(); break;
+        case 0x43: OP_43<Traced>(); break;
+        case 0x44: OP_44<Traced>(); break;
+        case 0x45: OP_45<Traced>(); break;
+        case 0x46: OP_46<Traced>(); break;
+        case 0x47: OP_47<Traced>(); break;
+        case 0x48: OP_48<Traced>(); break;
+        case 0x49: OP_49<Traced>(); break;
+        case 0x4A: OP_4A<Traced>(); break;
+        case 0x4B: OP_4B<Traced>(); break;
+        case 0x4C: OP_4C<Traced>(); break;
+        case 0x4D: OP_4D<Traced>(); break;
+        case 0x4E: OP_4E<Traced>(); break;
+        case 0x4F: OP_4F<Traced>(); break;
+        case 0x50: OP_50<Traced>(); break;
+        case 0x51: OP_51<Traced>(); break;
+        case 0x52: OP_52<Traced>(); break;
+        case 0x53: OP_53<Traced>(); break;
+        case 0x54: OP_54<Traced>(); break;
+        case 0x55: OP_55<Traced>(); break;
+        case 0x56: OP_56<Traced>(); break;
+        case 0x57: OP_57<Traced>(); break;
+        case 0x58: OP_58<Traced>(); break;
+        case 0x59: OP_59<Traced>(); break;
+        case 0x5A: OP_5A<Traced>(); break;
+        case 0x5B: OP_5B<Traced>(); break;
+        case 0x5C: OP_5C<Traced>(); break;
+        case 0x5D: OP_5D<Traced>(); break;
+        case 0x5E: OP_5E<Traced>(); break;
+        case 0x5F: OP_5F<Traced>(); break;
+        case 0x60: OP_60<Traced>(); break;
+        case 0x61: OP_61<Traced>(); break;
+        case 0x62: OP_62<Traced>(); break;
+        case 0x63: OP_63<Traced>(); break;
+        case 0x64: OP_64<Traced>(); break;
+        case 0x65: OP_65<Traced>(); break;
+        case 0x66: OP_66<Traced>(); break;
+        case 0x67: OP_67<Traced>(); break;
+        case 0x68: OP_68<Traced>(); break;
+        case 0x69: OP_69<Traced>(); break;
+        case 0x6A: OP_6A<Traced>(); break;
+        case 0x6B: OP_6B<Traced>(); break;
+        case 0x6C: OP_6C<Traced>(); break;
+        case 0x6D: OP_6D<Traced>(); break;
+        case 0x6E: OP_6E<Traced>(); break;
+        case 0x6F: OP_6F<Traced>(); break;
+        case 0x70: OP_70<Traced>(); break;
+        case 0x71: OP_71<Traced>(); break;
+        case 0x72: OP_72<Traced>(); break;
+        case 0x73: OP_73<Traced>(); break;
+        case 0x74: OP_74<Traced>(); break;
+        case 0x75: OP_75<Traced>(); break;
+        case 0x76: OP_76<Traced>(); break;
+        case 0x77: OP_77<Traced>(); break;
+        case 0x78: OP_78<Traced>(); break;
+        case 0x79: OP_79<Traced>(); break;
+        case 0x7A: OP_7A<Traced>(); break;
+        case 0x7B: OP_7B<Traced>(); break;
+        case 0x7C: OP_7C<Traced>(); break;
+        case 0x7D: OP_7D<Traced>(); break;
+        case 0x7E: OP_7E<Traced>(); break;
+        case 0x7F: OP_7F<Traced>(); break;
+        case 0x80: OP_80<Traced>(); break;
+        case 0x81: OP_81<Traced>(); break;
+        case 0x82: OP_82<Traced>(); break;
+        case 0x83: OP_83<Traced>(); break;
+        case 0x84: OP_84<Traced>(); break;
+        case 0x85: OP_85<Traced>(); break;
+        case 0x86: OP_86<Traced>(); break;
+        case 0x87: OP_87<Traced>(); break;
+        case 0x88: OP_88<Traced>(); break;
+        case 0x89: OP_89<Traced>(); break;
+        case 0x8A: OP_8A<Traced>(); break;
+        case 0x8B: OP_8B<Traced>(); break;
+        case 0x8C: OP_8C<Traced>(); break;
+        case 0x8D: OP_8D<Traced>(); break;
+        case 0x8E: OP_8E<Traced>(); break;
+        case 0x8F: OP_8F<Traced>(); break;
+        case 0x90: OP_90<Traced>(); break;
+        case 0x91: OP_91<Traced>(); break;
+        case 0x92: OP_92<Traced>(); break;
+        case 0x93: OP_93<Traced>(); break;
+        case 0x94: OP_94<Traced>(); break;
+        case 0x95: OP_95<Traced>(); break;
+        case 0x96: OP_96<Traced>(); break;
+        case 0x97: OP_97<Traced>(); break;
+        case 0x98: OP_98<Traced>(); break;
+        case 0x99: OP_99<Traced>(); break;
+        case 0x9A: OP_9A<Traced>(); break;
+        case 0x9B: OP_9B<Traced>(); break;
+        case 0x9C: OP_9C<Traced>(); break;
+        case 0x9D: OP_9D<Traced>(); break;
+        case 0x9E: OP_9E<Traced>(); break;
+        case 0x9F: OP_9F<Traced>(); break;
+        case 0xA0: OP_A0<Traced>(); break;
+        case 0xA1: OP_A1<Traced>(); break;
+        case 0xA2: OP_A2<Traced>(); break;
+        case 0xA3: OP_A3<Traced>(); break;
+        case 0xA4: OP_A4<Traced>(); break;
+        case 0xA5: OP_A5<Traced>(); break;
+        case 0xA6: OP_A6<Traced>(); break;
+        case 0xA7: OP_A7<Traced>(); break;
+        case 0xA8: OP_A8<Traced>(); break;
+        case 0xA9: OP_A9<Traced>(); break;
+        case 0xAA: OP_AA<Traced>(); break;
+        case 0xAB: OP_AB<Traced>(); break;
+        case 0xAC: OP_AC<Traced>(); break;
+        case 0xAD: OP_AD<Traced>(); break;
+        case 0xAE: OP_AE<Traced>(); break;
+        case 0xAF: OP_AF<Traced>(); break;
+        case 0xB0: OP_B0<Traced>(); break;
+        case 0xB1: OP_B1<Traced>(); break;
+        case 0xB2: OP_B2<Traced>(); break;
+        case 0xB3: OP_B3<Traced>(); break;
+        case 0xB4: OP_B4<Traced>(); break;
+        case 0xB5: OP_B5<Traced>(); break;
+        case 0xB6: OP_B6<Traced>(); break;
+        case 0xB7: OP_B7<Traced>(); break;
+        case 0xB8: OP_B8<Traced>(); break;
+        case 0xB9: OP_B9<Traced>(); break;
+        case 0xBA: OP_BA<Traced>(); break;
+        case 0xBB: OP_BB<Traced>(); break;
+        case 0xBC: OP_BC<Traced>(); break;
+        case 0xBD: OP_BD<Traced>(); break;
+        case 0xBE: OP_BE<Traced>(); break;
+        case 0xBF: OP_BF<Traced>(); break;
+        case 0xC0: OP_C0<Traced>(); break;
+        case 0xC1: OP_C1<Traced>(); break;
+        case 0xC2: OP_C2<Traced>(); break;
+        case 0xC3: OP_C3<Traced>(); break;
+        case 0xC4: OP_C4<Traced>(); break;
+        case 0xC5: OP_C5<Traced>(); break;
+        case 0xC6: OP_C6<Traced>(); break;
+        case 0xC7: OP_C7<Traced>(); break;
+        case 0xC8: OP_C8<Traced>(); break;
+        case 0xC9: OP_C9<Traced>(); break;
+        case 0xCA: OP_CA<Traced>(); break;
+        case 0xCB: OP_CB<Traced>(); break;
+        case 0xCC: OP_CC<Traced>(); break;
+        case 0xCD: OP_CD<Traced>(); break;
+        case 0xCE: OP_CE<Traced>(); break;
+        case 0xCF: OP_CF<Traced>(); break;
+        case 0xD0: OP_D0<Traced>(); break;
+        case 0xD1: OP_D1<Traced>(); break;
+        case 0xD2: OP_D2<Traced>(); break;
+        case 0xD3: OP_D3<Traced>(); break;
+        case 0xD4: OP_D4<Traced>(); break;
+        case 0xD5: OP_D5<Traced>(); break;
+        case 0xD6: OP_D6<Traced>(); break;
+        case 0xD7: OP_D7<Traced>(); break;
+        case 0xD8: OP_D8<Traced>(); break;
+        case 0xD9: OP_D9<Traced>(); break;
+        case 0xDA: OP_DA<Traced>(); break;
+        case 0xDB: OP_DB<Traced>(); break;
+        case 0xDC: OP_DC<Traced>(); break;
+        case 0xDD: OP_DD<Traced>(); break;
+        case 0xDE: OP_DE<Traced>(); break;
+        case 0xDF: OP_DF<Traced>(); break;
+        case 0xE0: OP_E0<Traced>(); break;
+        case 0xE1: OP_E1<Traced>(); break;
+        case 0xE2: OP_E2<Traced>(); break;
+        case 0xE3: OP_E3<Traced>(); break;
+        case 0xE4: OP_E4<Traced>(); break;
+        case 0xE5: OP_E5<Traced>(); break;
+        case 0xE6: OP_E6<Traced>(); break;
+        case 0xE7: OP_E7<Traced>(); break;
+        case 0xE8: OP_E8<Traced>(); break;
+        case 0xE9: OP_E9<Traced>(); break;
+        case 0xEA: OP_EA<Traced>(); break;
+        case 0xEB: OP_EB<Traced>(); break;
+        case 0xEC: OP_EC<Traced>(); break;
+        case 0xED: OP_ED<Traced>(); break;
+        case 0xEE: OP_EE<Traced>(); break;
+        case 0xEF: OP_EF<Traced>(); break;
+        case 0xF0: OP_F0<Traced>(); break;
+        case 0xF1: OP_F1<Traced>(); break;
+        case 0xF2: OP_F2<Traced>(); break;
+        case 0xF3: OP_F3<Traced>(); break;
+        case 0xF4: OP_F4<Traced>(); break;
+        case 0xF5: OP_F5<Traced>(); break;
+        case 0xF6: OP_F6<Traced>(); break;
+        case 0xF7: OP_F7<Traced>(); break;
+        case 0xF8: OP_F8<Traced>(); break;
+        case 0xF9: OP_F9<Traced>(); break;
+        case 0xFA: OP_FA<Traced>(); break;
+        case 0xFB: OP_FB<Traced>(); break;
+        case 0xFC: OP_FC<Traced>(); break;
+        case 0xFD: OP_FD<Traced>(); break;
+        case 0xFE: OP_FE<Traced>(); break;
+        case 0xFF: OP_FF<Traced>(); break;
+    }
+}
 
-    m_prefixHandler[0x00] = std::bind(&CPULR35902::PR_00, this);
-    m_prefixHandler[0x01] = std::bind(&CPULR35902::PR_01, this);
-    m_prefixHandler[0x02] = std::bind(&CPULR35902::PR_02, this);
-    m_prefixHandler[0x03] = std::bind(&CPULR35902::PR_03, this);
-    m_prefixHandler[0x04] = std::bind(&CPULR35902::PR_04, this);
-    m_prefixHandler[0x05] = std::bind(&CPULR35902::PR_05, this);
-    m_prefixHandler[0x06] = std::bind(&CPULR35902::PR_06, this);
-    m_prefixHandler[0x07] = std::bind(&CPULR35902::PR_07, this);
-    m_prefixHandler[0x08] = std::bind(&CPULR35902::PR_08, this);
-    m_prefixHandler[0x09] = std::bind(&CPULR35902::PR_09, this);
-    m_prefixHandler[0x0A] = std::bind(&CPULR35902::PR_0A, this);
-    m_prefixHandler[0x0B] = std::bind(&CPULR35902::PR_0B, this);
-    m_prefixHandler[0x0C] = std::bind(&CPULR35902::PR_0C, this);
-    m_prefixHandler[0x0D] = std::bind(&CPULR35902::PR_0D, this);
-    m_prefixHandler[0x0E] = std::bind(&CPULR35902::PR_0E, this);
-    m_prefixHandler[0x0F] = std::bind(&CPULR35902::PR_0F, this);
-    m_prefixHandler[0x10] = std::bind(&CPULR35902::PR_10, this);
-    m_prefixHandler[0x11] = std::bind(&CPULR35902::PR_11, this);
-    m_prefixHandler[0x12] = std::bind(&CPULR35902::PR_12, this);
-    m_prefixHandler[0x13] = std::bind(&CPULR35902::PR_13, this);
-    m_prefixHandler[0x14] = std::bind(&CPULR35902::PR_14, this);
-    m_prefixHandler[0x15] = std::bind(&CPULR35902::PR_15, this);
-    m_prefixHandler[0x16] = std::bind(&CPULR35902::PR_16, this);
-    m_prefixHandler[0x17] = std::bind(&CPULR35902::PR_17, this);
-    m_prefixHandler[0x18] = std::bind(&CPULR35902::PR_18, this);
-    m_prefixHandler[0x19] = std::bind(&CPULR35902::PR_19, this);
-    m_prefixHandler[0x1A] = std::bind(&CPULR35902::PR_1A, this);
-    m_prefixHandler[0x1B] = std::bind(&CPULR35902::PR_1B, this);
-    m_prefixHandler[0x1C] = std::bind(&CPULR35902::PR_1C, this);
-    m_prefixHandler[0x1D] = std::bind(&CPULR35902::PR_1D, this);
-    m_prefixHandler[0x1E] = std::bind(&CPULR35902::PR_1E, this);
-    m_prefixHandler[0x1F] = std::bind(&CPULR35902::PR_1F, this);
-    m_prefixHandler[0x20] = std::bind(&CPULR35902::PR_20, this);
-    m_prefixHandler[0x21] = std::bind(&CPULR35902::PR_21, this);
-    m_prefixHandler[0x22] = std::bind(&CPULR35902::PR_22, this);
-    m_prefixHandler[0x23] = std::bind(&CPULR35902::PR_23, this);
-    m_prefixHandler[0x24] = std::bind(&CPULR35902::PR_24, this);
-    m_prefixHandler[0x25] = std::bind(&CPULR35902::PR_25, this);
-    m_prefixHandler[0x26] = std::bind(&CPULR35902::PR_26, this);
-    m_prefixHandler[0x27] = std::bind(&CPULR35902::PR_27, this);
-    m_prefixHandler[0x28] = std::bind(&CPULR35902::PR_28, this);
-    m_prefixHandler[0x29] = std::bind(&CPULR35902::PR_29, this);
-    m_prefixHandler[0x2A] = std::bind(&CPULR35902::PR_2A, this);
-    m_prefixHandler[0x2B] = std::bind(&CPULR35902::PR_2B, this);
-    m_prefixHandler[0x2C] = std::bind(&CPULR35902::PR_2C, this);
-    m_prefixHandler[0x2D] = std::bind(&CPULR35902::PR_2D, this);
-    m_prefixHandler[0x2E] = std::bind(&CPULR35902::PR_2E, this);
-    m_prefixHandler[0x2F] = std::bind(&CPULR35902::PR_2F, this);
-    m_prefixHandler[0x30] = std::bind(&CPULR35902::PR_30, this);
-    m_prefixHandler[0x31] = std::bind(&CPULR35902::PR_31, this);
-    m_prefixHandler[0x32] = std::bind(&CPULR35902::PR_32, this);
-    m_prefixHandler[0x33] = std::bind(&CPULR35902::PR_33, this);
-    m_prefixHandler[0x34] = std::bind(&CPULR35902::PR_34, this);
-    m_prefixHandler[0x35] = std::bind(&CPULR35902::PR_35, this);
-    m_prefixHandler[0x36] = std::bind(&CPULR35902::PR_36, this);
-    m_prefixHandler[0x37] = std::bind(&CPULR35902::PR_37, this);
-    m_prefixHandler[0x38] = std::bind(&CPULR35902::PR_38, this);
-    m_prefixHandler[0x39] = std::bind(&CPULR35902::PR_39, this);
-    m_prefixHandler[0x3A] = std::bind(&CPULR35902::PR_3A, this);
-    m_prefixHandler[0x3B] = std::bind(&CPULR35902::PR_3B, this);
-    m_prefixHandler[0x3C] = std::bind(&CPULR35902::PR_3C, this);
-    m_prefixHandler[0x3D] = std::bind(&CPULR35902::PR_3D, this);
-    m_prefixHandler[0x3E] = std::bind(&CPULR35902::PR_3E, this);
-    m_prefixHandler[0x3F] = std::bind(&CPULR35902::PR_3F, this);
-    m_prefixHandler[0x40] = std::bind(&CPULR35902::PR_40, this);
-    m_prefixHandler[0x41] = std::bind(&CPULR35902::PR_41, this);
-    m_prefixHandler[0x42] = std::bind(&CPULR35902::PR_42, this);
-    m_prefixHandler[0x43] = std::bind(&CPULR35902::PR_43, this);
-    m_prefixHandler[0x44] = std::bind(&CPULR35902::PR_44, this);
-    m_prefixHandler[0x45] = std::bind(&CPULR35902::PR_45, this);
-    m_prefixHandler[0x46] = std::bind(&CPULR35902::PR_46, this);
-    m_prefixHandler[0x47] = std::bind(&CPULR35902::PR_47, this);
-    m_prefixHandler[0x48] = std::bind(&CPULR35902::PR_48, this);
-    m_prefixHandler[0x49] = std::bind(&CPULR35902::PR_49, this);
-    m_prefixHandler[0x4A] = std::bind(&CPULR35902::PR_4A, this);
-    m_prefixHandler[0x4B] = std::bind(&CPULR35902::PR_4B, this);
-    m_prefixHandler[0x4C] = std::bind(&CPULR35902::PR_4C, this);
-    m_prefixHandler[0x4D] = std::bind(&CPULR35902::PR_4D, this);
-    m_prefixHandler[0x4E] = std::bind(&CPULR35902::PR_4E, this);
-    m_prefixHandler[0x4F] = std::bind(&CPULR35902::PR_4F, this);
-    m_prefixHandler[0x50] = std::bind(&CPULR35902::PR_50, this);
-    m_prefixHandler[0x51] = std::bind(&CPULR35902::PR_51, this);
-    m_prefixHandler[0x52] = std::bind(&CPULR35902::PR_52, this);
-    m_prefixHandler[0x53] = std::bind(&CPULR35902::PR_53, this);
-    m_prefixHandler[0x54] = std::bind(&CPULR35902::PR_54, this);
-    m_prefixHandler[0x55] = std::bind(&CPULR35902::PR_55, this);
-    m_prefixHandler[0x56] = std::bind(&CPULR35902::PR_56, this);
-    m_prefixHandler[0x57] = std::bind(&CPULR35902::PR_57, this);
-    m_prefixHandler[0x58] = std::bind(&CPULR35902::PR_58, this);
-    m_prefixHandler[0x59] = std::bind(&CPULR35902::PR_59, this);
-    m_prefixHandler[0x5A] = std::bind(&CPULR35902::PR_5A, this);
-    m_prefixHandler[0x5B] = std::bind(&CPULR35902::PR_5B, this);
-    m_prefixHandler[0x5C] = std::bind(&CPULR35902::PR_5C, this);
-    m_prefixHandler[0x5D] = std::bind(&CPULR35902::PR_5D, this);
-    m_prefixHandler[0x5E] = std::bind(&CPULR35902::PR_5E, this);
-    m_prefixHandler[0x5F] = std::bind(&CPULR35902::PR_5F, this);
-    m_prefixHandler[0x60] = std::bind(&CPULR35902::PR_60, this);
-    m_prefixHandler[0x61] = std::bind(&CPULR35902::PR_61, this);
-    m_prefixHandler[0x62] = std::bind(&CPULR35902::PR_62, this);
-    m_prefixHandler[0x63] = std::bind(&CPULR35902::PR_63, this);
-    m_prefixHandler[0x64] = std::bind(&CPULR35902::PR_64, this);
-    m_prefixHandler[0x65] = std::bind(&CPULR35902::PR_65, this);
-    m_prefixHandler[0x66] = std::bind(&CPULR35902::PR_66, this);
-    m_prefixHandler[0x67] = std::bind(&CPULR35902::PR_67, this);
-    m_prefixHandler[0x68] = std::bind(&CPULR35902::PR_68, this);
-    m_prefixHandler[0x69] = std::bind(&CPULR35902::PR_69, this);
-    m_prefixHandler[0x6A] = std::bind(&CPULR35902::PR_6A, this);
-    m_prefixHandler[0x6B] = std::bind(&CPULR35902::PR_6B, this);
-    m_prefixHandler[0x6C] = std::bind(&CPULR35902::PR_6C, this);
-    m_prefixHandler[0x6D] = std::bind(&CPULR35902::PR_6D, this);
-    m_prefixHandler[0x6E] = std::bind(&CPULR35902::PR_6E, this);
-    m_prefixHandler[0x6F] = std::bind(&CPULR35902::PR_6F, this);
-    m_prefixHandler[0x70] = std::bind(&CPULR35902::PR_70, this);
-    m_prefixHandler[0x71] = std::bind(&CPULR35902::PR_71, this);
-    m_prefixHandler[0x72] = std::bind(&CPULR35902::PR_72, this);
-    m_prefixHandler[0x73] = std::bind(&CPULR35902::PR_73, this);
-    m_prefixHandler[0x74] = std::bind(&CPULR35902::PR_74, this);
-    m_prefixHandler[0x75] = std::bind(&CPULR35902::PR_75, this);
-    m_prefixHandler[0x76] = std::bind(&CPULR35902::PR_76, this);
-    m_prefixHandler[0x77] = std::bind(&CPULR35902::PR_77, this);
-    m_prefixHandler[0x78] = std::bind(&CPULR35902::PR_78, this);
-    m_prefixHandler[0x79] = std::bind(&CPULR35902::PR_79, this);
-    m_prefixHandler[0x7A] = std::bind(&CPULR35902::PR_7A, this);
-    m_prefixHandler[0x7B] = std::bind(&CPULR35902::PR_7B, this);
-    m_prefixHandler[0x7C] = std::bind(&CPULR35902::PR_7C, this);
-    m_prefixHandler[0x7D] = std::bind(&CPULR35902::PR_7D, this);
-    m_prefixHandler[0x7E] = std::bind(&CPULR35902::PR_7E, this);
-    m_prefixHandler[0x7F] = std::bind(&CPULR35902::PR_7F, this);
-    m_prefixHandler[0x80] = std::bind(&CPULR35902::PR_80, this);
-    m_prefixHandler[0x81] = std::bind(&CPULR35902::PR_81, this);
-    m_prefixHandler[0x82] = std::bind(&CPULR35902::PR_82, this);
-    m_prefixHandler[0x83] = std::bind(&CPULR35902::PR_83, this);
-    m_prefixHandler[0x84] = std::bind(&CPULR35902::PR_84, this);
-    m_prefixHandler[0x85] = std::bind(&CPULR35902::PR_85, this);
-    m_prefixHandler[0x86] = std::bind(&CPULR35902::PR_86, this);
-    m_prefixHandler[0x87] = std::bind(&CPULR35902::PR_87, this);
-    m_prefixHandler[0x88] = std::bind(&CPULR35902::PR_88, this);
-    m_prefixHandler[0x89] = std::bind(&CPULR35902::PR_89, this);
-    m_prefixHandler[0x8A] = std::bind(&CPULR35902::PR_8A, this);
-    m_prefixHandler[0x8B] = std::bind(&CPULR35902::PR_8B, this);
-    m_prefixHandler[0x8C] = std::bind(&CPULR35902::PR_8C, this);
-    m_prefixHandler[0x8D] = std::bind(&CPULR35902::PR_8D, this);
-    m_prefixHandler[0x8E] = std::bind(&CPULR35902::PR_8E, this);
-    m_prefixHandler[0x8F] = std::bind(&CPULR35902::PR_8F, this);
-    m_prefixHandler[0x90] = std::bind(&CPULR35902::PR_90, this);
-    m_prefixHandler[0x91] = std::bind(&CPULR35902::PR_91, this);
-    m_prefixHandler[0x92] = std::bind(&CPULR35902::PR_92, this);
-    m_prefixHandler[0x93] = std::bind(&CPULR35902::PR_93, this);
-    m_prefixHandler[0x94] = std::bind(&CPULR35902::PR_94, this);
-    m_prefixHandler[0x95] = std::bind(&CPULR35902::PR_95, this);
-    m_prefixHandler[0x96] = std::bind(&CPULR35902::PR_96, this);
-    m_prefixHandler[0x97] = std::bind(&CPULR35902::PR_97, this);
-    m_prefixHandler[0x98] = std::bind(&CPULR35902::PR_98, this);
-    m_prefixHandler[0x99] = std::bind(&CPULR35902::PR_99, this);
-    m_prefixHandler[0x9A] = std::bind(&CPULR35902::PR_9A, this);
-    m_prefixHandler[0x9B] = std::bind(&CPULR35902::PR_9B, this);
-    m_prefixHandler[0x9C] = std::bind(&CPULR35902::PR_9C, this);
-    m_prefixHandler[0x9D] = std::bind(&CPULR35902::PR_9D, this);
-    m_prefixHandler[0x9E] = std::bind(&CPULR35902::PR_9E, this);
-    m_prefixHandler[0x9F] = std::bind(&CPULR35902::PR_9F, this);
-    m_prefixHandler[0xA0] = std::bind(&CPULR35902::PR_A0, this);
-    m_prefixHandler[0xA1] = std::bind(&CPULR35902::PR_A1, this);
-    m_prefixHandler[0xA2] = std::bind(&CPULR35902::PR_A2, this);
-    m_prefixHandler[0xA3] = std::bind(&CPULR35902::PR_A3, this);
-    m_prefixHandler[0xA4] = std::bind(&CPULR35902::PR_A4, this);
-    m_prefixHandler[0xA5] = std::bind(&CPULR35902::PR_A5, this);
-    m_prefixHandler[0xA6] = std::bind(&CPULR35902::PR_A6, this);
-    m_prefixHandler[0xA7] = std::bind(&CPULR35902::PR_A7, this);
-    m_prefixHandler[0xA8] = std::bind(&CPULR35902::PR_A8, this);
-    m_prefixHandler[0xA9] = std::bind(&CPULR35902::PR_A9, this);
-    m_prefixHandler[0xAA] = std::bind(&CPULR35902::PR_AA, this);
-    m_prefixHandler[0xAB] = std::bind(&CPULR35902::PR_AB, this);
-    m_prefixHandler[0xAC] = std::bind(&CPULR35902::PR_AC, this);
-    m_prefixHandler[0xAD] = std::bind(&CPULR35902::PR_AD, this);
-    m_prefixHandler[0xAE] = std::bind(&CPULR35902::PR_AE, this);
-    m_prefixHandler[0xAF] = std::bind(&CPULR35902::PR_AF, this);
-    m_prefixHandler[0xB0] = std::bind(&CPULR35902::PR_B0, this);
-    m_prefixHandler[0xB1] = std::bind(&CPULR35902::PR_B1, this);
-    m_prefixHandler[0xB2] = std::bind(&CPULR35902::PR_B2, this);
-    m_prefixHandler[0xB3] = std::bind(&CPULR35902::PR_B3, this);
-    m_prefixHandler[0xB4] = std::bind(&CPULR35902::PR_B4, this);
-    m_prefixHandler[0xB5] = std::bind(&CPULR35902::PR_B5, this);
-    m_prefixHandler[0xB6] = std::bind(&CPULR35902::PR_B6, this);
-    m_prefixHandler[0xB7] = std::bind(&CPULR35902::PR_B7, this);
-    m_prefixHandler[0xB8] = std::bind(&CPULR35902::PR_B8, this);
-    m_prefixHandler[0xB9] = std::bind(&CPULR35902::PR_B9, this);
-    m_prefixHandler[0xBA] = std::bind(&CPULR35902::PR_BA, this);
-    m_prefixHandler[0xBB] = std::bind(&CPULR35902::PR_BB, this);
-    m_prefixHandler[0xBC] = std::bind(&CPULR35902::PR_BC, this);
-    m_prefixHandler[0xBD] = std::bind(&CPULR35902::PR_BD, this);
-    m_prefixHandler[0xBE] = std::bind(&CPULR35902::PR_BE, this);
-    m_prefixHandler[0xBF] = std::bind(&CPULR35902::PR_BF, this);
-    m_prefixHandler[0xC0] = std::bind(&CPULR35902::PR_C0, this);
-    m_prefixHandler[0xC1] = std::bind(&CPULR35902::PR_C1, this);
-    m_prefixHandler[0xC2] = std::bind(&CPULR35902::PR_C2, this);
-    m_prefixHandler[0xC3] = std::bind(&CPULR35902::PR_C3, this);
-    m_prefixHandler[0xC4] = std::bind(&CPULR35902::PR_C4, this);
-    m_prefixHandler[0xC5] = std::bind(&CPULR35902::PR_C5, this);
-    m_prefixHandler[0xC6] = std::bind(&CPULR35902::PR_C6, this);
-    m_prefixHandler[0xC7] = std::bind(&CPULR35902::PR_C7, this);
-    m_prefixHandler[0xC8] = std::bind(&CPULR35902::PR_C8, this);
-    m_prefixHandler[0xC9] = std::bind(&CPULR35902::PR_C9, this);
-    m_prefixHandler[0xCA] = std::bind(&CPULR35902::PR_CA, this);
-    m_prefixHandler[0xCB] = std::bind(&CPULR35902::PR_CB, this);
-    m_prefixHandler[0xCC] = std::bind(&CPULR35902::PR_CC, this);
-    m_prefixHandler[0xCD] = std::bind(&CPULR35902::PR_CD, this);
-    m_prefixHandler[0xCE] = std::bind(&CPULR35902::PR_CE, this);
-    m_prefixHandler[0xCF] = std::bind(&CPULR35902::PR_CF, this);
-    m_prefixHandler[0xD0] = std::bind(&CPULR35902::PR_D0, this);
-    m_prefixHandler[0xD1] = std::bind(&CPULR35902::PR_D1, this);
-    m_prefixHandler[0xD2] = std::bind(&CPULR35902::PR_D2, this);
-    m_prefixHandler[0xD3] = std::bind(&CPULR35902::PR_D3, this);
-    m_prefixHandler[0xD4] = std::bind(&CPULR35902::PR_D4, this);
-    m_prefixHandler[0xD5] = std::bind(&CPULR35902::PR_D5, this);
-    m_prefixHandler[0xD6] = std::bind(&CPULR35902::PR_D6, this);
-    m_prefixHandler[0xD7] = std::bind(&CPULR35902::PR_D7, this);
-    m_prefixHandler[0xD8] = std::bind(&CPULR35902::PR_D8, this);
-    m_prefixHandler[0xD9] = std::bind(&CPULR35902::PR_D9, this);
-    m_prefixHandler[0xDA] = std::bind(&CPULR35902::PR_DA, this);
-    m_prefixHandler[0xDB] = std::bind(&CPULR35902::PR_DB, this);
-    m_prefixHandler[0xDC] = std::bind(&CPULR35902::PR_DC, this);
-    m_prefixHandler[0xDD] = std::bind(&CPULR35902::PR_DD, this);
-    m_prefixHandler[0xDE] = std::bind(&CPULR35902::PR_DE, this);
-    m_prefixHandler[0xDF] = std::bind(&CPULR35902::PR_DF, this);
-    m_prefixHandler[0xE0] = std::bind(&CPULR35902::PR_E0, this);
-    m_prefixHandler[0xE1] = std::bind(&CPULR35902::PR_E1, this);
-    m_prefixHandler[0xE2] = std::bind(&CPULR35902::PR_E2, this);
-    m_prefixHandler[0xE3] = std::bind(&CPULR35902::PR_E3, this);
-    m_prefixHandler[0xE4] = std::bind(&CPULR35902::PR_E4, this);
-    m_prefixHandler[0xE5] = std::bind(&CPULR35902::PR_E5, this);
-    m_prefixHandler[0xE6] = std::bind(&CPULR35902::PR_E6, this);
-    m_prefixHandler[0xE7] = std::bind(&CPULR35902::PR_E7, this);
-    m_prefixHandler[0xE8] = std::bind(&CPULR35902::PR_E8, this);
-    m_prefixHandler[0xE9] = std::bind(&CPULR35902::PR_E9, this);
-    m_prefixHandler[0xEA] = std::bind(&CPULR35902::PR_EA, this);
-    m_prefixHandler[0xEB] = std::bind(&CPULR35902::PR_EB, this);
-    m_prefixHandler[0xEC] = std::bind(&CPULR35902::PR_EC, this);
-    m_prefixHandler[0xED] = std::bind(&CPULR35902::PR_ED, this);
-    m_prefixHandler[0xEE] = std::bind(&CPULR35902::PR_EE, this);
-    m_prefixHandler[0xEF] = std::bind(&CPULR35902::PR_EF, this);
-    m_prefixHandler[0xF0] = std::bind(&CPULR35902::PR_F0, this);
-    m_prefixHandler[0xF1] = std::bind(&CPULR35902::PR_F1, this);
-    m_prefixHandler[0xF2] = std::bind(&CPULR35902::PR_F2, this);
-    m_prefixHandler[0xF3] = std::bind(&CPULR35902::PR_F3, this);
-    m_prefixHandler[0xF4] = std::bind(&CPULR35902::PR_F4, this);
-    m_prefixHandler[0xF5] = std::bind(&CPULR35902::PR_F5, this);
-    m_prefixHandler[0xF6] = std::bind(&CPULR35902::PR_F6, this);
-    m_prefixHandler[0xF7] = std::bind(&CPULR35902::PR_F7, this);
-    m_prefixHandler[0xF8] = std::bind(&CPULR35902::PR_F8, this);
-    m_prefixHandler[0xF9] = std::bind(&CPULR35902::PR_F9, this);
-    m_prefixHandler[0xFA] = std::bind(&CPULR35902::PR_FA, this);
-    m_prefixHandler[0xFB] = std::bind(&CPULR35902::PR_FB, this);
-    m_prefixHandler[0xFC] = std::bind(&CPULR35902::PR_FC, this);
-    m_prefixHandler[0xFD] = std::bind(&CPULR35902::PR_FD, this);
-    m_prefixHandler[0xFE] = std::bind(&CPULR35902::PR_FE, this);
-    m_prefixHandler[0xFF] = std::bind(&CPULR35902::PR_FF, this);
+template<bool Traced>
+void CPULR35902::dispatchPrefix(uint8_t opcode) {
+    switch (opcode) {
+        case 0x00: PR_00<Traced>(); break;
+        case 0x01: PR_01<Traced>(); break;
+        case 0x02: PR_02<Traced>(); break;
+        case 0x03: PR_03<Traced>(); break;
+        case 0x04: PR_04<Traced>(); break;
+        case 0x05: PR_05<Traced>(); break;
+        case 0x06: PR_06<Traced>(); break;
+        case 0x07: PR_07<Traced>(); break;
+        case 0x08: PR_08<Traced>(); break;
+        case 0x09: PR_09<Traced>(); break;
+        case 0x0A: PR_0A<Traced>(); break;
+        case 0x0B: PR_0B<Traced>(); break;
+        case 0x0C: PR_0C<Traced>(); break;
+        case 0x0D: PR_0D<Traced>(); break;
+        case 0x0E: PR_0E<Traced>(); break;
+        case 0x0F: PR_0F<Traced>(); break;
+        case 0x10: PR_10<Traced>(); break;
+        case 0x11: PR_11<Traced>(); break;
+        case 0x12: PR_12<Traced>(); break;
+        case 0x13: PR_13<Traced>(); break;
+        case 0x14: PR_14<Traced>(); break;
+        case 0x15: PR_15<Traced>(); break;
+        case 0x16: PR_16<Traced>(); break;
+        case 0x17: PR_17<Traced>(); break;
+        case 0x18: PR_18<Traced>(); break;
+        case 0x19: PR_19<Traced>(); break;
+        case 0x1A: PR_1A<Traced>(); break;
+        case 0x1B: PR_1B<Traced>(); break;
+        case 0x1C: PR_1C<Traced>(); break;
+        case 0x1D: PR_1D<Traced>(); break;
+        case 0x1E: PR_1E<Traced>(); break;
+        case 0x1F: PR_1F<Traced>(); break;
+        case 0x20: PR_20<Traced>(); break;
+        case 0x21: PR_21<Traced>(); break;
+        case 0x22: PR_22<Traced>(); break;
+        case 0x23: PR_23<Traced>(); break;
+        case 0x24: PR_24<Traced>(); break;
+        case 0x25: PR_25<Traced>(); break;
+        case 0x26: PR_26<Traced>(); break;
+        case 0x27: PR_27<Traced>(); break;
+        case 0x28: PR_28<Traced>(); break;
+        case 0x29: PR_29<Traced>(); break;
+        case 0x2A: PR_2A<Traced>(); break;
+        case 0x2B: PR_2B<Traced>(); break;
+        case 0x2C: PR_2C<Traced>(); break;
+        case 0x2D: PR_2D<Traced>(); break;
+        case 0x2E: PR_2E<Traced>(); break;
+        case 0x2F: PR_2F<Traced>(); break;
+        case 0x30: PR_30<Traced>(); break;
+        case 0x31: PR_31<Traced>(); break;
+        case 0x32: PR_32<Traced>(); break;
+        case 0x33: PR_33<Traced>(); break;
+        case 0x34: PR_34<Traced>(); break;
+        case 0x35: PR_35<Traced>(); break;
+        case 0x36: PR_36<Traced>(); break;
+        case 0x37: PR_37<Traced>(); break;
+        case 0x38: PR_38<Traced>(); break;
+        case 0x39: PR_39<Traced>(); break;
+        case 0x3A: PR_3A<Traced>(); break;
+        case 0x3B: PR_3B<Traced>(); break;
+        case 0x3C: PR_3C<Traced>(); break;
+        case 0x3D: PR_3D<Traced>(); break;
+        case 0x3E: PR_3E<Traced>(); break;
+        case 0x3F: PR_3F<Traced>(); break;
+        case 0x40: PR_40<Traced>(); break;
+        case 0x41: PR_41<Traced>(); break;
+        case 0x42: PR_42<Traced>(); break;
+        case 0x43: PR_43<Traced>(); break;
+        case 0x44: PR_44<Traced>(); break;
+        case 0x45: PR_45<Traced>(); break;
+        case 0x46: PR_46<Traced>(); break;
+        case 0x47: PR_47<Traced>(); break;
+        case 0x48: PR_48<Traced>(); break;
+        case 0x49: PR_49<Traced>(); break;
+        case 0x4A: PR_4A<Traced>(); break;
+        case 0x4B: PR_4B<Traced>(); break;
+        case 0x4C: PR_4C<Traced>(); break;
+        case 0x4D: PR_4D<Traced>(); break;
+        case 0x4E: PR_4E<Traced>(); break;
+        case 0x4F: PR_4F<Traced>(); break;
+        case 0x50: PR_50<Traced>(); break;
+        case 0x51: PR_51<Traced>(); break;
+        case 0x52: PR_52<Traced>(); break;
+        case 0x53: PR_53<Traced>(); break;
+        case 0x54: PR_54<Traced>(); break;
+        case 0x55: PR_55<Traced>(); break;
+        case 0x56: PR_56<Traced>(); break;
+        case 0x57: PR_57<Traced>(); break;
+        case 0x58: PR_58<Traced>(); break;
+        case 0x59: PR_59<Traced>(); break;
+        case 0x5A: PR_5A<Traced>(); break;
+        case 0x5B: PR_5B<Traced>(); break;
+        case 0x5C: PR_5C<Traced>(); break;
+        case 0x5D: PR_5D<Traced>(); break;
+        case 0x5E: PR_5E<Traced>(); break;
+        case 0x5F: PR_5F<Traced>(); break;
+        case 0x60: PR_60<Traced>(); break;
+        case 0x61: PR_61<Traced>(); break;
+        case 0x62: PR_62<Traced>(); break;
+        case 0x63: PR_63<Traced>(); break;
+        case 0x64: PR_64<Traced>(); break;
+        case 0x65: PR_65<Traced>(); break;
+        case 0x66: PR_66<Traced>(); break;
+        case 0x67: PR_67<Traced>(); break;
+        case 0x68: PR_68<Traced>(); break;
+        case 0x69: PR_69<Traced>(); break;
+        case 0x6A: PR_6A<Traced>(); break;
+        case 0x6B: PR_6B<Traced>(); break;
+        case 0x6C: PR_6C<Traced>(); break;
+        case 0x6D: PR_6D<Traced>(); break;
+        case 0x6E: PR_6E<Traced>(); break;
+        case 0x6F: PR_6F<Traced>(); break;
+        case 0x70: PR_70<Traced>(); break;
+        case 0x71: PR_71<Traced>(); break;
+        case 0x72: PR_72<Traced>(); break;
+        case 0x73: PR_73<Traced>(); break;
+        case 0x74: PR_74<Traced>(); break;
+        case 0x75: PR_75<Traced>(); break;
+        case 0x76: PR_76<Traced>(); break;
+        case 0x77: PR_77<Traced>(); break;
+        case 0x78: PR_78<Traced>(); break;
+        case 0x79: PR_79<Traced>(); break;
+        case 0x7A: PR_7A<Traced>(); break;
+        case 0x7B: PR_7B<Traced>(); break;
+        case 0x7C: PR_7C<Traced>(); break;
+        case 0x7D: PR_7D<Traced>(); break;
+        case 0x7E: PR_7E<Traced>(); break;
+        case 0x7F: PR_7F<Traced>(); break;
+        case 0x80: PR_80<Traced>(); break;
+        case 0x81: PR_81<Traced>(); break;
+        case 0x82: PR_82<Traced>(); break;
+        case 0x83: PR_83<Traced>(); break;
+        case 0x84: PR_84<Traced>(); break;
+        case 0x85: PR_85<Traced>(); break;
+        case 0x86: PR_86<Traced>(); break;
+        case 0x87: PR_87<Traced>(); break;
+        case 0x88: PR_88<Traced>(); break;
+        case 0x89: PR_89<Traced>(); break;
+        case 0x8A: PR_8A<Traced>(); break;
+        case 0x8B: PR_8B<Traced>(); break;
+        case 0x8C: PR_8C<Traced>(); break;
+        case 0x8D: PR_8D<Traced>(); break;
+        case 0x8E: PR_8E<Traced>(); break;
+        case 0x8F: PR_8F<Traced>(); break;
+        case 0x90: PR_90<Traced>(); break;
+        case 0x91: PR_91<Traced>(); break;
+        case 0x92: PR_92<Traced>(); break;
+        case 0x93: PR_93<Traced>(); break;
+        case 0x94: PR_94<Traced>(); break;
+        case 0x95: PR_95<Traced>(); break;
+        case 0x96: PR_96<Traced>(); break;
+        case 0x97: PR_97<Traced>(); break;
+        case 0x98: PR_98<Traced>(); break;
+        case 0x99: PR_99<Traced>(); break;
+        case 0x9A: PR_9A<Traced>(); break;
+        case 0x9B: PR_9B<Traced>(); break;
+        case 0x9C: PR_9C<Traced>(); break;
+        case 0x9D: PR_9D<Traced>(); break;
+        case 0x9E: PR_9E<Traced>(); break;
+        case 0x9F: PR_9F<Traced>(); break;
+        case 0xA0: PR_A0<Traced>(); break;
+        case 0xA1: PR_A1<Traced>(); break;
+        case 0xA2: PR_A2<Traced>(); break;
+        case 0xA3: PR_A3<Traced>(); break;
+        case 0xA4: PR_A4<Traced>(); break;
+        case 0xA5: PR_A5<Traced>(); break;
+        case 0xA6: PR_A6<Traced>(); break;
+        case 0xA7: PR_A7<Traced>(); break;
+        case 0xA8: PR_A8<Traced>(); break;
+        case 0xA9: PR_A9<Traced>(); break;
+        case 0xAA: PR_AA<Traced>(); break;
+        case 0xAB: PR_AB<Traced>(); break;
+        case 0xAC: PR_AC<Traced>(); break;
+        case 0xAD: PR_AD<Traced>(); break;
+        case 0xAE: PR_AE<Traced>(); break;
+        case 0xAF: PR_AF<Traced>(); break;
+        case 0xB0: PR_B0<Traced>(); break;
+        case 0xB1: PR_B1<Traced>(); break;
+        case 0xB2: PR_B2<Traced>(); break;
+        case 0xB3: PR_B3<Traced>(); break;
+        case 0xB4: PR_B4<Traced>(); break;
+        case 0xB5: PR_B5<Traced>(); break;
+        case 0xB6: PR_B6<Traced>(); break;
+        case 0xB7: PR_B7<Traced>(); break;
+        case 0xB8: PR_B8<Traced>(); break;
+        case 0xB9: PR_B9<Traced>(); break;
+        case 0xBA: PR_BA<Traced>(); break;
+        case 0xBB: PR_BB<Traced>(); break;
+        case 0xBC: PR_BC<Traced>(); break;
+        case 0xBD: PR_BD<Traced>(); break;
+        case 0xBE: PR_BE<Traced>(); break;
+        case 0xBF: PR_BF<Traced>(); break;
+        case 0xC0: PR_C0<Traced>(); break;
+        case 0xC1: PR_C1<Traced>(); break;
+        case 0xC2: PR_C2<Traced>(); break;
+        case 0xC3: PR_C3<Traced>(); break;
+        case 0xC4: PR_C4<Traced>(); break;
+        case 0xC5: PR_C5<Traced>(); break;
+        case 0xC6: PR_C6<Traced>(); break;
+        case 0xC7: PR_C7<Traced>(); break;
+        case 0xC8: PR_C8<Traced>(); break;
+        case 0xC9: PR_C9<Traced>(); break;
+        case 0xCA: PR_CA<Traced>(); break;
+        case 0xCB: PR_CB<Traced>(); break;
+        case 0xCC: PR_CC<Traced>(); break;
+        case 0xCD: PR_CD<Traced>(); break;
+        case 0xCE: PR_CE<Traced>(); break;
+        case 0xCF: PR_CF<Traced>(); break;
+        case 0xD0: PR_D0<Traced>(); break;
+        case 0xD1: PR_D1<Traced>(); break;
+        case 0xD2: PR_D2<Traced>(); break;
+        case 0xD3: PR_D3<Traced>(); break;
+        case 0xD4: PR_D4<Traced>(); break;
+        case 0xD5: PR_D5<Traced>(); break;
+        case 0xD6: PR_D6<Traced>(); break;
+        case 0xD7: PR_D7<Traced>(); break;
+        case 0xD8: PR_D8<Traced>(); break;
+        case 0xD9: PR_D9<Traced>(); break;
+        case 0xDA: PR_DA<Traced>(); break;
+        case 0xDB: PR_DB<Traced>(); break;
+        case 0xDC: PR_DC<Traced>(); break;
+        case 0xDD: PR_DD<Traced>(); break;
+        case 0xDE: PR_DE<Traced>(); break;
+        case 0xDF: PR_DF<Traced>(); break;
+        case 0xE0: PR_E0<Traced>(); break;
+        case 0xE1: PR_E1<Traced>(); break;
+        case 0xE2: PR_E2<Traced>(); break;
+        case 0xE3: PR_E3<Traced>(); break;
+        case 0xE4: PR_E4<Traced>(); break;
+        case 0xE5: PR_E5<Traced>(); break;
+        case 0xE6: PR_E6<Traced>(); break;
+        case 0xE7: PR_E7<Traced>(); break;
+        case 0xE8: PR_E8<Traced>(); break;
+        case 0xE9: PR_E9<Traced>(); break;
+        case 0xEA: PR_EA<Traced>(); break;
+        case 0xEB: PR_EB<Traced>(); break;
+        case 0xEC: PR_EC<Traced>(); break;
+        case 0xED: PR_ED<Traced>(); break;
+        case 0xEE: PR_EE<Traced>(); break;
+        case 0xEF: PR_EF<Traced>(); break;
+        case 0xF0: PR_F0<Traced>(); break;
+        case 0xF1: PR_F1<Traced>(); break;
+        case 0xF2: PR_F2<Traced>(); break;
+        case 0xF3: PR_F3<Traced>(); break;
+        case 0xF4: PR_F4<Traced>(); break;
+        case 0xF5: PR_F5<Traced>(); break;
+        case 0xF6: PR_F6<Traced>(); break;
+        case 0xF7: PR_F7<Traced>(); break;
+        case 0xF8: PR_F8<Traced>(); break;
+        case 0xF9: PR_F9<Traced>(); break;
+        case 0xFA: PR_FA<Traced>(); break;
+        case 0xFB: PR_FB<Traced>(); break;
+        case 0xFC: PR_FC<Traced>(); break;
+        case 0xFD: PR_FD<Traced>(); break;
+        case 0xFE: PR_FE<Traced>(); break;
+        case 0xFF: PR_FF<Traced>(); break;
+    }
 }
+#else
+template<bool Traced>
+void CPULR35902::initOpcodeHandlers(HandlerTable& opcodeHandler, HandlerTable& prefixHandler) {
+    opcodeHandler[0x00] = std::bind(&CPULR35902::OP_00<Traced>, this);
+    opcodeHandler[0x01] = std::bind(&CPULR35902::OP_01<Traced>, this);
+    opcodeHandler[0x02] = std::bind(&CPULR35902::OP_02<Traced>, this);
+    opcodeHandler[0x03] = std::bind(&CPULR35902::OP_03<Traced>, this);
+    opcodeHandler[0x04] = std::bind(&CPULR35902::OP_04<Traced>, this);
+    opcodeHandler[0x05] = std::bind(&CPULR35902::OP_05<Traced>, this);
+    opcodeHandler[0x06] = std::bind(&CPULR35902::OP_06<Traced>, this);
+    opcodeHandler[0x07] = std::bind(&CPULR35902::OP_07<Traced>, this);
+    opcodeHandler[0x08] = std::bind(&CPULR35902::OP_08<Traced>, this);
+    opcodeHandler[0x09] = std::bind(&CPULR35902::OP_09<Traced>, this);
+    opcodeHandler[0x0A] = std::bind(&CPULR35902::OP_0A<Traced>, this);
+    opcodeHandler[0x0B] = std::bind(&CPULR35902::OP_0B<Traced>, this);
+    opcodeHandler[0x0C] = std::bind(&CPULR35902::OP_0C<Traced>, this);
+    opcodeHandler[0x0D] = std::bind(&CPULR35902::OP_0D<Traced>, this);
+    opcodeHandler[0x0E] = std::bind(&CPULR35902::OP_0E<Traced>, this);
+    opcodeHandler[0x0F] = std::bind(&CPULR35902::OP_0F<Traced>, this);
+    opcodeHandler[0x10] = std::bind(&CPULR35902::OP_10<Traced>, this);
+    opcodeHandler[0x11] = std::bind(&CPULR35902::OP_11<Traced>, this);
+    opcodeHandler[0x12] = std::bind(&CPULR35902::OP_12<Traced>, this);
+    opcodeHandler[0x13] = std::bind(&CPULR35902::OP_13<Traced>, this);
+    opcodeHandler[0x14] = std::bind(&CPULR35902::OP_14<Traced>, this);
+    opcodeHandler[0x15] = std::bind(&CPULR35902::OP_15<Traced>, this);
+    opcodeHandler[0x16] = std::bind(&CPULR35902::OP_16<Traced>, this);
+    opcodeHandler[0x17] = std::bind(&CPULR35902::OP_17<Traced>, this);
+    opcodeHandler[0x18] = std::bind(&CPULR35902::OP_18<Traced>, this);
+    opcodeHandler[0x19] = std::bind(&CPULR35902::OP_19<Traced>, this);
+    opcodeHandler[0x1A] = std::bind(&CPULR35902::OP_1A<Traced>, this);
+    opcodeHandler[0x1B] = std::bind(&CPULR35902::OP_1B<Traced>, this);
+    opcodeHandler[0x1C] = std::bind(&CPULR35902::OP_1C<Traced>, this);
+    opcodeHandler[0x1D] = std::bind(&CPULR35902::OP_1D<Traced>, this);
+    opcodeHandler[0x1E] = std::bind(&CPULR35902::OP_1E<Traced>, this);
+    opcodeHandler[0x1F] = std::bind(&CPULR35902::OP_1F<Traced>, this);
+    opcodeHandler[0x20] = std::bind(&CPULR35902::OP_20<Traced>, this);
+    opcodeHandler[0x21] = std::bind(&CPULR35902::OP_21<Traced>, this);
+    opcodeHandler[0x22] = std::bind(&CPULR35902::OP_22<Traced>, this);
+    opcodeHandler[0x23] = std::bind(&CPULR35902::OP_23<Traced>, this);
+    opcodeHandler[0x24] = std::bind(&CPULR35902::OP_24<Traced>, this);
+    opcodeHandler[0x25] = std::bind(&CPULR35902::OP_25<Traced>, this);
+    opcodeHandler[0x26] = std::bind(&CPULR35902::OP_26<Traced>, this);
+    opcodeHandler[0x27] = std::bind(&CPULR35902::OP_27<Traced>, this);
+    opcodeHandler[0x28] = std::bind(&CPULR35902::OP_28<Traced>, this);
+    opcodeHandler[0x29] = std::bind(&CPULR35902::OP_29<Traced>, this);
+    opcodeHandler[0x2A] = std::bind(&CPULR35902::OP_2A<Traced>, this);
+    opcodeHandler[0x2B] = std::bind(&CPULR35902::OP_2B<Traced>, this);
+    opcodeHandler[0x2C] = std::bind(&CPULR35902::OP_2C<Traced>, this);
+    opcodeHandler[0x2D] = std::bind(&CPULR35902::OP_2D<Traced>, this);
+    opcodeHandler[0x2E] = std::bind(&CPULR35902::OP_2E<Traced>, this);
+    opcodeHandler[0x2F] = std::bind(&CPULR35902::OP_2F<Traced>, this);
+    opcodeHandler[0x30] = std::bind(&CPULR35902::OP_30<Traced>, this);
+    opcodeHandler[0x31] = std::bind(&CPULR35902::OP_31<Traced>, this);
+    opcodeHandler[0x32] = std::bind(&CPULR35902::OP_32<Traced>, this);
+    opcodeHandler[0x33] = std::bind(&CPULR35902::OP_33<Traced>, this);
+    opcodeHandler[0x34] = std::bind(&CPULR35902::OP_34<Traced>, this);
+    opcodeHandler[0x35] = std::bind(&CPULR35902::OP_35<Traced>, this);
+    opcodeHandler[0x36] = std::bind(&CPULR35902::OP_36<Traced>, this);
+    opcodeHandler[0x37] = std::bind(&CPULR35902::OP_37<Traced>, this);
+    opcodeHandler[0x38] = std::bind(&CPULR35902::OP_38<Traced>, this);
+    opcodeHandler[0x39] = std::bind(&CPULR35902::OP_39<Traced>, this);
+    opcodeHandler[0x3A] = std::bind(&CPULR35902::OP_3A<Traced>, this);
+    opcodeHandler[0x3B] = std::bind(&CPULR35902::OP_3B<Traced>, this);
+    opcodeHandler[0x3C] = std::bind(&CPULR35902::OP_3C<Traced>, this);
+    opcodeHandler[0x3D] = std::bind(&CPULR35902::OP_3D<Traced>, this);
+    opcodeHandler[0x3E] = std::bind(&CPULR35902::OP_3E<Traced>, this);
+    opcodeHandler[0x3F] = std::bind(&CPULR35902::OP_3F<Traced>, this);
+    opcodeHandler[0x40] = std::bind(&CPULR35902::OP_40<Traced>, this);
+    opcodeHandler[0x41] = std::bind(&CPULR35902::OP_41<Traced>, this);
+    opcodeHandler[0x42] = std::bind(&CPULR35902::OP_42<Traced>, this);
+    opcodeHandler[0x43] = std::bind(&CPULR35902::OP_43<Traced>, this);
+    opcodeHandler[0x44] = std::bind(&CPULR35902::OP_44<Traced>, this);
+    opcodeHandler[0x45] = std::bind(&CPULR35902::OP_45<Traced>, this);
+    opcodeHandler[0x46] = std::bind(&CPULR35902::OP_46<Traced>, this);
+    opcodeHandler[0x47] = std::bind(&CPULR35902::OP_47<Traced>, this);
+    opcodeHandler[0x48] = std::bind(&CPULR35902::OP_48<Traced>, this);
+    opcodeHandler[0x49] = std::bind(&CPULR35902::OP_49<Traced>, this);
+    opcodeHandler[0x4A] = std::bind(&CPULR35902::OP_4A<Traced>, this);
+    opcodeHandler[0x4B] = std::bind(&CPULR35902::OP_4B<Traced>, this);
+    opcodeHandler[0x4C] = std::bind(&CPULR35902::OP_4C<Traced>, this);
+    opcodeHandler[0x4D] = std::bind(&CPULR35902::OP_4D<Traced>, this);
+    opcodeHandler[0x4E] = std::bind(&CPULR35902::OP_4E<Traced>, this);
+    opcodeHandler[0x4F] = std::bind(&CPULR35902::OP_4F<Traced>, this);
+    opcodeHandler[0x50] = std::bind(&CPULR35902::OP_50<Traced>, this);
+    opcodeHandler[0x51] = std::bind(&CPULR35902::OP_51<Traced>, this);
+    opcodeHandler[0x52] = std::bind(&CPULR35902::OP_52<Traced>, this);
+    opcodeHandler[0x53] = std::bind(&CPULR35902::OP_53<Traced>, this);
+    opcodeHandler[0x54] = std::bind(&CPULR35902::OP_54<Traced>, this);
+    opcodeHandler[0x55] = std::bind(&CPULR35902::OP_55<Traced>, this);
+    opcodeHandler[0x56] = std::bind(&CPULR35902::OP_56<Traced>, this);
+    opcodeHandler[0x57] = std::bind(&CPULR35902::OP_57<Traced>, this);
+    opcodeHandler[0x58] = std::bind(&CPULR35902::OP_58<Traced>, this);
+    opcodeHandler[0x59] = std::bind(&CPULR35902::OP_59<Traced>, this);
+    opcodeHandler[0x5A] = std::bind(&CPULR35902::OP_5A<Traced>, this);
+    opcodeHandler[0x5B] = std::bind(&CPULR35902::OP_5B<Traced>, this);
+    opcodeHandler[0x5C] = std::bind(&CPULR35902::OP_5C<Traced>, this);
+    opcodeHandler[0x5D] = std::bind(&CPULR35902::OP_5D<Traced>, this);
+    opcodeHandler[0x5E] = std::bind(&CPULR35902::OP_5E<Traced>, this);
+    opcodeHandler[0x5F] = std::bind(&CPULR35902::OP_5F<Traced>, this);
+    opcodeHandler[0x60] = std::bind(&CPULR35902::OP_60<Traced>, this);
+    opcodeHandler[0x61] = std::bind(&CPULR35902::OP_61<Traced>, this);
+    opcodeHandler[0x62] = std::bind(&CPULR35902::OP_62<Traced>, this);
+    opcodeHandler[0x63] = std::bind(&CPULR35902::OP_63<Traced>, this);
+    opcodeHandler[0x64] = std::bind(&CPULR35902::OP_64<Traced>, this);
+    opcodeHandler[0x65] = std::bind(&CPULR35902::OP_65<Traced>, this);
+    opcodeHandler[0x66] = std::bind(&CPULR35902::OP_66<Traced>, this);
+    opcodeHandler[0x67] = std::bind(&CPULR35902::OP_67<Traced>, this);
+    opcodeHandler[0x68] = std::bind(&CPULR35902::OP_68<Traced>, this);
+    opcodeHandler[0x69] = std::bind(&CPULR35902::OP_69<Traced>, this);
+    opcodeHandler[0x6A] = std::bind(&CPULR35902::OP_6A<Traced>, this);
+    opcodeHandler[0x6B] = std::bind(&CPULR35902::OP_6B<Traced>, this);
+    opcodeHandler[0x6C] = std::bind(&CPULR35902::OP_6C<Traced>, this);
+    opcodeHandler[0x6D] = std::bind(&CPULR35902::OP_6D<Traced>, this);
+    opcodeHandler[0x6E] = std::bind(&CPULR35902::OP_6E<Traced>, this);
+    opcodeHandler[0x6F] = std::bind(&CPULR35902::OP_6F<Traced>, this);
+    opcodeHandler[0x70] = std::bind(&CPULR35902::OP_70<Traced>, this);
+    opcodeHandler[0x71] = std::bind(&CPULR35902::OP_71<Traced>, this);
+    opcodeHandler[0x72] = std::bind(&CPULR35902::OP_72<Traced>, this);
+    opcodeHandler[0x73] = std::bind(&CPULR35902::OP_73<Traced>, this);
+    opcodeHandler[0x74] = std::bind(&CPULR35902::OP_74<Traced>, this);
+    opcodeHandler[0x75] = std::bind(&CPULR35902::OP_75<Traced>, this);
+    opcodeHandler[0x76] = std::bind(&CPULR35902::OP_76<Traced>, this);
+    opcodeHandler[0x77] = std::bind(&CPULR35902::OP_77<Traced>, this);
+    opcodeHandler[0x78] = std::bind(&CPULR35902::OP_78<Traced>, this);
+    opcodeHandler[0x79] = std::bind(&CPULR35902::OP_79<Traced>, this);
+    opcodeHandler[0x7A] = std::bind(&CPULR35902::OP_7A<Traced>, this);
+    opcodeHandler[0x7B] = std::bind(&CPULR35902::OP_7B<Traced>, this);
+    opcodeHandler[0x7C] = std::bind(&CPULR35902::OP_7C<Traced>, this);
+    opcodeHandler[0x7D] = std::bind(&CPULR35902::OP_7D<Traced>, this);
+    opcodeHandler[0x7E] = std::bind(&CPULR35902::OP_7E<Traced>, this);
+    opcodeHandler[0x7F] = std::bind(&CPULR35902::OP_7F<Traced>, this);
+    opcodeHandler[0x80] = std::bind(&CPULR35902::OP_80<Traced>, this);
+    opcodeHandler[0x81] = std::bind(&CPULR35902::OP_81<Traced>, this);
+    opcodeHandler[0x82] = std::bind(&CPULR35902::OP_82<Traced>, this);
+    opcodeHandler[0x83] = std::bind(&CPULR35902::OP_83<Traced>, this);
+    opcodeHandler[0x84] = std::bind(&CPULR35902::OP_84<Traced>, this);
+    opcodeHandler[0x85] = std::bind(&CPULR35902::OP_85<Traced>, this);
+    opcodeHandler[0x86] = std::bind(&CPULR35902::OP_86<Traced>, this);
+    opcodeHandler[0x87] = std::bind(&CPULR35902::OP_87<Traced>, this);
+    opcodeHandler[0x88] = std::bind(&CPULR35902::OP_88<Traced>, this);
+    opcodeHandler[0x89] = std::bind(&CPULR35902::OP_89<Traced>, this);
+    opcodeHandler[0x8A] = std::bind(&CPULR35902::OP_8A<Traced>, this);
+    opcodeHandler[0x8B] = std::bind(&CPULR35902::OP_8B<Traced>, this);
+    opcodeHandler[0x8C] = std::bind(&CPULR35902::OP_8C<Traced>, this);
+    opcodeHandler[0x8D] = std::bind(&CPULR35902::OP_8D<Traced>, this);
+    opcodeHandler[0x8E] = std::bind(&CPULR35902::OP_8E<Traced>, this);
+    opcodeHandler[0x8F] = std::bind(&CPULR35902::OP_8F<Traced>, this);
+    opcodeHandler[0x90] = std::bind(&CPULR35902::OP_90<Traced>, this);
+    opcodeHandler[0x91] = std::bind(&CPULR35902::OP_91<Traced>, this);
+    opcodeHandler[0x92] = std::bind(&CPULR35902::OP_92<Traced>, this);
+    opcodeHandler[0x93] = std::bind(&CPULR35902::OP_93<Traced>, this);
+    opcodeHandler[0x94] = std::bind(&CPULR35902::OP_94<Traced>, this);
+    opcodeHandler[0x95] = std::bind(&CPULR35902::OP_95<Traced>, this);
+    opcodeHandler[0x96] = std::bind(&CPULR35902::OP_96<Traced>, this);
+    opcodeHandler[0x97] = std::bind(&CPULR35902::OP_97<Traced>, this);
+    opcodeHandler[0x98] = std::bind(&CPULR35902::OP_98<Traced>, this);
+    opcodeHandler[0x99] = std::bind(&CPULR35902::OP_99<Traced>, this);
+    opcodeHandler[0x9A] = std::bind(&CPULR35902::OP_9A<Traced>, this);
+    opcodeHandler[0x9B] = std::bind(&CPULR35902::OP_9B<Traced>, this);
+    opcodeHandler[0x9C] = std::bind(&CPULR35902::OP_9C<Traced>, this);
+    opcodeHandler[0x9D] = std::bind(&CPULR35902::OP_9D<Traced>, this);
+    opcodeHandler[0x9E] = std::bind(&CPULR35902::OP_9E<Traced>, this);
+    opcodeHandler[0x9F] = std::bind(&CPULR35902::OP_9F<Traced>, this);
+    opcodeHandler[0xA0] = std::bind(&CPULR35902::OP_A0<Traced>, this);
+    opcodeHandler[0xA1] = std::bind(&CPULR35902::OP_A1<Traced>, this);
+    opcodeHandler[0xA2] = std::bind(&CPULR35902::OP_A2<Traced>, this);
+    opcodeHandler[0xA3] = std::bind(&CPULR35902::OP_A3<Traced>, this);
+    opcodeHandler[0xA4] = std::bind(&CPULR35902::OP_A4<Traced>, this);
+    opcodeHandler[0xA5] = std::bind(&CPULR35902::OP_A5<Traced>, this);
+    opcodeHandler[0xA6] = std::bind(&CPULR35902::OP_A6<Traced>, this);
+    opcodeHandler[0xA7] = std::bind(&CPULR35902::OP_A7<Traced>, this);
+    opcodeHandler[0xA8] = std::bind(&CPULR35902::OP_A8<Traced>, this);
+    opcodeHandler[0xA9] = std::bind(&CPULR35902::OP_A9<Traced>, this);
+    opcodeHandler[0xAA] = std::bind(&CPULR35902::OP_AA<Traced>, this);
+    opcodeHandler[0xAB] = std::bind(&CPULR35902::OP_AB<Traced>, this);
+    opcodeHandler[0xAC] = std::bind(&CPULR35902::OP_AC<Traced>, this);
+    opcodeHandler[0xAD] = std::bind(&CPULR35902::OP_AD<Traced>, this);
+    opcodeHandler[0xAE] = std::bind(&CPULR35902::OP_AE<Traced>, this);
+    opcodeHandler[0xAF] = std::bind(&CPULR35902::OP_AF<Traced>, this);
+    opcodeHandler[0xB0] = std::bind(&CPULR35902::OP_B0<Traced>, this);
+    opcodeHandler[0xB1] = std::bind(&CPULR35902::OP_B1<Traced>, this);
+    opcodeHandler[0xB2] = std::bind(&CPULR35902::OP_B2<Traced>, this);
+    opcodeHandler[0xB3] = std::bind(&CPULR35902::OP_B3<Traced>, this);
+    opcodeHandler[0xB4] = std::bind(&CPULR35902::OP_B4<Traced>, this);
+    opcodeHandler[0xB5] = std::bind(&CPULR35902::OP_B5<Traced>, this);
+    opcodeHandler[0xB6] = std::bind(&CPULR35902::OP_B6<Traced>, this);
+    opcodeHandler[0xB7] = std::bind(&CPULR35902::OP_B7<Traced>, this);
+    opcodeHandler[0xB8] = std::bind(&CPULR35902::OP_B8<Traced>, this);
+    opcodeHandler[0xB9] = std::bind(&CPULR35902::OP_B9<Traced>, this);
+    opcodeHandler[0xBA] = std::bind(&CPULR35902::OP_BA<Traced>, this);
+    opcodeHandler[0xBB] = std::bind(&CPULR35902::OP_BB<Traced>, this);
+    opcodeHandler[0xBC] = std::bind(&CPULR35902::OP_BC<Traced>, this);
+    opcodeHandler[0xBD] = std::bind(&CPULR35902::OP_BD<Traced>, this);
+    opcodeHandler[0xBE] = std::bind(&CPULR35902::OP_BE<Traced>, this);
+    opcodeHandler[0xBF] = std::bind(&CPULR35902::OP_BF<Traced>, this);
+    opcodeHandler[0xC0] = std::bind(&CPULR35902::OP_C0<Traced>, this);
+    opcodeHandler[0xC1] = std::bind(&CPULR35902::OP_C1<Traced>, this);
+    opcodeHandler[0xC2] = std::bind(&CPULR35902::OP_C2<Traced>, this);
+    opcodeHandler[0xC3] = std::bind(&CPULR35902::OP_C3<Traced>, this);
+    opcodeHandler[0xC4] = std::bind(&CPULR35902::OP_C4<Traced>, this);
+    opcodeHandler[0xC5] = std::bind(&CPULR35902::OP_C5<Traced>, this);
+    opcodeHandler[0xC6] = std::bind(&CPULR35902::OP_C6<Traced>, this);
+    opcodeHandler[0xC7] = std::bind(&CPULR35902::OP_C7<Traced>, this);
+    opcodeHandler[0xC8] = std::bind(&CPULR35902::OP_C8<Traced>, this);
+    opcodeHandler[0xC9] = std::bind(&CPULR35902::OP_C9<Traced>, this);
+    opcodeHandler[0xCA] = std::bind(&CPULR35902::OP_CA<Traced>, this);
+    opcodeHandler[0xCB] = std::bind(&CPULR35902::OP_CB<Traced>, this);
+    opcodeHandler[0xCC] = std::bind(&CPULR35902::OP_CC<Traced>, this);
+    opcodeHandler[0xCD] = std::bind(&CPULR35902::OP_CD<Traced>, this);
+    opcodeHandler[0xCE] = std::bind(&CPULR35902::OP_CE<Traced>, this);
+    opcodeHandler[0xCF] = std::bind(&CPULR35902::OP_CF<Traced>, this);
+    opcodeHandler[0xD0] = std::bind(&CPULR35902::OP_D0<Traced>, this);
+    opcodeHandler[0xD1] = std::bind(&CPULR35902::OP_D1<Traced>, this);
+    opcodeHandler[0xD2] = std::bind(&CPULR35902::OP_D2<Traced>, this);
+    opcodeHandler[0xD3] = std::bind(&CPULR35902::OP_D3<Traced>, this);
+    opcodeHandler[0xD4] = std::bind(&CPULR35902::OP_D4<Traced>, this);
+    opcodeHandler[0xD5] = std::bind(&CPULR35902::OP_D5<Traced>, this);
+    opcodeHandler[0xD6] = std::bind(&CPULR35902::OP_D6<Traced>, this);
+    opcodeHandler[0xD7] = std::bind(&CPULR35902::OP_D7<Traced>, this);
+    opcodeHandler[0xD8] = std::bind(&CPULR35902::OP_D8<Traced>, this);
+    opcodeHandler[0xD9] = std::bind(&CPULR35902::OP_D9<Traced>, this);
+    opcodeHandler[0xDA] = std::bind(&CPULR35902::OP_DA<Traced>, this);
+    opcodeHandler[0xDB] = std::bind(&CPULR35902::OP_DB<Traced>, this);
+    opcodeHandler[0xDC] = std::bind(&CPULR35902::OP_DC<Traced>, this);
+    opcodeHandler[0xDD] = std::bind(&CPULR35902::OP_DD<Traced>, this);
+    opcodeHandler[0xDE] = std::bind(&CPULR35902::OP_DE<Traced>, this);
+    opcodeHandler[0xDF] = std::bind(&CPULR35902::OP_DF<Traced>, this);
+    opcodeHandler[0xE0] = std::bind(&CPULR35902::OP_E0<Traced>, this);
+    opcodeHandler[0xE1] = std::bind(&CPULR35902::OP_E1<Traced>, this);
+    opcodeHandler[0xE2] = std::bind(&CPULR35902::OP_E2<Traced>, this);
+    opcodeHandler[0xE3] = std::bind(&CPULR35902::OP_E3<Traced>, this);
+    opcodeHandler[0xE4] = std::bind(&CPULR35902::OP_E4<Traced>, this);
+    opcodeHandler[0xE5] = std::bind(&CPULR35902::OP_E5<Traced>, this);
+    opcodeHandler[0xE6] = std::bind(&CPULR35902::OP_E6<Traced>, this);
+    opcodeHandler[0xE7] = std::bind(&CPULR35902::OP_E7<Traced>, this);
+    opcodeHandler[0xE8] = std::bind(&CPULR35902::OP_E8<Traced>, this);
+    opcodeHandler[0xE9] = std::bind(&CPULR35902::OP_E9<Traced>, this);
+    opcodeHandler[0xEA] = std::bind(&CPULR35902::OP_EA<Traced>, this);
+    opcodeHandler[0xEB] = std::bind(&CPULR35902::OP_EB<Traced>, this);
+    opcodeHandler[0xEC] = std::bind(&CPULR35902::OP_EC<Traced>, this);
+    opcodeHandler[0xED] = std::bind(&CPULR35902::OP_ED<Traced>, this);
+    opcodeHandler[0xEE] = std::bind(&CPULR35902::OP_EE<Traced>, this);
+    opcodeHandler[0xEF] = std::bind(&CPULR35902::OP_EF<Traced>, this);
+    opcodeHandler[0xF0] = std::bind(&CPULR35902::OP_F0<Traced>, this);
+    opcodeHandler[0xF1] = std::bind(&CPULR35902::OP_F1<Traced>, this);
+    opcodeHandler[0xF2] = std::bind(&CPULR35902::OP_F2<Traced>, this);
+    opcodeHandler[0xF3] = std::bind(&CPULR35902::OP_F3<Traced>, this);
+    opcodeHandler[0xF4] = std::bind(&CPULR35902::OP_F4<Traced>, this);
+    opcodeHandler[0xF5] = std::bind(&CPULR35902::OP_F5<Traced>, this);
+    opcodeHandler[0xF6] = std::bind(&CPULR35902::OP_F6<Traced>, this);
+    opcodeHandler[0xF7] = std::bind(&CPULR35902::OP_F7<Traced>, this);
+    opcodeHandler[0xF8] = std::bind(&CPULR35902::OP_F8<Traced>, this);
+    opcodeHandler[0xF9] = std::bind(&CPULR35902::OP_F9<Traced>, this);
+    opcodeHandler[0xFA] = std::bind(&CPULR35902::OP_FA<Traced>, this);
+    opcodeHandler[0xFB] = std::bind(&CPULR35902::OP_FB<Traced>, this);
+    opcodeHandler[0xFC] = std::bind(&CPULR35902::OP_FC<Traced>, this);
+    opcodeHandler[0xFD] = std::bind(&CPULR35902::OP_FD<Traced>, this);
+    opcodeHandler[0xFE] = std::bind(&CPULR35902::OP_FE<Traced>, this);
+    opcodeHandler[0xFF] = std::bind(&CPULR35902::OP_FF<Traced>, this);
 
+    prefixHandler[0x00] = std::bind(&CPULR35902::PR_00<Traced>, this);
+    prefixHandler[0x01] = std::bind(&CPULR35902::PR_01<Traced>, this);
+    prefixHandler[0x02] = std::bind(&CPULR35902::PR_02<Traced>, this);
+    prefixHandler[0x03] = std::bind(&CPULR35902::PR_03<Traced>, this);
+    prefixHandler[0x04] = std::bind(&CPULR35902::PR_04<Traced>, this);
+    prefixHandler[0x05] = std::bind(&CPULR35902::PR_05<Traced>, this);
+    prefixHandler[0x06] = std::bind(&CPULR35902::PR_06<Traced>, this);
+    prefixHandler[0x07] = std::bind(&CPULR35902::PR_07<Traced>, this);
+    prefixHandler[0x08] = std::bind(&CPULR35902::PR_08<Traced>, this);
+    prefixHandler[0x09] = std::bind(&CPULR35902::PR_09<Traced>, this);
+    prefixHandler[0x0A] = std::bind(&CPULR35902::PR_0A<Traced>, this);
+    prefixHandler[0x0B] = std::bind(&CPULR35902::PR_0B<Traced>, this);
+    prefixHandler[0x0C] = std::bind(&CPULR35902::PR_0C<Traced>, this);
+    prefixHandler[0x0D] = std::bind(&CPULR35902::PR_0D<Traced>, this);
+    prefixHandler[0x0E] = std::bind(&CPULR35902::PR_0E<Traced>, this);
+    prefixHandler[0x0F] = std::bind(&CPULR35902::PR_0F<Traced>, this);
+    prefixHandler[0x10] = std::bind(&CPULR35902::PR_10<Traced>, this);
+    prefixHandler[0x11] = std::bind(&CPULR35902::PR_11<Traced>, this);
+    prefixHandler[0x12] = std::bind(&CPULR35902::PR_12<Traced>, this);
+    prefixHandler[0x13] = std::bind(&CPULR35902::PR_13<Traced>, this);
+    prefixHandler[0x14] = std::bind(&CPULR35902::PR_14<Traced>, this);
+    prefixHandler[0x15] = std::bind(&CPULR35902::PR_15<Traced>, this);
+    prefixHandler[0x16] = std::bind(&CPULR35902::PR_16<Traced>, this);
+    prefixHandler[0x17] = std::bind(&CPULR35902::PR_17<Traced>, this);
+    prefixHandler[0x18] = std::bind(&CPULR35902::PR_18<Traced>, this);
+    prefixHandler[0x19] = std::bind(&CPULR35902::PR_19<Traced>, this);
+    prefixHandler[0x1A] = std::bind(&CPULR35902::PR_1A<Traced>, this);
+    prefixHandler[0x1B] = std::bind(&CPULR35902::PR_1B<Traced>, this);
+    prefixHandler[0x1C] = std::bind(&CPULR35902::PR_1C<Traced>, this);
+    prefixHandler[0x1D] = std::bind(&CPULR35902::PR_1D<Traced>, this);
+    prefixHandler[0x1E] = std::bind(&CPULR35902::PR_1E<Traced>, this);
+    prefixHandler[0x1F] = std::bind(&CPULR35902::PR_1F<Traced>, this);
+    prefixHandler[0x20] = std::bind(&CPULR35902::PR_20<Traced>, this);
+    prefixHandler[0x21] = std::bind(&CPULR35902::PR_21<Traced>, this);
+    prefixHandler[0x22] = std::bind(&CPULR35902::PR_22<Traced>, this);
+    prefixHandler[0x23] = std::bind(&CPULR35902::PR_23<Traced>, this);
+    prefixHandler[0x24] = std::bind(&CPULR35902::PR_24<Traced>, this);
+    prefixHandler[0x25] = std::bind(&CPULR35902::PR_25<Traced>, this);
+    prefixHandler[0x26] = std::bind(&CPULR35902::PR_26<Traced>, this);
+    prefixHandler[0x27] = std::bind(&CPULR35902::PR_27<Traced>, this);
+    prefixHandler[0x28] = std::bind(&CPULR35902::PR_28<Traced>, this);
+    prefixHandler[0x29] = std::bind(&CPULR35902::PR_29<Traced>, this);
+    prefixHandler[0x2A] = std::bind(&CPULR35902::PR_2A<Traced>, this);
+    prefixHandler[0x2B] = std::bind(&CPULR35902::PR_2B<Traced>, this);
+    prefixHandler[0x2C] = std::bind(&CPULR35902::PR_2C<Traced>, this);
+    prefixHandler[0x2D] = std::bind(&CPULR35902::PR_2D<Traced>, this);
+    prefixHandler[0x2E] = std::bind(&CPULR35902::PR_2E<Traced>, this);
+    prefixHandler[0x2F] = std::bind(&CPULR35902::PR_2F<Traced>, this);
+    prefixHandler[0x30] = std::bind(&CPULR35902::PR_30<Traced>, this);
+    prefixHandler[0x31] = std::bind(&CPULR35902::PR_31<Traced>, this);
+    prefixHandler[0x32] = std::bind(&CPULR35902::PR_32<Traced>, this);
+    prefixHandler[0x33] = std::bind(&CPULR35902::PR_33<Traced>, this);
+    prefixHandler[0x34] = std::bind(&CPULR35902::PR_34<Traced>, this);
+    prefixHandler[0x35] = std::bind(&CPULR35902::PR_35<Traced>, this);
+    prefixHandler[0x36] = std::bind(&CPULR35902::PR_36<Traced>, this);
+    prefixHandler[0x37] = std::bind(&CPULR35902::PR_37<Traced>, this);
+    prefixHandler[0x38] = std::bind(&CPULR35902::PR_38<Traced>, this);
+    prefixHandler[0x39] = std::bind(&CPULR35902::PR_39<Traced>, this);
+    prefixHandler[0x3A] = std::bind(&CPULR35902::PR_3A<Traced>, this);
+    prefixHandler[0x3B] = std::bind(&CPULR35902::PR_3B<Traced>, this);
+    prefixHandler[0x3C] = std::bind(&CPULR35902::PR_3C<Traced>, this);
+    prefixHandler[0x3D] = std::bind(&CPULR35902::PR_3D<Traced>, this);
+    prefixHandler[0x3E] = std::bind(&CPULR35902::PR_3E<Traced>, this);
+    prefixHandler[0x3F] = std::bind(&CPULR35902::PR_3F<Traced>, this);
+    prefixHandler[0x40] = std::bind(&CPULR35902::PR_40<Traced>, this);
+    prefixHandler[0x41] = std::bind(&CPULR35902::PR_41<Traced>, this);
+    prefixHandler[0x42] = std::bind(&CPULR35902::PR_42<Traced>, this);
+    prefixHandler[0x43] = std::bind(&CPULR35902::PR_43<Traced>, this);
+    prefixHandler[0x44] = std::bind(&CPULR35902::PR_44<Traced>, this);
+    prefixHandler[0x45] = std::bind(&CPULR35902::PR_45<Traced>, this);
+    prefixHandler[0x46] = std::bind(&CPULR35902::PR_46<Traced>, this);
+    prefixHandler[0x47] = std::bind(&CPULR35902::PR_47<Traced>, this);
+    prefixHandler[0x48] = std::bind(&CPULR35902::PR_48<Traced>, this);
+    prefixHandler[0x49] = std::bind(&CPULR35902::PR_49<Traced>, this);
+    prefixHandler[0x4A] = std::bind(&CPULR35902::PR_4A<Traced>, this);
+    prefixHandler[0x4B] = std::bind(&CPULR35902::PR_4B<Traced>, this);
+    prefixHandler[0x4C] = std::bind(&CPULR35902::PR_4C<Traced>, this);
+    prefixHandler[0x4D] = std::bind(&CPULR35902::PR_4D<Traced>, this);
+    prefixHandler[0x4E] = std::bind(&CPULR35902::PR_4E<Traced>, this);
+    prefixHandler[0x4F] = std::bind(&CPULR35902::PR_4F<Traced>, this);
+    prefixHandler[0x50] = std::bind(&CPULR35902::PR_50<Traced>, this);
+    prefixHandler[0x51] = std::bind(&CPULR35902::PR_51<Traced>, this);
+    prefixHandler[0x52] = std::bind(&CPULR35902::PR_52<Traced>, this);
+    prefixHandler[0x53] = std::bind(&CPULR35902::PR_53<Traced>, this);
+    prefixHandler[0x54] = std::bind(&CPULR35902::PR_54<Traced>, this);
+    prefixHandler[0x55] = std::bind(&CPULR35902::PR_55<Traced>, this);
+    prefixHandler[0x56] = std::bind(&CPULR35902::PR_56<Traced>, this);
+    prefixHandler[0x57] = std::bind(&CPULR35902::PR_57<Traced>, this);
+    prefixHandler[0x58] = std::bind(&CPULR35902::PR_58<Traced>, this);
+    prefixHandler[0x59] = std::bind(&CPULR35902::PR_59<Traced>, this);
+    prefixHandler[0x5A] = std::bind(&CPULR35902::PR_5A<Traced>, this);
+    prefixHandler[0x5B] = std::bind(&CPULR35902::PR_5B<Traced>, this);
+    prefixHandler[0x5C] = std::bind(&CPULR35902::PR_5C<Traced>, this);
+    prefixHandler[0x5D] = std::bind(&CPULR35902::PR_5D<Traced>, this);
+    prefixHandler[0x5E] = std::bind(&CPULR35902::PR_5E<Traced>, this);
+    prefixHandler[0x5F] = std::bind(&CPULR35902::PR_5F<Traced>, this);
+    prefixHandler[0x60] = std::bind(&CPULR35902::PR_60<Traced>, this);
+    prefixHandler[0x61] = std::bind(&CPULR35902::PR_61<Traced>, this);
+    prefixHandler[0x62] = std::bind(&CPULR35902::PR_62<Traced>, this);
+    prefixHandler[0x63] = std::bind(&CPULR35902::PR_63<Traced>, this);
+    prefixHandler[0x64] = std::bind(&CPULR35902::PR_64<Traced>, this);
+    prefixHandler[0x65] = std::bind(&CPULR35902::PR_65<Traced>, this);
+    prefixHandler[0x66] = std::bind(&CPULR35902::PR_66<Traced>, this);
+    prefixHandler[0x67] = std::bind(&CPULR35902::PR_67<Traced>, this);
+    prefixHandler[0x68] = std::bind(&CPULR35902::PR_68<Traced>, this);
+    prefixHandler[0x69] = std::bind(&CPULR35902::PR_69<Traced>, this);
+    prefixHandler[0x6A] = std::bind(&CPULR35902::PR_6A<Traced>, this);
+    prefixHandler[0x6B] = std::bind(&CPULR35902::PR_6B<Traced>, this);
+    prefixHandler[0x6C] = std::bind(&CPULR35902::PR_6C<Traced>, this);
+    prefixHandler[0x6D] = std::bind(&CPULR35902::PR_6D<Traced>, this);
+    prefixHandler[0x6E] = std::bind(&CPULR35902::PR_6E<Traced>, this);
+    prefixHandler[0x6F] = std::bind(&CPULR35902::PR_6F<Traced>, this);
+    prefixHandler[0x70] = std::bind(&CPULR35902::PR_70<Traced>, this);
+    prefixHandler[0x71] = std::bind(&CPULR35902::PR_71<Traced>, this);
+    prefixHandler[0x72] = std::bind(&CPULR35902::PR_72<Traced>, this);
+    prefixHandler[0x73] = std::bind(&CPULR35902::PR_73<Traced>, this);
+    prefixHandler[0x74] = std::bind(&CPULR35902::PR_74<Traced>, this);
+    prefixHandler[0x75] = std::bind(&CPULR35902::PR_75<Traced>, this);
+    prefixHandler[0x76] = std::bind(&CPULR35902::PR_76<Traced>, this);
+    prefixHandler[0x77] = std::bind(&CPULR35902::PR_77<Traced>, this);
+    prefixHandler[0x78] = std::bind(&CPULR35902::PR_78<Traced>, this);
+    prefixHandler[0x79] = std::bind(&CPULR35902::PR_79<Traced>, this);
+    prefixHandler[0x7A] = std::bind(&CPULR35902::PR_7A<Traced>, this);
+    prefixHandler[0x7B] = std::bind(&CPULR35902::PR_7B<Traced>, this);
+    prefixHandler[0x7C] = std::bind(&CPULR35902::PR_7C<Traced>, this);
+    prefixHandler[0x7D] = std::bind(&CPULR35902::PR_7D<Traced>, this);
+    prefixHandler[0x7E] = std::bind(&CPULR35902::PR_7E<Traced>, this);
+    prefixHandler[0x7F] = std::bind(&CPULR35902::PR_7F<Traced>, this);
+    prefixHandler[0x80] = std::bind(&CPULR35902::PR_80<Traced>, this);
+    prefixHandler[0x81] = std::bind(&CPULR35902::PR_81<Traced>, this);
+    prefixHandler[0x82] = std::bind(&CPULR35902::PR_82<Traced>, this);
+    prefixHandler[0x83] = std::bind(&CPULR35902::PR_83<Traced>, this);
+    prefixHandler[0x84] = std::bind(&CPULR35902::PR_84<Traced>, this);
+    prefixHandler[0x85] = std::bind(&CPULR35902::PR_85<Traced>, this);
+    prefixHandler[0x86] = std::bind(&CPULR35902::PR_86<Traced>, this);
+    prefixHandler[0x87] = std::bind(&CPULR35902::PR_87<Traced>, this);
+    prefixHandler[0x88] = std::bind(&CPULR35902::PR_88<Traced>, this);
+    prefixHandler[0x89] = std::bind(&CPULR35902::PR_89<Traced>, this);
+    prefixHandler[0x8A] = std::bind(&CPULR35902::PR_8A<Traced>, this);
+    prefixHandler[0x8B] = std::bind(&CPULR35902::PR_8B<Traced>, this);
+    prefixHandler[0x8C] = std::bind(&CPULR35902::PR_8C<Traced>, this);
+    prefixHandler[0x8D] = std::bind(&CPULR35902::PR_8D<Traced>, this);
+    prefixHandler[0x8E] = std::bind(&CPULR35902::PR_8E<Traced>, this);
+    prefixHandler[0x8F] = std::bind(&CPULR35902::PR_8F<Traced>, this);
+    prefixHandler[0x90] = std::bind(&CPULR35902::PR_90<Traced>, this);
+    prefixHandler[0x91] = std::bind(&CPULR35902::PR_91<Traced>, this);
+    prefixHandler[0x92] = std::bind(&CPULR35902::PR_92<Traced>, this);
+    prefixHandler[0x93] = std::bind(&CPULR35902::PR_93<Traced>, this);
+    prefixHandler[0x94] = std::bind(&CPULR35902::PR_94<Traced>, this);
+    prefixHandler[0x95] = std::bind(&CPULR35902::PR_95<Traced>, this);
+    prefixHandler[0x96] = std::bind(&CPULR35902::PR_96<Traced>, this);
+    prefixHandler[0x97] = std::bind(&CPULR35902::PR_97<Traced>, this);
+    prefixHandler[0x98] = std::bind(&CPULR35902::PR_98<Traced>, this);
+    prefixHandler[0x99] = std::bind(&CPULR35902::PR_99<Traced>, this);
+    prefixHandler[0x9A] = std::bind(&CPULR35902::PR_9A<Traced>, this);
+    prefixHandler[0x9B] = std::bind(&CPULR35902::PR_9B<Traced>, this);
+    prefixHandler[0x9C] = std::bind(&CPULR35902::PR_9C<Traced>, this);
+    prefixHandler[0x9D] = std::bind(&CPULR35902::PR_9D<Traced>, this);
+    prefixHandler[0x9E] = std::bind(&CPULR35902::PR_9E<Traced>, this);
+    prefixHandler[0x9F] = std::bind(&CPULR35902::PR_9F<Traced>, this);
+    prefixHandler[0xA0] = std::bind(&CPULR35902::PR_A0<Traced>, this);
+    prefixHandler[0xA1] = std::bind(&CPULR35902::PR_A1<Traced>, this);
+    prefixHandler[0xA2] = std::bind(&CPULR35902::PR_A2<Traced>, this);
+    prefixHandler[0xA3] = std::bind(&CPULR35902::PR_A3<Traced>, this);
+    prefixHandler[0xA4] = std::bind(&CPULR35902::PR_A4<Traced>, this);
+    prefixHandler[0xA5] = std::bind(&CPULR35902::PR_A5<Traced>, this);
+    prefixHandler[0xA6] = std::bind(&CPULR35902::PR_A6<Traced>, this);
+    prefixHandler[0xA7] = std::bind(&CPULR35902::PR_A7<Traced>, this);
+    prefixHandler[0xA8] = std::bind(&CPULR35902::PR_A8<Traced>, this);
+    prefixHandler[0xA9] = std::bind(&CPULR35902::PR_A9<Traced>, this);
+    prefixHandler[0xAA] = std::bind(&CPULR35902::PR_AA<Traced>, this);
+    prefixHandler[0xAB] = std::bind(&CPULR35902::PR_AB<Traced>, this);
+    prefixHandler[0xAC] = std::bind(&CPULR35902::PR_AC<Traced>, this);
+    prefixHandler[0xAD] = std::bind(&CPULR35902::PR_AD<Traced>, this);
+    prefixHandler[0xAE] = std::bind(&CPULR35902::PR_AE<Traced>, this);
+    prefixHandler[0xAF] = std::bind(&CPULR35902::PR_AF<Traced>, this);
+    prefixHandler[0xB0] = std::bind(&CPULR35902::PR_B0<Traced>, this);
+    prefixHandler[0xB1] = std::bind(&CPULR35902::PR_B1<Traced>, this);
+    prefixHandler[0xB2] = std::bind(&CPULR35902::PR_B2<Traced>, this);
+    prefixHandler[0xB3] = std::bind(&CPULR35902::PR_B3<Traced>, this);
+    prefixHandler[0xB4] = std::bind(&CPULR35902::PR_B4<Traced>, this);
+    prefixHandler[0xB5] = std::bind(&CPULR35902::PR_B5<Traced>, this);
+    prefixHandler[0xB6] = std::bind(&CPULR35902::PR_B6<Traced>, this);
+    prefixHandler[0xB7] = std::bind(&CPULR35902::PR_B7<Traced>, this);
+    prefixHandler[0xB8] = std::bind(&CPULR35902::PR_B8<Traced>, this);
+    prefixHandler[0xB9] = std::bind(&CPULR35902::PR_B9<Traced>, this);
+    prefixHandler[0xBA] = std::bind(&CPULR35902::PR_BA<Traced>, this);
+    prefixHandler[0xBB] = std::bind(&CPULR35902::PR_BB<Traced>, this);
+    prefixHandler[0xBC] = std::bind(&CPULR35902::PR_BC<Traced>, this);
+    prefixHandler[0xBD] = std::bind(&CPULR35902::PR_BD<Traced>, this);
+    prefixHandler[0xBE] = std::bind(&CPULR35902::PR_BE<Traced>, this);
+    prefixHandler[0xBF] = std::bind(&CPULR35902::PR_BF<Traced>, this);
+    prefixHandler[0xC0] = std::bind(&CPULR35902::PR_C0<Traced>, this);
+    prefixHandler[0xC1] = std::bind(&CPULR35902::PR_C1<Traced>, this);
+    prefixHandler[0xC2] = std::bind(&CPULR35902::PR_C2<Traced>, this);
+    prefixHandler[0xC3] = std::bind(&CPULR35902::PR_C3<Traced>, this);
+    prefixHandler[0xC4] = std::bind(&CPULR35902::PR_C4<Traced>, this);
+    prefixHandler[0xC5] = std::bind(&CPULR35902::PR_C5<Traced>, this);
+    prefixHandler[0xC6] = std::bind(&CPULR35902::PR_C6<Traced>, this);
+    prefixHandler[0xC7] = std::bind(&CPULR35902::PR_C7<Traced>, this);
+    prefixHandler[0xC8] = std::bind(&CPULR35902::PR_C8<Traced>, this);
+    prefixHandler[0xC9] = std::bind(&CPULR35902::PR_C9<Traced>, this);
+    prefixHandler[0xCA] = std::bind(&CPULR35902::PR_CA<Traced>, this);
+    prefixHandler[0xCB] = std::bind(&CPULR35902::PR_CB<Traced>, this);
+    prefixHandler[0xCC] = std::bind(&CPULR35902::PR_CC<Traced>, this);
+    prefixHandler[0xCD] = std::bind(&CPULR35902::PR_CD<Traced>, this);
+    prefixHandler[0xCE] = std::bind(&CPULR35902::PR_CE<Traced>, this);
+    prefixHandler[0xCF] = std::bind(&CPULR35902::PR_CF<Traced>, this);
+    prefixHandler[0xD0] = std::bind(&CPULR35902::PR_D0<Traced>, this);
+    prefixHandler[0xD1] = std::bind(&CPULR35902::PR_D1<Traced>, this);
+    prefixHandler[0xD2] = std::bind(&CPULR35902::PR_D2<Traced>, this);
+    prefixHandler[0xD3] = std::bind(&CPULR35902::PR_D3<Traced>, this);
+    prefixHandler[0xD4] = std::bind(&CPULR35902::PR_D4<Traced>, this);
+    prefixHandler[0xD5] = std::bind(&CPULR35902::PR_D5<Traced>, this);
+    prefixHandler[0xD6] = std::bind(&CPULR35902::PR_D6<Traced>, this);
+    prefixHandler[0xD7] = std::bind(&CPULR35902::PR_D7<Traced>, this);
+    prefixHandler[0xD8] = std::bind(&CPULR35902::PR_D8<Traced>, this);
+    prefixHandler[0xD9] = std::bind(&CPULR35902::PR_D9<Traced>, this);
+    prefixHandler[0xDA] = std::bind(&CPULR35902::PR_DA<Traced>, this);
+    prefixHandler[0xDB] = std::bind(&CPULR35902::PR_DB<Traced>, this);
+    prefixHandler[0xDC] = std::bind(&CPULR35902::PR_DC<Traced>, this);
+    prefixHandler[0xDD] = std::bind(&CPULR35902::PR_DD<Traced>, this);
+    prefixHandler[0xDE] = std::bind(&CPULR35902::PR_DE<Traced>, this);
+    prefixHandler[0xDF] = std::bind(&CPULR35902::PR_DF<Traced>, this);
+    prefixHandler[0xE0] = std::bind(&CPULR35902::PR_E0<Traced>, this);
+    prefixHandler[0xE1] = std::bind(&CPULR35902::PR_E1<Traced>, this);
+    prefixHandler[0xE2] = std::bind(&CPULR35902::PR_E2<Traced>, this);
+    prefixHandler[0xE3] = std::bind(&CPULR35902::PR_E3<Traced>, this);
+    prefixHandler[0xE4] = std::bind(&CPULR35902::PR_E4<Traced>, this);
+    prefixHandler[0xE5] = std::bind(&CPULR35902::PR_E5<Traced>, this);
+    prefixHandler[0xE6] = std::bind(&CPULR35902::PR_E6<Traced>, this);
+    prefixHandler[0xE7] = std::bind(&CPULR35902::PR_E7<Traced>, this);
+    prefixHandler[0xE8] = std::bind(&CPULR35902::PR_E8<Traced>, this);
+    prefixHandler[0xE9] = std::bind(&CPULR35902::PR_E9<Traced>, this);
+    prefixHandler[0xEA] = std::bind(&CPULR35902::PR_EA<Traced>, this);
+    prefixHandler[0xEB] = std::bind(&CPULR35902::PR_EB<Traced>, this);
+    prefixHandler[0xEC] = std::bind(&CPULR35902::PR_EC<Traced>, this);
+    prefixHandler[0xED] = std::bind(&CPULR35902::PR_ED<Traced>, this);
+    prefixHandler[0xEE] = std::bind(&CPULR35902::PR_EE<Traced>, this);
+    prefixHandler[0xEF] = std::bind(&CPULR35902::PR_EF<Traced>, this);
+    prefixHandler[0xF0] = std::bind(&CPULR35902::PR_F0<Traced>, this);
+    prefixHandler[0xF1] = std::bind(&CPULR35902::PR_F1<Traced>, this);
+    prefixHandler[0xF2] = std::bind(&CPULR35902::PR_F2<Traced>, this);
+    prefixHandler[0xF3] = std::bind(&CPULR35902::PR_F3<Traced>, this);
+    prefixHandler[0xF4] = std::bind(&CPULR35902::PR_F4<Traced>, this);
+    prefixHandler[0xF5] = std::bind(&CPULR35902::PR_F5<Traced>, this);
+    prefixHandler[0xF6] = std::bind(&CPULR35902::PR_F6<Traced>, this);
+    prefixHandler[0xF7] = std::bind(&CPULR35902::PR_F7<Traced>, this);
+    prefixHandler[0xF8] = std::bind(&CPULR35902::PR_F8<Traced>, this);
+    prefixHandler[0xF9] = std::bind(&CPULR35902::PR_F9<Traced>, this);
+    prefixHandler[0xFA] = std::bind(&CPULR35902::PR_FA<Traced>, this);
+    prefixHandler[0xFB] = std::bind(&CPULR35902::PR_FB<Traced>, this);
+    prefixHandler[0xFC] = std::bind(&CPULR35902::PR_FC<Traced>, this);
+    prefixHandler[0xFD] = std::bind(&CPULR35902::PR_FD<Traced>, this);
+    prefixHandler[0xFE] = std::bind(&CPULR35902::PR_FE<Traced>, this);
+    prefixHandler[0xFF] = std::bind(&CPULR35902::PR_FF<Traced>, this);
+}
+#endif
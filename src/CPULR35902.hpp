@@ -1,13 +1,21 @@
 #pragma once
 
+#include "BlockCache.hpp"
+#include "Recompiler.hpp"
 #include "Utils.hpp"
 
 #include <array>
 #include <cstdint>
+#include <fstream>
 #include <functional>
+#include <limits>
+#include <map>
 #include <string>
+#include <vector>
 
 class Bus;
+class StateReader;
+class StateWriter;
 
 enum Flag {
     Z = 0,
@@ -21,18 +29,129 @@ public:
     CPULR35902(Bus* bus);
     void reset(bool bootRom);
     uint64_t fetchDecodeExecute();
+    // Guest instructions retired, including those run by translated blocks and skipped idle loops
+    uint64_t instructionCount() const { return m_instructionCounter; }
+
+    // Drop pre-decoded code after it has been overwritten or banked out
+    void invalidateCode([[maybe_unused]] uint16_t addr)
+    {
+#ifdef TAMEBOY_BLOCK_CACHE
+        if (m_blockCache.invalidate(addr)) {
+            m_cursor = m_cursorEnd = nullptr;
+        }
+#endif
+    }
+
+    void flushCode([[maybe_unused]] uint16_t first, [[maybe_unused]] uint16_t last)
+    {
+#ifdef TAMEBOY_BLOCK_CACHE
+        if (m_blockCache.flush(first, last)) {
+            m_cursor = m_cursorEnd = nullptr;
+        }
+#endif
+    }
+
+    // The next fetch goes back through the cache, e.g. once OAM DMA cuts the CPU off from ROM
+    void restartFetch()
+    {
+#ifdef TAMEBOY_BLOCK_CACHE
+        m_cursor = m_cursorEnd = nullptr;
+#endif
+    }
+
+    // Cartridge banks moved, translated code also has to read ROM through the new windows
+    void remapCode(uint16_t first, uint16_t last)
+    {
+        flushCode(first, last);
+#ifdef TAMEBOY_RECOMPILER
+        m_recompiler.mapPages();
+#endif
+    }
+
+    // Repeats every translated run on the interpreter and throws on a difference, false without the recompiler
+    bool setLockstep([[maybe_unused]] bool enabled)
+    {
+#ifdef TAMEBOY_RECOMPILER
+        m_lockstep = enabled;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    uint64_t lockstepChecks() const
+    {
+#ifdef TAMEBOY_RECOMPILER
+        return m_recompiler.blocksVerified();
+#else
+        return 0;
+#endif
+    }
+
+    // Nothing executes until an interrupt (or joypad input after STOP) wakes the core
+    bool isHalted() const { return m_halt || m_stop; }
+
+    // Registers with F brought up to date. Loading drops the decoded instruction stream, the bus flushes the code itself.
+    void saveState(StateWriter& state);
+    void loadState(StateReader& state);
+    // AF, BC, DE, HL, SP and PC with F brought up to date
+    std::array<uint16_t, 6> registers();
+
+#ifdef TAMEBOY_IDLE_LOOPS
+    static constexpr size_t maxIdleReads = 4;
+
+    // One pass through a guest loop that only waits for memory to change
+    struct IdleLoop {
+        uint16_t pc{};
+        uint32_t cycles{};
+        uint32_t instructions{};
+        std::array<uint16_t, maxIdleReads> reads{}; // the bytes it polls
+        size_t readCount{};
+    };
+
+    // Set while execute() is stopped at the head of a confirmed idle loop, skipIdleLoop resumes it
+    const IdleLoop* idleLoop() const { return m_idleLoopPending ? &m_idleLoop : nullptr; }
+    void skipIdleLoop(uint64_t iterations);
+#endif
+
+    void printBlockCacheStats();
+    void printFlagStats();
+    void printIdleLoopStats();
  
 private:
+    uint8_t fetch8();
+    uint16_t fetch16();
     uint16_t read16(uint16_t addr);
     void write16(uint16_t addr, uint16_t value);
     void setFlags(int Z, int N, int H, int C);
     bool getFlag(Flag flag);
-    void initOpcodeHandlers();
-    void processInterrupts();
+    void materializeFlags();
+    void discardFlags();
+    void add8(uint8_t value, uint8_t carry = 0);
+    void sub8(uint8_t value, uint8_t carry = 0);
+    void cp8(uint8_t value);
+    void and8(uint8_t value);
+    void xor8(uint8_t value);
+    void or8(uint8_t value);
+    uint8_t inc8(uint8_t value);
+    uint8_t dec8(uint8_t value);
+    // Traced instantiations log every instruction and are only reachable from the debugger
+    template<bool Traced> uint64_t execute();
+    template<bool Traced> void executeInstruction();
+#ifdef TAMEBOY_SWITCH_DISPATCH
+    template<bool Traced> void dispatch(uint8_t opcode);
+    template<bool Traced> void dispatchPrefix(uint8_t opcode);
+#else
+    using HandlerTable = std::array<std::function<void()>, 256>;
+    template<bool Traced> void initOpcodeHandlers(HandlerTable& opcodeHandler, HandlerTable& prefixHandler);
+#endif
+    template<bool Traced> void processInterrupts();
 
     void logInstruction(std::string str, bool newLine = true);
     std::string toHexString(int value);
+#ifdef TAMEBOY_DEBUGGER
     void processDebugger();
+#endif
     void printState();
     void printOam();
     void logTrace();
@@ -58,526 +177,604 @@ private:
     bool m_interruptMasterEnable = false;
     Bus* m_bus;
 
-    std::array<std::function<void()>, 256> m_opcodeHandler;
-    std::array<std::function<void()>, 256> m_prefixHandler;
+#ifndef TAMEBOY_SWITCH_DISPATCH
+    HandlerTable m_opcodeHandler;
+    HandlerTable m_prefixHandler;
+#ifdef TAMEBOY_DEBUGGER
+    HandlerTable m_tracedOpcodeHandler;
+    HandlerTable m_tracedPrefixHandler;
+#endif
+#endif
+
+#ifdef TAMEBOY_BLOCK_CACHE
+    uint8_t fetchOpcode();
+
+    BlockCache m_blockCache;
+    const DecodedInstruction* m_cursor{};
+    const DecodedInstruction* m_cursorEnd{};
+    std::array<uint8_t, 2> m_operands{};
+    uint8_t m_operandIndex{};
+#endif
+
+#ifdef TAMEBOY_IDLE_LOOPS
+    bool trackIdleLoop(const Block& block);
+
+    // Guest state at the previous entry into a candidate loop
+    struct IdleLoopSnapshot {
+        uint16_t pc{};
+        std::array<uint16_t, 5> registers{};
+        std::array<uint8_t, maxIdleReads> values{};
+        uint64_t T{};
+        uint64_t instructions{};
+        bool valid{};
+    };
+
+    struct IdleLoopStats {
+        std::vector<uint16_t> reads{};
+        uint64_t detections{};
+        uint64_t skips{};
+        uint64_t iterations{};
+        uint64_t cycles{};
+    };
+
+    IdleLoop m_idleLoop{};
+    IdleLoopSnapshot m_idleSnapshot{};
+    bool m_idleLoopPending = false;
+    bool m_idleLoopDecided = false;
+    bool m_idleLoopSkipping = true;
+    std::map<uint16_t, IdleLoopStats> m_idleLoopStats{};
+#endif
+
+#ifdef TAMEBOY_RECOMPILER
+    uint64_t runRecompiled(Block& block);
+    void verifyRecompiled(const RecompilerState& native, uint32_t cycles);
+
+    Recompiler m_recompiler;
+    bool m_lockstep = false;
+    std::vector<uint8_t> m_lockstepMemory{};
+    std::vector<uint8_t> m_nativeMemory{};
+#endif
+
+#ifdef TAMEBOY_LAZY_FLAGS
+    // The last ALU operation, Z/N/H/C in F are stale until something reads them
+    enum class FlagOp : uint8_t { None, Add, Sub, And, Or, Inc, Dec };
+    struct LazyFlags {
+        FlagOp op = FlagOp::None;
+        uint8_t lhs{};
+        uint8_t rhs{};
+        uint16_t result{}; // bit 8 is the carry out, or the C kept by INC/DEC
+    };
+
+    void deferFlags(FlagOp op, uint8_t lhs, uint8_t rhs, uint16_t result);
+    uint16_t pendingCarry() const;
+    uint8_t evaluateFlags() const;
+
+    LazyFlags m_lazyFlags{};
+#ifdef TAMEBOY_BENCHMARK
+    uint64_t m_flagsDeferred{};
+    uint64_t m_flagsEvaluated{};
+#endif
+#endif
 
     bool m_debug = false;
+    bool m_debuggerHelpShown = false;
     bool m_pcSearch = false;
+    std::ofstream m_traceLog{}; // opened on the first traced instruction
     uint64_t m_instructionCounter{};
     uint64_t m_instructionCountOfInterest{std::numeric_limits<uint64_t>::max()};
     uint64_t m_pcOfInterest{std::numeric_limits<uint64_t>::max()};
 
-    void OP_00();
-    void OP_01();
-    void OP_02();
-    void OP_03();
-    void OP_04();
-    void OP_05();
-    void OP_06();
-    void OP_07();
-    void OP_08();
-    void OP_09();
-    void OP_0A();
-    void OP_0B();
-    void OP_0C();
-    void OP_0D();
-    void OP_0E();
-    void OP_0F();
-    void OP_10();
-    void OP_11();
-    void OP_12();
-    void OP_13();
-    void OP_14();
-    void OP_15();
-    void OP_16();
-    void OP_17();
-    void OP_18();
-    void OP_19();
-    void OP_1A();
-    void OP_1B();
-    void OP_1C();
-    void OP_1D();
-    void OP_1E();
-    void OP_1F();
-    void OP_20();
-    void OP_21();
-    void OP_22();
-    void OP_23();
-    void OP_24();
-    void OP_25();
-    void OP_26();
-    void OP_27();
-    void OP_28();
-    void OP_29();
-    void OP_2A();
-    void OP_2B();
-    void OP_2C();
-    void OP_2D();
-    void OP_2E();
-    void OP_2F();
-    void OP_30();
-    void OP_31();
-    void OP_32();
-    void OP_33();
-    void OP_34();
-    void OP_35();
-    void OP_36();
-    void OP_37();
-    void OP_38();
-    void OP_39();
-    void OP_3A();
-    void OP_3B();
-    void OP_3C();
-    void OP_3D();
-    void OP_3E();
-    void OP_3F();
-    void OP_40();
-    void OP_41();
-    void OP_42();
-    void OP_43();
-    void OP_44();
-    void OP_45();
-    void OP_46();
-    void OP_47();
-    void OP_48();
-    void OP_49();
-    void OP_4A();
-    void OP_4B();
-    void OP_4C();
-    void OP_4D();
-    void OP_4E();
-    void OP_4F();
-    void OP_50();
-    void OP_51();
-    void OP_52();
-    void OP_53();
-    void OP_54();
-    void OP_55();
-    void OP_56();
-    void OP_57();
-    void OP_58();
-    void OP_59();
-    void OP_5A();
-    void OP_5B();
-    void OP_5C();
-    void OP_5D();
-    void OP_5E();
-    void OP_5F();
-    void OP_60();
-    void OP_61();
-    void OP_62();
-    void OP_63();
-    void OP_64();
-    void OP_65();
-    void OP_66();
-    void OP_67();
-    void OP_68();
-    void OP_69();
-    void OP_6A();
-    void OP_6B();
-    void OP_6C();
-    void OP_6D();
-    void OP_6E();
-    void OP_6F();
-    void OP_70();
-    void OP_71();
-    void OP_72();
-    void OP_73();
-    void OP_74();
-    void OP_75();
-    void OP_76();
-    void OP_77();
-    void OP_78();
-    void OP_79();
-    void OP_7A();
-    void OP_7B();
-    void OP_7C();
-    void OP_7D();
-    void OP_7E();
-    void OP_7F();
-    void OP_80();
-    void OP_81();
-    void OP_82();
-    void OP_83();
-    void OP_84();
-    void OP_85();
-    void OP_86();
-    void OP_87();
-    void OP_88();
-    void OP_89();
-    void OP_8A();
-    void OP_8B();
-    void OP_8C();
-    void OP_8D();
-    void OP_8E();
-    void OP_8F();
-    void OP_90();
-    void OP_91();
-    void OP_92();
-    void OP_93();
-    void OP_94();
-    void OP_95();
-    void OP_96();
-    void OP_97();
-    void OP_98();
-    void OP_99();
-    void OP_9A();
-    void OP_9B();
-    void OP_9C();
-    void OP_9D();
-    void OP_9E();
-    void OP_9F();
-    void OP_A0();
-    void OP_A1();
-    void OP_A2();
-    void OP_A3();
-    void OP_A4();
-    void OP_A5();
-    void OP_A6();
-    void OP_A7();
-    void OP_A8();
-    void OP_A9();
-    void OP_AA();
-    void OP_AB();
-    void OP_AC();
-    void OP_AD();
-    void OP_AE();
-    void OP_AF();
-    void OP_B0();
-    void OP_B1();
-    void OP_B2();
-    void OP_B3();
-    void OP_B4();
-    void OP_B5();
-    void OP_B6();
-    void OP_B7();
-    void OP_B8();
-    void OP_B9();
-    void OP_BA();
-    void OP_BB();
-    void OP_BC();
-    void OP_BD();
-    void OP_BE();
-    void OP_BF();
-    void OP_C0();
-    void OP_C1();
-    void OP_C2();
-    void OP_C3();
-    void OP_C4();
-    void OP_C5();
-    void OP_C6();
-    void OP_C7();
-    void OP_C8();
-    void OP_C9();
-    void OP_CA();
-    void OP_CB();
-    void OP_CC();
-    void OP_CD();
-    void OP_CE();
-    void OP_CF();
-    void OP_D0();
-    void OP_D1();
-    void OP_D2();
-    void OP_D3();
-    void OP_D4();
-    void OP_D5();
-    void OP_D6();
-    void OP_D7();
-    void OP_D8();
-    void OP_D9();
-    void OP_DA();
-    void OP_DB();
-    void OP_DC();
-    void OP_DD();
-    void OP_DE();
-    void OP_DF();
-    void OP_E0();
-    void OP_E1();
-    void OP_E2();
-    void OP_E3();
-    void OP_E4();
-    void OP_E5();
-    void OP_E6();
-    void OP_E7();
-    void OP_E8();
-    void OP_E9();
-    void OP_EA();
-    void OP_EB();
-    void OP_EC();
-    void OP_ED();
-    void OP_EE();
-    void OP_EF();
-    void OP_F0();
-    void OP_F1();
-    void OP_F2();
-    void OP_F3();
-    void OP_F4();
-    void OP_F5();
-    void OP_F6();
-    void OP_F7();
-    void OP_F8();
-    void OP_F9();
-    void OP_FA();
-    void OP_FB();
-    void OP_FC();
-    void OP_FD();
-    void OP_FE();
-    void OP_FF();
+    template<bool Traced> void OP_00();
+    template<bool Traced> void OP_01();
+    template<bool Traced> void OP_02();
+    template<bool Traced> void OP_03();
+    template<bool Traced> void OP_04();
+    template<bool Traced> void OP_05();
+    template<bool Traced> void OP_06();
+    template<bool Traced> void OP_07();
+    template<bool Traced> void OP_08();
+    template<bool Traced> void OP_09();
+    template<bool Traced> void OP_0A();
+    template<bool Traced> void OP_0B();
+    template<bool Traced> void OP_0C();
+    template<bool Traced> void OP_0D();
+    template<bool Traced> void OP_0E();
+    template<bool Traced> void OP_0F();
+    template<bool Traced> void OP_10();
+    template<bool Traced> void OP_11();
+    template<bool Traced> void OP_12();
+    template<bool Traced> void OP_13();
+    template<bool Traced> void OP_14();
+    template<bool Traced> void OP_15();
+    template<bool Traced> void OP_16();
+    template<bool Traced> void OP_17();
+    template<bool Traced> void OP_18();
+    template<bool Traced> void OP_19();
+    template<bool Traced> void OP_1A();
+    template<bool Traced> void OP_1B();
+    template<bool Traced> void OP_1C();
+    template<bool Traced> void OP_1D();
+    template<bool Traced> void OP_1E();
+    template<bool Traced> void OP_1F();
+    template<bool Traced> void OP_20();
+    template<bool Traced> void OP_21();
+    template<bool Traced> void OP_22();
+    template<bool Traced> void OP_23();
+    template<bool Traced> void OP_24();
+    template<bool Traced> void OP_25();
+    template<bool Traced> void OP_26();
+    template<bool Traced> void OP_27();
+    template<bool Traced> void OP_28();
+    template<bool Traced> void OP_29();
+    template<bool Traced> void OP_2A();
+    template<bool Traced> void OP_2B();
+    template<bool Traced> void OP_2C();
+    template<bool Traced> void OP_2D();
+    template<bool Traced> void OP_2E();
+    template<bool Traced> void OP_2F();
+    template<bool Traced> void OP_30();
+    template<bool Traced> void OP_31();
+    template<bool Traced> void OP_32();
+    template<bool Traced> void OP_33();
+    template<bool Traced> void OP_34();
+    template<bool Traced> void OP_35();
+    template<bool Traced> void OP_36();
+    template<bool Traced> void OP_37();
+    template<bool Traced> void OP_38();
+    template<bool Traced> void OP_39();
+    template<bool Traced> void OP_3A();
+    template<bool Traced> void OP_3B();
+    template<bool Traced> void OP_3C();
+    template<bool Traced> void OP_3D();
+    template<bool Traced> void OP_3E();
+    template<bool Traced> void OP_3F();
+    template<bool Traced> void OP_40();
+    template<bool Traced> void OP_41();
+    template<bool Traced> void OP_42();
+    template<bool Traced> void OP_43();
+    template<bool Traced> void OP_44();
+    template<bool Traced> void OP_45();
+    template<bool Traced> void OP_46();
+    template<bool Traced> void OP_47();
+    template<bool Traced> void OP_48();
+    template<bool Traced> void OP_49();
+    template<bool Traced> void OP_4A();
+    template<bool Traced> void OP_4B();
+    template<bool Traced> void OP_4C();
+    template<bool Traced> void OP_4D();
+    template<bool Traced> void OP_4E();
+    template<bool Traced> void OP_4F();
+    template<bool Traced> void OP_50();
+    template<bool Traced> void OP_51();
+    template<bool Traced> void OP_52();
+    template<bool Traced> void OP_53();
+    template<bool Traced> void OP_54();
+    template<bool Traced> void OP_55();
+    template<bool Traced> void OP_56();
+    template<bool Traced> void OP_57();
+    template<bool Traced> void OP_58();
+    template<bool Traced> void OP_59();
+    template<bool Traced> void OP_5A();
+    template<bool Traced> void OP_5B();
+    template<bool Traced> void OP_5C();
+    template<bool Traced> void OP_5D();
+    template<bool Traced> void OP_5E();
+    template<bool Traced> void OP_5F();
+    template<bool Traced> void OP_60();
+    template<bool Traced> void OP_61();
+    template<bool Traced> void OP_62();
+    template<bool Traced> void OP_63();
+    template<bool Traced> void OP_64();
+    template<bool Traced> void OP_65();
+    template<bool Traced> void OP_66();
+    template<bool Traced> void OP_67();
+    template<bool Traced> void OP_68();
+    template<bool Traced> void OP_69();
+    template<bool Traced> void OP_6A();
+    template<bool Traced> void OP_6B();
+    template<bool Traced> void OP_6C();
+    template<bool Traced> void OP_6D();
+    template<bool Traced> void OP_6E();
+    template<bool Traced> void OP_6F();
+    template<bool Traced> void OP_70();
+    template<bool Traced> void OP_71();
+    template<bool Traced> void OP_72();
+    template<bool Traced> void OP_73();
+    template<bool Traced> void OP_74();
+    template<bool Traced> void OP_75();
+    template<bool Traced> void OP_76();
+    template<bool Traced> void OP_77();
+    template<bool Traced> void OP_78();
+    template<bool Traced> void OP_79();
+    template<bool Traced> void OP_7A();
+    template<bool Traced> void OP_7B();
+    template<bool Traced> void OP_7C();
+    template<bool Traced> void OP_7D();
+    template<bool Traced> void OP_7E();
+    template<bool Traced> void OP_7F();
+    template<bool Traced> void OP_80();
+    template<bool Traced> void OP_81();
+    template<bool Traced> void OP_82();
+    template<bool Traced> void OP_83();
+    template<bool Traced> void OP_84();
+    template<bool Traced> void OP_85();
+    template<bool Traced> void OP_86();
+    template<bool Traced> void OP_87();
+    template<bool Traced> void OP_88();
+    template<bool Traced> void OP_89();
+    template<bool Traced> void OP_8A();
+    template<bool Traced> void OP_8B();
+    template<bool Traced> void OP_8C();
+    template<bool Traced> void OP_8D();
+    template<bool Traced> void OP_8E();
+    template<bool Traced> void OP_8F();
+    template<bool Traced> void OP_90();
+    template<bool Traced> void OP_91();
+    template<bool Traced> void OP_92();
+    template<bool Traced> void OP_93();
+    template<bool Traced> void OP_94();
+    template<bool Traced> void OP_95();
+    template<bool Traced> void OP_96();
+    template<bool Traced> void OP_97();
+    template<bool Traced> void OP_98();
+    template<bool Traced> void OP_99();
+    template<bool Traced> void OP_9A();
+    template<bool Traced> void OP_9B();
+    template<bool Traced> void OP_9C();
+    template<bool Traced> void OP_9D();
+    template<bool Traced> void OP_9E();
+    template<bool Traced> void OP_9F();
+    template<bool Traced> void OP_A0();
+    template<bool Traced> void OP_A1();
+    template<bool Traced> void OP_A2();
+    template<bool Traced> void OP_A3();
+    template<bool Traced> void OP_A4();
+    template<bool Traced> void OP_A5();
+    template<bool Traced> void OP_A6();
+    template<bool Traced> void OP_A7();
+    template<bool Traced> void OP_A8();
+    template<bool Traced> void OP_A9();
+    template<bool Traced> void OP_AA();
+    template<bool Traced> void OP_AB();
+    template<bool Traced> void OP_AC();
+    template<bool Traced> void OP_AD();
+    template<bool Traced> void OP_AE();
+    template<bool Traced> void OP_AF();
+    template<bool Traced> void OP_B0();
+    template<bool Traced> void OP_B1();
+    template<bool Traced> void OP_B2();
+    template<bool Traced> void OP_B3();
+    template<bool Traced> void OP_B4();
+    template<bool Traced> void OP_B5();
+    template<bool Traced> void OP_B6();
+    template<bool Traced> void OP_B7();
+    template<bool Traced> void OP_B8();
+    template<bool Traced> void OP_B9();
+    template<bool Traced> void OP_BA();
+    template<bool Traced> void OP_BB();
+    template<bool Traced> void OP_BC();
+    template<bool Traced> void OP_BD();
+    template<bool Traced> void OP_BE();
+    template<bool Traced> void OP_BF();
+    template<bool Traced> void OP_C0();
+    template<bool Traced> void OP_C1();
+    template<bool Traced> void OP_C2();
+    template<bool Traced> void OP_C3();
+    template<bool Traced> void OP_C4();
+    template<bool Traced> void OP_C5();
+    template<bool Traced> void OP_C6();
+    template<bool Traced> void OP_C7();
+    template<bool Traced> void OP_C8();
+    template<bool Traced> void OP_C9();
+    template<bool Traced> void OP_CA();
+    template<bool Traced> void OP_CB();
+    template<bool Traced> void OP_CC();
+    template<bool Traced> void OP_CD();
+    template<bool Traced> void OP_CE();
+    template<bool Traced> void OP_CF();
+    template<bool Traced> void OP_D0();
+    template<bool Traced> void OP_D1();
+    template<bool Traced> void OP_D2();
+    template<bool Traced> void OP_D3();
+    template<bool Traced> void OP_D4();
+    template<bool Traced> void OP_D5();
+    template<bool Traced> void OP_D6();
+    template<bool Traced> void OP_D7();
+    template<bool Traced> void OP_D8();
+    template<bool Traced> void OP_D9();
+    template<bool Traced> void OP_DA();
+    template<bool Traced> void OP_DB();
+    template<bool Traced> void OP_DC();
+    template<bool Traced> void OP_DD();
+    template<bool Traced> void OP_DE();
+    template<bool Traced> void OP_DF();
+    template<bool Traced> void OP_E0();
+    template<bool Traced> void OP_E1();
+    template<bool Traced> void OP_E2();
+    template<bool Traced> void OP_E3();
+    template<bool Traced> void OP_E4();
+    template<bool Traced> void OP_E5();
+    template<bool Traced> void OP_E6();
+    template<bool Traced> void OP_E7();
+    template<bool Traced> void OP_E8();
+    template<bool Traced> void OP_E9();
+    template<bool Traced> void OP_EA();
+    template<bool Traced> void OP_EB();
+    template<bool Traced> void OP_EC();
+    template<bool Traced> void OP_ED();
+    template<bool Traced> void OP_EE();
+    template<bool Traced> void OP_EF();
+    template<bool Traced> void OP_F0();
+    template<bool Traced> void OP_F1();
+    template<bool Traced> void OP_F2();
+    template<bool Traced> void OP_F3();
+    template<bool Traced> void OP_F4();
+    template<bool Traced> void OP_F5();
+    template<bool Traced> void OP_F6();
+    template<bool Traced> void OP_F7();
+    template<bool Traced> void OP_F8();
+    template<bool Traced> void OP_F9();
+    template<bool Traced> void OP_FA();
+    template<bool Traced> void OP_FB();
+    template<bool Traced> void OP_FC();
+    template<bool Traced> void OP_FD();
+    template<bool Traced> void OP_FE();
+    template<bool Traced> void OP_FF();
     
-    void PR_00();
-    void PR_01();
-    void PR_02();
-    void PR_03();
-    void PR_04();
-    void PR_05();
-    void PR_06();
-    void PR_07();
-    void PR_08();
-    void PR_09();
-    void PR_0A();
-    void PR_0B();
-    void PR_0C();
-    void PR_0D();
-    void PR_0E();
-    void PR_0F();
-    void PR_10();
-    void PR_11();
-    void PR_12();
-    void PR_13();
-    void PR_14();
-    void PR_15();
-    void PR_16();
-    void PR_17();
-    void PR_18();
-    void PR_19();
-    void PR_1A();
-    void PR_1B();
-    void PR_1C();
-    void PR_1D();
-    void PR_1E();
-    void PR_1F();
-    void PR_20();
-    void PR_21();
-    void PR_22();
-    void PR_23();
-    void PR_24();
-    void PR_25();
-    void PR_26();
-    void PR_27();
-    void PR_28();
-    void PR_29();
-    void PR_2A();
-    void PR_2B();
-    void PR_2C();
-    void PR_2D();
-    void PR_2E();
-    void PR_2F();
-    void PR_30();
-    void PR_31();
-    void PR_32();
-    void PR_33();
-    void PR_34();
-    void PR_35();
-    void PR_36();
-    void PR_37();
-    void PR_38();
-    void PR_39();
-    void PR_3A();
-    void PR_3B();
-    void PR_3C();
-    void PR_3D();
-    void PR_3E();
-    void PR_3F();
-    void PR_40();
-    void PR_41();
-    void PR_42();
-    void PR_43();
-    void PR_44();
-    void PR_45();
-    void PR_46();
-    void PR_47();
-    void PR_48();
-    void PR_49();
-    void PR_4A();
-    void PR_4B();
-    void PR_4C();
-    void PR_4D();
-    void PR_4E();
-    void PR_4F();
-    void PR_50();
-    void PR_51();
-    void PR_52();
-    void PR_53();
-    void PR_54();
-    void PR_55();
-    void PR_56();
-    void PR_57();
-    void PR_58();
-    void PR_59();
-    void PR_5A();
-    void PR_5B();
-    void PR_5C();
-    void PR_5D();
-    void PR_5E();
-    void PR_5F();
-    void PR_60();
-    void PR_61();
-    void PR_62();
-    void PR_63();
-    void PR_64();
-    void PR_65();
-    void PR_66();
-    void PR_67();
-    void PR_68();
-    void PR_69();
-    void PR_6A();
-    void PR_6B();
-    void PR_6C();
-    void PR_6D();
-    void PR_6E();
-    void PR_6F();
-    void PR_70();
-    void PR_71();
-    void PR_72();
-    void PR_73();
-    void PR_74();
-    void PR_75();
-    void PR_76();
-    void PR_77();
-    void PR_78();
-    void PR_79();
-    void PR_7A();
-    void PR_7B();
-    void PR_7C();
-    void PR_7D();
-    void PR_7E();
-    void PR_7F();
-    void PR_80();
-    void PR_81();
-    void PR_82();
-    void PR_83();
-    void PR_84();
-    void PR_85();
-    void PR_86();
-    void PR_87();
-    void PR_88();
-    void PR_89();
-    void PR_8A();
-    void PR_8B();
-    void PR_8C();
-    void PR_8D();
-    void PR_8E();
-    void PR_8F();
-    void PR_90();
-    void PR_91();
-    void PR_92();
-    void PR_93();
-    void PR_94();
-    void PR_95();
-    void PR_96();
-    void PR_97();
-    void PR_98();
-    void PR_99();
-    void PR_9A();
-    void PR_9B();
-    void PR_9C();
-    void PR_9D();
-    void PR_9E();
-    void PR_9F();
-    void PR_A0();
-    void PR_A1();
-    void PR_A2();
-    void PR_A3();
-    void PR_A4();
-    void PR_A5();
-    void PR_A6();
-    void PR_A7();
-    void PR_A8();
-    void PR_A9();
-    void PR_AA();
-    void PR_AB();
-    void PR_AC();
-    void PR_AD();
-    void PR_AE();
-    void PR_AF();
-    void PR_B0();
-    void PR_B1();
-    void PR_B2();
-    void PR_B3();
-    void PR_B4();
-    void PR_B5();
-    void PR_B6();
-    void PR_B7();
-    void PR_B8();
-    void PR_B9();
-    void PR_BA();
-    void PR_BB();
-    void PR_BC();
-    void PR_BD();
-    void PR_BE();
-    void PR_BF();
-    void PR_C0();
-    void PR_C1();
-    void PR_C2();
-    void PR_C3();
-    void PR_C4();
-    void PR_C5();
-    void PR_C6();
-    void PR_C7();
-    void PR_C8();
-    void PR_C9();
-    void PR_CA();
-    void PR_CB();
-    void PR_CC();
-    void PR_CD();
-    void PR_CE();
-    void PR_CF();
-    void PR_D0();
-    void PR_D1();
-    void PR_D2();
-    void PR_D3();
-    void PR_D4();
-    void PR_D5();
-    void PR_D6();
-    void PR_D7();
-    void PR_D8();
-    void PR_D9();
-    void PR_DA();
-    void PR_DB();
-    void PR_DC();
-    void PR_DD();
-    void PR_DE();
-    void PR_DF();
-    void PR_E0();
-    void PR_E1();
-    void PR_E2();
-    void PR_E3();
-    void PR_E4();
-    void PR_E5();
-    void PR_E6();
-    void PR_E7();
-    void PR_E8();
-    void PR_E9();
-    void PR_EA();
-    void PR_EB();
-    void PR_EC();
-    void PR_ED();
-    void PR_EE();
-    void PR_EF();
-    void PR_F0();
-    void PR_F1();
-    void PR_F2();
-    void PR_F3();
-    void PR_F4();
-    void PR_F5();
-    void PR_F6();
-    void PR_F7();
-    void PR_F8();
-    void PR_F9();
-    void PR_FA();
-    void PR_FB();
-    void PR_FC();
-    void PR_FD();
-    void PR_FE();
-    void PR_FF(); 
+    template<bool Traced> void PR_00();
+    template<bool Traced> void PR_01();
+    template<bool Traced> void PR_02();
+    template<bool Traced> void PR_03();
+    template<bool Traced> void PR_04();
+    template<bool Traced> void PR_05();
+    template<bool Traced> void PR_06();
+    template<bool Traced> void PR_07();
+    template<bool Traced> void PR_08();
+    template<bool Traced> void PR_09();
+    template<bool Traced> void PR_0A();
+    template<bool Traced> void PR_0B();
+    template<bool Traced> void PR_0C();
+    template<bool Traced> void PR_0D();
+    template<bool Traced> void PR_0E();
+    template<bool Traced> void PR_0F();
+    template<bool Traced> void PR_10();
+    template<bool Traced> void PR_11();
+    template<bool Traced> void PR_12();
+    template<bool Traced> void PR_13();
+    template<bool Traced> void PR_14();
+    template<bool Traced> void PR_15();
+    template<bool Traced> void PR_16();
+    template<bool Traced> void PR_17();
+    template<bool Traced> void PR_18();
+    template<bool Traced> void PR_19();
+    template<bool Traced> void PR_1A();
+    template<bool Traced> void PR_1B();
+    template<bool Traced> void PR_1C();
+    template<bool Traced> void PR_1D();
+    template<bool Traced> void PR_1E();
+    template<bool Traced> void PR_1F();
+    template<bool Traced> void PR_20();
+    template<bool Traced> void PR_21();
+    template<bool Traced> void PR_22();
+    template<bool Traced> void PR_23();
+    template<bool Traced> void PR_24();
+    template<bool Traced> void PR_25();
+    template<bool Traced> void PR_26();
+    template<bool Traced> void PR_27();
+    template<bool Traced> void PR_28();
+    template<bool Traced> void PR_29();
+    template<bool Traced> void PR_2A();
+    template<bool Traced> void PR_2B();
+    template<bool Traced> void PR_2C();
+    template<bool Traced> void PR_2D();
+    template<bool Traced> void PR_2E();
+    template<bool Traced> void PR_2F();
+    template<bool Traced> void PR_30();
+    template<bool Traced> void PR_31();
+    template<bool Traced> void PR_32();
+    template<bool Traced> void PR_33();
+    template<bool Traced> void PR_34();
+    template<bool Traced> void PR_35();
+    template<bool Traced> void PR_36();
+    template<bool Traced> void PR_37();
+    template<bool Traced> void PR_38();
+    template<bool Traced> void PR_39();
+    template<bool Traced> void PR_3A();
+    template<bool Traced> void PR_3B();
+    template<bool Traced> void PR_3C();
+    template<bool Traced> void PR_3D();
+    template<bool Traced> void PR_3E();
+    template<bool Traced> void PR_3F();
+    template<bool Traced> void PR_40();
+    template<bool Traced> void PR_41();
+    template<bool Traced> void PR_42();
+    template<bool Traced> void PR_43();
+    template<bool Traced> void PR_44();
+    template<bool Traced> void PR_45();
+    template<bool Traced> void PR_46();
+    template<bool Traced> void PR_47();
+    template<bool Traced> void PR_48();
+    template<bool Traced> void PR_49();
+    template<bool Traced> void PR_4A();
+    template<bool Traced> void PR_4B();
+    template<bool Traced> void PR_4C();
+    template<bool Traced> void PR_4D();
+    template<bool Traced> void PR_4E();
+    template<bool Traced> void PR_4F();
+    template<bool Traced> void PR_50();
+    template<bool Traced> void PR_51();
+    template<bool Traced> void PR_52();
+    template<bool Traced> void PR_53();
+    template<bool Traced> void PR_54();
+    template<bool Traced> void PR_55();
+    template<bool Traced> void PR_56();
+    template<bool Traced> void PR_57();
+    template<bool Traced> void PR_58();
+    template<bool Traced> void PR_59();
+    template<bool Traced> void PR_5A();
+    template<bool Traced> void PR_5B();
+    template<bool Traced> void PR_5C();
+    template<bool Traced> void PR_5D();
+    template<bool Traced> void PR_5E();
+    template<bool Traced> void PR_5F();
+    template<bool Traced> void PR_60();
+    template<bool Traced> void PR_61();
+    template<bool Traced> void PR_62();
+    template<bool Traced> void PR_63();
+    template<bool Traced> void PR_64();
+    template<bool Traced> void PR_65();
+    template<bool Traced> void PR_66();
+    template<bool Traced> void PR_67();
+    template<bool Traced> void PR_68();
+    template<bool Traced> void PR_69();
+    template<bool Traced> void PR_6A();
+    template<bool Traced> void PR_6B();
+    template<bool Traced> void PR_6C();
+    template<bool Traced> void PR_6D();
+    template<bool Traced> void PR_6E();
+    template<bool Traced> void PR_6F();
+    template<bool Traced> void PR_70();
+    template<bool Traced> void PR_71();
+    template<bool Traced> void PR_72();
+    template<bool Traced> void PR_73();
+    template<bool Traced> void PR_74();
+    template<bool Traced> void PR_75();
+    template<bool Traced> void PR_76();
+    template<bool Traced> void PR_77();
+    template<bool Traced> void PR_78();
+    template<bool Traced> void PR_79();
+    template<bool Traced> void PR_7A();
+    template<bool Traced> void PR_7B();
+    template<bool Traced> void PR_7C();
+    template<bool Traced> void PR_7D();
+    template<bool Traced> void PR_7E();
+    template<bool Traced> void PR_7F();
+    template<bool Traced> void PR_80();
+    template<bool Traced> void PR_81();
+    template<bool Traced> void PR_82();
+    template<bool Traced> void PR_83();
+    template<bool Traced> void PR_84();
+    template<bool Traced> void PR_85();
+    template<bool Traced> void PR_86();
+    template<bool Traced> void PR_87();
+    template<bool Traced> void PR_88();
+    template<bool Traced> void PR_89();
+    template<bool Traced> void PR_8A();
+    template<bool Traced> void PR_8B();
+    template<bool Traced> void PR_8C();
+    template<bool Traced> void PR_8D();
+    template<bool Traced> void PR_8E();
+    template<bool Traced> void PR_8F();
+    template<bool Traced> void PR_90();
+    template<bool Traced> void PR_91();
+    template<bool Traced> void PR_92();
+    template<bool Traced> void PR_93();
+    template<bool Traced> void PR_94();
+    template<bool Traced> void PR_95();
+    template<bool Traced> void PR_96();
+    template<bool Traced> void PR_97();
+    template<bool Traced> void PR_98();
+    template<bool Traced> void PR_99();
+    template<bool Traced> void PR_9A();
+    template<bool Traced> void PR_9B();
+    template<bool Traced> void PR_9C();
+    template<bool Traced> void PR_9D();
+    template<bool Traced> void PR_9E();
+    template<bool Traced> void PR_9F();
+    template<bool Traced> void PR_A0();
+    template<bool Traced> void PR_A1();
+    template<bool Traced> void PR_A2();
+    template<bool Traced> void PR_A3();
+    template<bool Traced> void PR_A4();
+    template<bool Traced> void PR_A5();
+    template<bool Traced> void PR_A6();
+    template<bool Traced> void PR_A7();
+    template<bool Traced> void PR_A8();
+    template<bool Traced> void PR_A9();
+    template<bool Traced> void PR_AA();
+    template<bool Traced> void PR_AB();
+    template<bool Traced> void PR_AC();
+    template<bool Traced> void PR_AD();
+    template<bool Traced> void PR_AE();
+    template<bool Traced> void PR_AF();
+    template<bool Traced> void PR_B0();
+    template<bool Traced> void PR_B1();
+    template<bool Traced> void PR_B2();
+    template<bool Traced> void PR_B3();
+    template<bool Traced> void PR_B4();
+    template<bool Traced> void PR_B5();
+    template<bool Traced> void PR_B6();
+    template<bool Traced> void PR_B7();
+    template<bool Traced> void PR_B8();
+    template<bool Traced> void PR_B9();
+    template<bool Traced> void PR_BA();
+    template<bool Traced> void PR_BB();
+    template<bool Traced> void PR_BC();
+    template<bool Traced> void PR_BD();
+    template<bool Traced> void PR_BE();
+    template<bool Traced> void PR_BF();
+    template<bool Traced> void PR_C0();
+    template<bool Traced> void PR_C1();
+    template<bool Traced> void PR_C2();
+    template<bool Traced> void PR_C3();
+    template<bool Traced> void PR_C4();
+    template<bool Traced> void PR_C5();
+    template<bool Traced> void PR_C6();
+    template<bool Traced> void PR_C7();
+    template<bool Traced> void PR_C8();
+    template<bool Traced> void PR_C9();
+    template<bool Traced> void PR_CA();
+    template<bool Traced> void PR_CB();
+    template<bool Traced> void PR_CC();
+    template<bool Traced> void PR_CD();
+    template<bool Traced> void PR_CE();
+    template<bool Traced> void PR_CF();
+    template<bool Traced> void PR_D0();
+    template<bool Traced> void PR_D1();
+    template<bool Traced> void PR_D2();
+    template<bool Traced> void PR_D3();
+    template<bool Traced> void PR_D4();
+    template<bool Traced> void PR_D5();
+    template<bool Traced> void PR_D6();
+    template<bool Traced> void PR_D7();
+    template<bool Traced> void PR_D8();
+    template<bool Traced> void PR_D9();
+    template<bool Traced> void PR_DA();
+    template<bool Traced> void PR_DB();
+    template<bool Traced> void PR_DC();
+    template<bool Traced> void PR_DD();
+    template<bool Traced> void PR_DE();
+    template<bool Traced> void PR_DF();
+    template<bool Traced> void PR_E0();
+    template<bool Traced> void PR_E1();
+    template<bool Traced> void PR_E2();
+    template<bool Traced> void PR_E3();
+    template<bool Traced> void PR_E4();
+    template<bool Traced> void PR_E5();
+    template<bool Traced> void PR_E6();
+    template<bool Traced> void PR_E7();
+    template<bool Traced> void PR_E8();
+    template<bool Traced> void PR_E9();
+    template<bool Traced> void PR_EA();
+    template<bool Traced> void PR_EB();
+    template<bool Traced> void PR_EC();
+    template<bool Traced> void PR_ED();
+    template<bool Traced> void PR_EE();
+    template<bool Traced> void PR_EF();
+    template<bool Traced> void PR_F0();
+    template<bool Traced> void PR_F1();
+    template<bool Traced> void PR_F2();
+    template<bool Traced> void PR_F3();
+    template<bool Traced> void PR_F4();
+    template<bool Traced> void PR_F5();
+    template<bool Traced> void PR_F6();
+    template<bool Traced> void PR_F7();
+    template<bool Traced> void PR_F8();
+    template<bool Traced> void PR_F9();
+    template<bool Traced> void PR_FA();
+    template<bool Traced> void PR_FB();
+    template<bool Traced> void PR_FC();
+    template<bool Traced> void PR_FD();
+    template<bool Traced> void PR_FE();
+    template<bool Traced> void PR_FF(); 
 };
@@ -0,0 +1,378 @@
+#include "Cartridge.hpp"
+
+#include "SaveState.hpp"
+
+#include <algorithm>
+#include <array>
+#include <ctime>
+#include <filesystem>
+#include <stdexcept>
+
+void Cartridge::load(const char* filename, bool saveFile)
+{
+    m_file = MappedFile(filename);
+    m_rom = m_file.data();
+    if (m_file.size() < 0x150) {
+        throw std::runtime_error("ROM file too small for a cartridge header!");
+    }
+
+    parseHeader();
+    if (m_battery && saveFile) {
+        openSave(filename);
+    }
+    else if (m_clock) {
+        m_clockTime = static_cast<int64_t>(std::time(nullptr));
+    }
+}
+
+Cartridge::~Cartridge()
+{
+    if (m_clock && hasSave()) {
+        storeClock();
+    }
+}
+
+void Cartridge::parseHeader()
+{
+    const auto type = m_rom[0x147];
+    switch (type) {
+        case 0x00: case 0x08: case 0x09: m_mbc = Mbc::None; break;
+        case 0x01: case 0x02: case 0x03: m_mbc = Mbc::MBC1; break;
+        case 0x05: case 0x06: m_mbc = Mbc::MBC2; break;
+        case 0x0F: case 0x10: case 0x11: case 0x12: case 0x13: m_mbc = Mbc::MBC3; break;
+        case 0x19: case 0x1A: case 0x1B: case 0x1C: case 0x1D: case 0x1E: m_mbc = Mbc::MBC5; break;
+        default: throw std::runtime_error("Unsupported cartridge type!");
+    }
+    switch (type) {
+        case 0x03: case 0x06: case 0x09: case 0x0F: case 0x10: case 0x13: case 0x1B: case 0x1E: m_battery = true; break;
+        default: break;
+    }
+    m_clock = (type == 0x0F || type == 0x10);
+
+    const auto romSize = m_rom[0x148];
+    if (romSize > 8) {
+        throw std::runtime_error("Bad ROM size in cartridge header!");
+    }
+    m_romBanks = std::max<size_t>(size_t{ 2 } << romSize, (m_file.size() + romBankSize - 1) / romBankSize);
+    // Windows can't point past the end of the mapping, only short dumps get a padded private copy
+    if (m_file.size() != m_romBanks * romBankSize) {
+        m_paddedRom.assign(m_file.data(), m_file.data() + m_file.size());
+        m_paddedRom.resize(m_romBanks * romBankSize, 0xFF);
+        m_rom = m_paddedRom.data();
+    }
+
+    constexpr std::array<size_t, 6> ramSizes{ 0, 0x800, 0x2000, 0x8000, 0x20000, 0x10000 };
+    const auto ramSize = m_rom[0x149];
+    if (ramSize >= ramSizes.size()) {
+        throw std::runtime_error("Bad RAM size in cartridge header!");
+    }
+    if (m_mbc == Mbc::MBC2) {
+        m_ramBuffer.assign(0x200, 0xFF); // 512 x 4 bits built into the controller
+    }
+    else {
+        m_ramBuffer.assign(ramSizes[ramSize], 0xFF);
+    }
+    m_ram = m_ramBuffer.data();
+    m_ramSize = m_ramBuffer.size();
+    m_ramBanks = (m_ramSize + ramBankSize - 1) / ramBankSize;
+    m_ramEnable = (m_mbc == Mbc::None);
+
+    updateBanks();
+}
+
+// The save sits next to the ROM with a .sav extension: the RAM image followed by the clock trailer
+void Cartridge::openSave(const char* romFilename)
+{
+    const auto size = m_ramSize + (m_clock ? clockTrailerSize : 0);
+    if (!size) {
+        return;
+    }
+
+    const auto filename = std::filesystem::path(romFilename).replace_extension(".sav").string();
+    m_save = MappedFile(filename.c_str(), size);
+    if (m_ramSize) {
+        m_ram = m_save.writableData();
+        m_ramBuffer.clear();
+    }
+    m_dirty.assign((size + syncBlock - 1) / syncBlock, 0);
+    if (m_clock) {
+        loadClock();
+    }
+    updateBanks();
+}
+
+bool Cartridge::flushSave()
+{
+    if (m_clock) {
+        storeClock();
+    }
+
+    bool flushed = false;
+    for (size_t block = 0; block < m_dirty.size(); ++block) {
+        if (!m_dirty[block]) {
+            continue;
+        }
+        // Runs of dirty blocks go out as one range
+        auto end = block + 1;
+        while (end < m_dirty.size() && m_dirty[end]) {
+            m_dirty[end++] = 0;
+        }
+        m_dirty[block] = 0;
+        const auto offset = block * syncBlock;
+        m_save.flush(offset, std::min(end * syncBlock, m_save.size()) - offset);
+        block = end;
+        flushed = true;
+    }
+    return flushed;
+}
+
+void Cartridge::saveState(StateWriter& state) const
+{
+    state.put(static_cast<uint16_t>((m_rom[0x14E] << 8) | m_rom[0x14F])); // global checksum
+    state.put(static_cast<uint32_t>(m_ramSize));
+    state.put(m_ramEnable);
+    state.put(m_romBank);
+    state.put(m_ramBank);
+    state.put(m_bankingMode);
+    state.put(m_ram, m_ramSize);
+    state.put(m_clockRegisters);
+    state.put(m_latchedClock);
+    state.put(m_clockTime);
+    state.put(m_latch);
+}
+
+void Cartridge::checkState(StateReader& state) const
+{
+    if (state.get<uint16_t>() != ((m_rom[0x14E] << 8) | m_rom[0x14F]) || state.get<uint32_t>() != m_ramSize) {
+        throw std::runtime_error("Save state is for a different cartridge!");
+    }
+}
+
+void Cartridge::loadState(StateReader& state)
+{
+    state.get(m_ramEnable);
+    state.get(m_romBank);
+    state.get(m_ramBank);
+    state.get(m_bankingMode);
+    state.get(m_ram, m_ramSize);
+    state.get(m_clockRegisters);
+    state.get(m_latchedClock);
+    state.get(m_clockTime);
+    state.get(m_latch);
+
+    std::fill(m_dirty.begin(), m_dirty.end(), uint8_t{ 1 });
+    updateBanks();
+}
+
+bool Cartridge::write(uint16_t addr, uint8_t value)
+{
+    const auto romOffset0 = m_romOffset0;
+    const auto romOffset1 = m_romOffset1;
+    const auto ramOffset = m_ramOffset;
+    const auto ramMapped = m_ramMapped;
+
+    const auto ramEnable = (value & 0x0F) == 0x0A;
+    switch (m_mbc) {
+        case Mbc::None: {
+            return false;
+        }
+        case Mbc::MBC1: {
+            if (addr < 0x2000) { m_ramEnable = ramEnable; }
+            else if (addr < 0x4000) { m_romBank = value & 0x1F; }
+            else if (addr < 0x6000) { m_ramBank = value & 0x03; }
+            else { m_bankingMode = value & 0x01; }
+            break;
+        }
+        case Mbc::MBC2: {
+            if (addr >= 0x4000) {
+                return false;
+            }
+            if (addr & 0x0100) { m_romBank = value & 0x0F; } // address bit 8 selects the register
+            else { m_ramEnable = ramEnable; }
+            break;
+        }
+        case Mbc::MBC3: {
+            if (addr < 0x2000) { m_ramEnable = ramEnable; }
+            else if (addr < 0x4000) { m_romBank = value & 0x7F; }
+            else if (addr < 0x6000) { m_ramBank = value; } // 0x08-0x0C select the clock registers
+            else {
+                // writing 0 then 1 copies the running clock into the readable registers
+                if (m_clock && m_latch == 0x00 && value == 0x01) {
+                    updateClock();
+                    m_latchedClock = m_clockRegisters;
+                }
+                m_latch = value;
+            }
+            break;
+        }
+        case Mbc::MBC5: {
+            if (addr < 0x2000) { m_ramEnable = ramEnable; }
+            else if (addr < 0x3000) { m_romBank = (m_romBank & 0x100) | value; }
+            else if (addr < 0x4000) { m_romBank = (m_romBank & 0x0FF) | ((value & 0x01) << 8); }
+            else if (addr < 0x6000) { m_ramBank = value & 0x0F; }
+            break;
+        }
+    }
+
+    updateBanks();
+    return romOffset0 != m_romOffset0 || romOffset1 != m_romOffset1 || ramOffset != m_ramOffset || ramMapped != m_ramMapped;
+}
+
+void Cartridge::updateBanks()
+{
+    size_t bank0 = 0;
+    size_t bank1 = 1;
+    size_t ramBank = 0;
+    switch (m_mbc) {
+        case Mbc::None: {
+            break;
+        }
+        case Mbc::MBC1: {
+            // Bank 0 can't be selected in the low 5 bits, mode 1 also banks 0x0000-0x3FFF and RAM
+            bank1 = (m_ramBank << 5) | std::max(m_romBank & 0x1F, 1);
+            if (m_bankingMode) {
+                bank0 = m_ramBank << 5;
+                ramBank = m_ramBank;
+            }
+            break;
+        }
+        case Mbc::MBC2: {
+            bank1 = std::max(m_romBank & 0x0F, 1);
+            break;
+        }
+        case Mbc::MBC3: {
+            bank1 = std::max(m_romBank & 0x7F, 1);
+            ramBank = m_ramBank;
+            break;
+        }
+        case Mbc::MBC5: {
+            bank1 = m_romBank;
+            ramBank = m_ramBank;
+            break;
+        }
+    }
+
+    m_romOffset0 = (bank0 % m_romBanks) * romBankSize;
+    m_romOffset1 = (bank1 % m_romBanks) * romBankSize;
+    m_ramMapped = m_ramEnable && m_ramSize && !(m_mbc == Mbc::MBC3 && m_ramBank > 0x03);
+    m_ramOffset = m_ramBanks ? (ramBank % m_ramBanks) * ramBankSize : 0;
+}
+
+// RAM smaller than a bank, like 2 KiB chips and the MBC2 nibbles, repeats over 0xA000-0xBFFF
+size_t Cartridge::ramIndex(uint16_t addr) const
+{
+    return (m_ramOffset + (addr - 0xA000)) % m_ramSize;
+}
+
+const uint8_t* Cartridge::readPage(uint8_t page) const
+{
+    if (page < 0x40) {
+        return m_rom + m_romOffset0 + (page << 8);
+    }
+    if (page < 0x80) {
+        return m_rom + m_romOffset1 + ((page - 0x40) << 8);
+    }
+    if (page >= 0xA0 && page < 0xC0 && m_ramMapped) {
+        return m_ram + ramIndex(page << 8);
+    }
+    return nullptr;
+}
+
+uint8_t* Cartridge::writePage(uint8_t page)
+{
+    // MBC2 only stores the low nibble, its writes go through writeRam
+    if (page < 0xA0 || page >= 0xC0 || !m_ramMapped || m_mbc == Mbc::MBC2) {
+        return nullptr;
+    }
+    const auto index = ramIndex(page << 8);
+    if (!m_dirty.empty() && !m_dirty[index / syncBlock]) {
+        return nullptr; // clean save RAM, the first write marks it dirty
+    }
+    return m_ram + index;
+}
+
+uint8_t Cartridge::readRam(uint16_t addr) const
+{
+    if (clockSelected()) {
+        return m_latchedClock[m_ramBank - 0x08];
+    }
+    return m_ramMapped ? m_ram[ramIndex(addr)] : 0xFF;
+}
+
+void Cartridge::writeRam(uint16_t addr, uint8_t value)
+{
+    if (clockSelected()) {
+        constexpr std::array<uint8_t, 5> writable{ 0x3F, 0x3F, 0x1F, 0xFF, 0xC1 };
+        const auto reg = m_ramBank - 0x08;
+        updateClock();
+        m_clockRegisters[reg] = value & writable[reg];
+        return;
+    }
+    if (!m_ramMapped) {
+        return;
+    }
+    const auto index = ramIndex(addr);
+    m_ram[index] = (m_mbc == Mbc::MBC2) ? (value | 0xF0) : value;
+    markDirty(index);
+}
+
+// The clock runs on host time, also while the emulator is not running
+void Cartridge::updateClock()
+{
+    const auto now = static_cast<int64_t>(std::time(nullptr));
+    const auto elapsed = now - m_clockTime;
+    m_clockTime = now;
+    if (elapsed <= 0 || (m_clockRegisters[4] & 0x40)) { // halted
+        return;
+    }
+
+    auto days = static_cast<int64_t>(((m_clockRegisters[4] & 0x01) << 8) | m_clockRegisters[3]);
+    const auto total = m_clockRegisters[0] + m_clockRegisters[1] * 60 + m_clockRegisters[2] * 3600 + days * 86400 + elapsed;
+    m_clockRegisters[0] = static_cast<uint8_t>(total % 60);
+    m_clockRegisters[1] = static_cast<uint8_t>(total / 60 % 60);
+    m_clockRegisters[2] = static_cast<uint8_t>(total / 3600 % 24);
+    days = total / 86400;
+    if (days > 0x1FF) {
+        m_clockRegisters[4] |= 0x80; // day counter carry
+        days &= 0x1FF;
+    }
+    m_clockRegisters[3] = static_cast<uint8_t>(days);
+    m_clockRegisters[4] = static_cast<uint8_t>((m_clockRegisters[4] & 0xFE) | (days >> 8));
+}
+
+void Cartridge::loadClock()
+{
+    const auto* trailer = m_save.data() + m_ramSize;
+    const auto field = [trailer](size_t offset, size_t bytes) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < bytes; ++i) {
+            value |= uint64_t(trailer[offset + i]) << (8 * i);
+        }
+        return value;
+    };
+    for (size_t i = 0; i < 5; ++i) {
+        m_clockRegisters[i] = static_cast<uint8_t>(field(4 * i, 4));
+        m_latchedClock[i] = static_cast<uint8_t>(field(20 + 4 * i, 4));
+    }
+    const auto timestamp = static_cast<int64_t>(field(40, 8));
+    m_clockTime = timestamp ? timestamp : static_cast<int64_t>(std::time(nullptr));
+    updateClock();
+}
+
+void Cartridge::storeClock()
+{
+    updateClock();
+    auto* trailer = m_save.writableData() + m_ramSize;
+    const auto field = [trailer](size_t offset, size_t bytes, uint64_t value) {
+        for (size_t i = 0; i < bytes; ++i) {
+            trailer[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    };
+    for (size_t i = 0; i < 5; ++i) {
+        field(4 * i, 4, m_clockRegisters[i]);
+        field(20 + 4 * i, 4, m_latchedClock[i]);
+    }
+    field(40, 8, static_cast<uint64_t>(m_clockTime));
+    markDirty(m_ramSize);
+    markDirty(m_ramSize + clockTrailerSize - 1);
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "MappedFile.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class StateReader;
+class StateWriter;
+
+// ROM image, external RAM and the memory bank controller of a cartridge.
+// The ROM file is mapped read-only and banks are never copied, the bus maps its
+// 0x0000-0x7FFF and 0xA000-0xBFFF pages straight into the image through readPage and writePage.
+// Battery backed RAM and the MBC3 clock live in a shared mapping of the .sav file next to the ROM.
+class Cartridge {
+public:
+    Cartridge() = default;
+    ~Cartridge();
+    Cartridge(const Cartridge&) = delete;
+    Cartridge& operator=(const Cartridge&) = delete;
+
+    // Battery RAM and the clock persist in the .sav next to the ROM unless saveFile is false
+    void load(const char* filename, bool saveFile = true);
+
+    // Host memory behind a 256 byte page of the cartridge ranges, nullptr when the bus has to use a handler
+    const uint8_t* readPage(uint8_t page) const;
+    uint8_t* writePage(uint8_t page);
+
+    // MBC register writes below 0x8000, returns true when a window now points at different memory
+    bool write(uint16_t addr, uint8_t value);
+    uint8_t readRam(uint16_t addr) const;
+    void writeRam(uint16_t addr, uint8_t value);
+
+    const uint8_t* rom() const { return m_rom; }
+
+    // Save RAM pages are only writable through the page table once dirty. flushSave starts
+    // writing back the dirty blocks and returns true if the bus has to write protect them again.
+    bool hasSave() const { return m_save.size() != 0; }
+    bool flushSave();
+
+    // Bank registers, RAM and clock behind a header naming the cartridge. checkState reads the
+    // header and throws if the state was taken with another cartridge, loadState reads the rest.
+    void saveState(StateWriter& state) const;
+    void checkState(StateReader& state) const;
+    void loadState(StateReader& state);
+
+    static constexpr size_t romBankSize = 0x4000;
+    static constexpr size_t ramBankSize = 0x2000;
+    static constexpr size_t syncBlock = 0x1000;
+    static constexpr size_t clockTrailerSize = 48; // 5 + 5 little endian uint32 registers and a 64-bit timestamp
+
+private:
+    enum class Mbc {
+        None,
+        MBC1,
+        MBC2,
+        MBC3,
+        MBC5
+    };
+
+    void parseHeader();
+    void openSave(const char* romFilename);
+    void updateBanks();
+    size_t ramIndex(uint16_t addr) const;
+    bool clockSelected() const { return m_clock && m_ramEnable && m_ramBank >= 0x08 && m_ramBank <= 0x0C; }
+    void markDirty(size_t offset) { if (!m_dirty.empty()) m_dirty[offset / syncBlock] = 1; }
+
+    void loadClock();
+    void storeClock();
+    void updateClock();
+
+    MappedFile m_file{};
+    std::vector<uint8_t> m_paddedRom{};
+    const uint8_t* m_rom{};
+    std::vector<uint8_t> m_ramBuffer{}; // RAM without a battery
+    MappedFile m_save{};
+    uint8_t* m_ram{};
+    size_t m_ramSize{};
+    std::vector<uint8_t> m_dirty{}; // per syncBlock of the save file
+    Mbc m_mbc = Mbc::None;
+    bool m_battery = false;
+    bool m_clock = false;
+    size_t m_romBanks = 2;
+    size_t m_ramBanks = 0;
+
+    // registers as written
+    bool m_ramEnable = false;
+    uint16_t m_romBank = 1;
+    uint8_t m_ramBank{}; // MBC1 uses it as the upper ROM bank bits too
+    bool m_bankingMode = false;
+
+    // resulting windows
+    size_t m_romOffset0{};
+    size_t m_romOffset1 = romBankSize;
+    size_t m_ramOffset{};
+    bool m_ramMapped = false;
+
+    // MBC3 clock: seconds, minutes, hours, day low, day high/halt/carry
+    std::array<uint8_t, 5> m_clockRegisters{};
+    std::array<uint8_t, 5> m_latchedClock{};
+    int64_t m_clockTime{}; // host time the registers were last brought up to
+    uint8_t m_latch = 0xFF;
+};
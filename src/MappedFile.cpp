@@ -0,0 +1,140 @@
+#include "MappedFile.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const char* filename)
+{
+#ifdef _WIN32
+    const auto file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open ROM file!");
+    }
+    LARGE_INTEGER size{};
+    GetFileSizeEx(file, &size);
+    m_size = static_cast<size_t>(size.QuadPart);
+    if (m_size) {
+        // The view keeps the mapping alive, neither handle is needed afterwards
+        const auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            m_data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    const auto fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open ROM file!");
+    }
+    struct stat info{};
+    fstat(fd, &info);
+    m_size = static_cast<size_t>(info.st_size);
+    if (m_size) {
+        void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        m_data = (data == MAP_FAILED) ? nullptr : static_cast<const uint8_t*>(data);
+    }
+    close(fd);
+#endif
+    if (!m_data) {
+        throw std::runtime_error("Cannot map ROM file!");
+    }
+}
+
+MappedFile::MappedFile(const char* filename, size_t size) :
+    m_size(size),
+    m_writable(true)
+{
+#ifdef _WIN32
+    const auto file = CreateFileA(filename, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open save file!");
+    }
+    // A mapping larger than the file grows it, the new bytes read as zero
+    const auto mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(uint64_t(size) >> 32), static_cast<DWORD>(size), nullptr);
+    if (mapping) {
+        m_data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size));
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+#else
+    const auto fd = open(filename, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open save file!");
+    }
+    struct stat info{};
+    fstat(fd, &info);
+    if (static_cast<size_t>(info.st_size) < size && ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        throw std::runtime_error("Cannot grow save file!");
+    }
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    m_data = (data == MAP_FAILED) ? nullptr : static_cast<const uint8_t*>(data);
+    close(fd);
+#endif
+    if (!m_data) {
+        throw std::runtime_error("Cannot map save file!");
+    }
+}
+
+void MappedFile::flush(size_t offset, size_t size)
+{
+    if (!m_writable) {
+        return;
+    }
+#ifdef _WIN32
+    FlushViewOfFile(m_data + offset, size);
+#else
+    // msync wants a page aligned start
+    const auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const auto start = offset / page * page;
+    msync(const_cast<uint8_t*>(m_data) + start, size + offset - start, MS_ASYNC);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept :
+    m_data(std::exchange(other.m_data, nullptr)),
+    m_size(std::exchange(other.m_size, 0)),
+    m_writable(std::exchange(other.m_writable, false))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        unmap();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_writable = std::exchange(other.m_writable, false);
+    }
+    return *this;
+}
+
+void MappedFile::unmap()
+{
+    if (!m_data) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+#else
+    munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_writable = false;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Read-only private mapping of a whole file. Every instance mapping the same file shares
+// its physical pages and nothing is read until a page is first touched.
+// The writable form maps a shared view of a file created or grown to the given size.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const char* filename);
+    MappedFile(const char* filename, size_t size);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    const uint8_t* data() const { return m_data; }
+    uint8_t* writableData() { return m_writable ? const_cast<uint8_t*>(m_data) : nullptr; }
+    size_t size() const { return m_size; }
+
+    // Starts writing back a range of a writable mapping without waiting for the disk
+    void flush(size_t offset, size_t size);
+
+private:
+    void unmap();
+
+    const uint8_t* m_data{};
+    size_t m_size{};
+    bool m_writable = false;
+};
@@ -1,12 +1,18 @@
 #include "PPU.hpp"
 
 #include "Bus.hpp"
+#include "SaveState.hpp"
 #include "Utils.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
+#include <iostream>
+#include <limits>
 
-PPU::PPU(Bus* bus) : m_bus(bus), m_dots(0), m_mode(Mode::OAMSCAN), m_currentLine(0), m_dotsDrawn(0)
+PPU::PPU(Bus* bus) : m_bus(bus), m_tileCache(bus->getMap() + 0x8000), m_kernels(PixelKernels::best()), m_dots(0), m_mode(Mode::OAMSCAN), m_currentLine(0), m_dotsDrawn(0)
 {
+    m_shades.resize(160 * 144);
     m_frameBuffer.data.resize(160 * 144 * 4); // 160 x 144 x 4 bytes RGBA
     m_frameBuffer.width = 160;
 
@@ -18,13 +24,90 @@ PPU::PPU(Bus* bus) : m_bus(bus), m_dots(0), m_mode(Mode::OAMSCAN), m_currentLine
 
     m_objectBuffer.data.resize(160 * 144 * 4); // same as frameBuffer
     m_objectBuffer.width = 160;
+
+    m_bus->mapIo(0xFF41, 0b0111'1000); // STAT, mode and LYC match bits are read-only
+    m_bus->mapIo(0xFF44, 0x00); // LY
+    m_bus->mapIo(0xFF47, 0xFF, [this](uint8_t value) { // BGP
+        m_bus->io(0xFF47) = value;
+        updatePaletteLookup(m_paletteLookup, value);
+    });
+    m_bus->mapIo(0xFF48, 0xFF, [this](uint8_t value) { // OBP0
+        m_bus->io(0xFF48) = value;
+        updatePaletteLookup(m_objectPaletteLookup[0], value);
+    });
+    m_bus->mapIo(0xFF49, 0xFF, [this](uint8_t value) { // OBP1
+        m_bus->io(0xFF49) = value;
+        updatePaletteLookup(m_objectPaletteLookup[1], value);
+    });
+}
+
+void PPU::updatePaletteLookup(std::array<uint8_t, 4>& lookup, uint8_t map)
+{
+    for (size_t i{}; i < lookup.size(); ++i) {
+        lookup[i] = static_cast<uint8_t>((map >> (2 * i)) & 0b0000'0011);
+    }
+}
+
+// The palette as RGBA pixels, for expanding colour indices
+std::array<uint32_t, 4> PPU::colours(const std::array<uint8_t, 4>& lookup) const
+{
+    std::array<uint32_t, 4> colours{};
+    for (size_t i{}; i < colours.size(); ++i) {
+        const auto [r, g, b] = m_palette[lookup[i]];
+        colours[i] = PixelKernels::rgba(r, g, b);
+    }
+    return colours;
 }
 
-void PPU::updatePaletteLookup(uint8_t map)
+// One pass over the whole frame, and none at all for a frame nobody looks at
+const std::vector<uint8_t>& PPU::getFrameBuffer() const
 {
-    for (size_t i{}; i < m_paletteLookup.size(); ++i) {
-        m_paletteLookup[i] = static_cast<uint8_t>((map >> (2 * i)) & 0b0000'0011);
+    if (m_frameBufferStale) {
+#ifdef TAMEBOY_BENCHMARK
+        const auto start = std::chrono::steady_clock::now();
+#endif
+        static constexpr std::array<uint8_t, 4> shades{ 0, 1, 2, 3 };
+        m_kernels.expand(m_shades.data(), colours(shades), m_frameBuffer.data.data(), m_shades.size());
+        m_frameBufferStale = false;
+#ifdef TAMEBOY_BENCHMARK
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        m_conversionTime += elapsed.count();
+        m_conversions++;
+#endif
     }
+    return m_frameBuffer.data;
+}
+
+void PPU::saveState(StateWriter& state) const
+{
+    state.put(m_dots);
+    state.put(m_mode);
+    state.put(m_currentLine);
+    state.put(m_dotsDrawn);
+    state.put(m_cycleCounter);
+    state.put(m_windowLine);
+}
+
+void PPU::loadState(StateReader& state)
+{
+    state.get(m_dots);
+    state.get(m_mode);
+    state.get(m_currentLine);
+    state.get(m_dotsDrawn);
+    state.get(m_cycleCounter);
+    state.get(m_windowLine);
+
+    m_tileCache.invalidateAll();
+    updatePaletteLookup(m_paletteLookup, m_bus->io(0xFF47));
+    updatePaletteLookup(m_objectPaletteLookup[0], m_bus->io(0xFF48));
+    updatePaletteLookup(m_objectPaletteLookup[1], m_bus->io(0xFF49));
+}
+
+void PPU::setLinePhase(uint8_t line, uint32_t dots)
+{
+    m_currentLine = line >= 153 ? 0 : line + 1; // the next line to start
+    m_mode = line >= 144 ? Mode::VBLANK : Mode::OAMSCAN;
+    m_cycleCounter = dots;
 }
 
 void PPU::drawObject(Vbuffer& buffer, XY pixelPos, uint16_t tile, uint8_t flags)
@@ -38,16 +121,12 @@ void PPU::drawObject(Vbuffer& buffer, XY pixelPos, uint16_t tile, uint8_t flags)
     const auto xFlip = static_cast<bool>(flags & 0b0010'0000);
     const auto yFlip = static_cast<bool>(flags & 0b0100'0000);
     const auto priority = static_cast<bool>(flags & 0b1000'0000);
+    const auto& paletteLookup = m_objectPaletteLookup[(flags >> 4) & 0b0000'0001];
     for (int j = 0; j < 8; ++j) { // 8 rows in a tile
-        const auto J = yFlip ? 8 - 1 - j : j;
-        const auto lsByte = m_bus->read(tileStart + 2 * J);
-        const auto msByte = m_bus->read(tileStart + 2 * J + 1);
+        const auto* row = m_tileCache.row(tileStart, yFlip ? 8 - 1 - j : j, xFlip);
         for (int i = 0; i < 8; ++i) { // one 8 tile row at a time
-            const auto I = xFlip ? 8 - 1 - i : i;
-            const auto lsBit = static_cast<bool>(lsByte & (1 << (7 - I)));
-            const auto msBit = static_cast<bool>(msByte & (1 << (7 - I)));
-            const auto id = (static_cast<uint8_t>(msBit) << 1) | static_cast<uint8_t>(lsBit);
-            const auto [r, g, b] = m_palette[m_paletteLookup[id]];
+            const auto id = row[i];
+            const auto [r, g, b] = m_palette[paletteLookup[id]];
             if (id) {
                 buffer.data[screenStart + 4 * (i + j * buffer.width)] = r;
                 buffer.data[screenStart + 4 * (i + j * buffer.width) + 1] = g;
@@ -69,24 +148,15 @@ void PPU::drawAlignedTile(Vbuffer& buffer, XY tilePos, uint16_t tile, bool unsig
         tileStart = 0x9000 + signedTile * 16;
     }
     const auto screenStart = tilePos.first * 8 + tilePos.second * 8 * buffer.width;
+    const auto rgba = colours(m_paletteLookup);
     for (int j = 0; j < 8; ++j) { // 8 rows in a tile
-        const auto lsByte = m_bus->read(tileStart + 2 * j);
-        const auto msByte = m_bus->read(tileStart + 2 * j + 1);
-        for (int i = 0; i < 8; ++i) { // one 8 tile row at a time
-            const auto lsBit = static_cast<bool>(lsByte & (1 << (7 - i)));
-            const auto msBit = static_cast<bool>(msByte & (1 << (7 - i)));
-            const auto id = (static_cast<uint8_t>(msBit) << 1) | static_cast<uint8_t>(lsBit);
-            const auto [r, g, b] = m_palette[m_paletteLookup[id]];
-
-            const int index = screenStart + i + j * buffer.width;
-            buffer.data[4 * index] = r;
-            buffer.data[4 * index + 1] = g;
-            buffer.data[4 * index + 2] = b;
-            buffer.data[4 * index + 3] = 255;
-        }
+        m_kernels.expand(m_tileCache.row(tileStart, j), rgba, &buffer.data[4 * (screenStart + j * buffer.width)], 8);
     }
 };
 
+// Background and window of one line a tile at a time. Each tile map entry is read once and its
+// decoded row copied, the first and last background tiles are cut by the fine SCX scroll. The
+// window has its own line counter, which only moves on lines that show it.
 void PPU::drawLine(uint8_t LCDC, uint8_t SCX, uint8_t SCY, uint8_t WX, uint8_t WY, int LC) {
     const auto unsignedMode = static_cast<bool>(LCDC & 0b0001'0000);
     const auto backgroundTileMapAddr = static_cast<bool>(LCDC & 0b0000'1000) ? 0x9C00 : 0x9800; // 9800-9BFF : 9C00-9FFF (32x32 = 1024 bytes)
@@ -94,54 +164,116 @@ void PPU::drawLine(uint8_t LCDC, uint8_t SCX, uint8_t SCY, uint8_t WX, uint8_t W
     const auto windowEnable = static_cast<bool>(LCDC & 0b0010'0000);
     const auto backgroundAndWindowEnable = static_cast<bool>(LCDC & 0b0000'0001);
 
-    uint16_t tileMapAddr{};
-    uint8_t scrollX{};
-    uint8_t scrollY{};
-    if (windowEnable && (LC >= WY)) {
-        tileMapAddr = windowTileMapAddr;
-        scrollX = WX - 7;
-        scrollY = -WY;
+    // Map pixels from (mapX, mapY) on, to the screen from x = start to the end of the line
+    const auto drawTiles = [&](uint16_t tileMapAddr, int start, uint8_t mapX, uint8_t mapY) {
+        const auto rowAddr = static_cast<uint16_t>(tileMapAddr + (mapY / 8) * 32);
+        auto column = mapX / 8;
+        for (auto x = start - mapX % 8; x < 160; x += 8) {
+            const auto tileNumber = m_bus->read(rowAddr + column);
+            const auto tileStart = unsignedMode ? 0x8000 + tileNumber * 16 : 0x9000 + static_cast<int8_t>(tileNumber) * 16;
+            const auto* row = m_tileCache.row(static_cast<uint16_t>(tileStart), mapY % 8);
+            const auto first = std::max(start - x, 0);
+            const auto last = std::min(160 - x, 8);
+            std::copy(row + first, row + last, m_lineIds.data() + x + first);
+            column = (column + 1) % 32;
+        }
+    };
+
+    if (backgroundAndWindowEnable) {
+        drawTiles(backgroundTileMapAddr, 0, SCX, static_cast<uint8_t>(SCY + LC));
+        if (windowEnable && LC >= WY && WX < 167) {
+            drawTiles(windowTileMapAddr, std::max(WX - 7, 0), static_cast<uint8_t>(std::max(7 - WX, 0)), m_windowLine++);
+        }
     }
     else {
-        tileMapAddr = backgroundTileMapAddr;
-        scrollX = SCX;
-        scrollY = SCY;
+        m_lineIds.fill(0);
     }
 
-    for (int tileSlice = 0; tileSlice < 20; ++tileSlice) {
-        for (int pixel = 0; pixel < 8; ++pixel) { // one 8 tile row at a time
-            const auto xTile = ((scrollX + 8 * tileSlice + pixel) % 256) / 8;
-            const auto yTile = ((scrollY + LC) % 256) / 8;
-            const auto tileNumber = m_bus->read(tileMapAddr + xTile + 32 * yTile);
+    // Without background and window the line is blank, whatever BGP says
+    static constexpr std::array<uint8_t, 4> blank{};
+    const auto& paletteLookup = backgroundAndWindowEnable ? m_paletteLookup : blank;
+    auto* shades = m_shades.data() + LC * 160;
+    for (int x = 0; x < 160; ++x) {
+        shades[x] = paletteLookup[m_lineIds[x]];
+    }
+    m_frameBufferStale = true;
+}
 
-            uint16_t tileStart;
-            if (unsignedMode) {
-                tileStart = 0x8000 + tileNumber * 16;
+// OAM scan for one line: the first 10 objects in OAM order that cover it. Where they overlap the
+// lowest X wins, OAM order breaks ties, and an object behind the background only shows over colour 0.
+void PPU::drawObjects(uint8_t LCDC, int LC)
+{
+    if (!(LCDC & 0b0000'0010)) {
+        return;
+    }
+    const auto height = (LCDC & 0b0000'0100) ? 16 : 8;
+
+    std::array<uint8_t, maxObjectsPerLine> selected{};
+    size_t count = 0;
+    for (uint8_t i = 0; i < 40 && count < maxObjectsPerLine; ++i) {
+        const auto row = LC + 16 - m_bus->read(0xFE00 + i * 4);
+        if (row >= 0 && row < height) {
+            selected[count++] = i;
+        }
+    }
+    std::stable_sort(selected.begin(), selected.begin() + count, [this](uint8_t a, uint8_t b) {
+        return m_bus->read(0xFE00 + a * 4 + 1) < m_bus->read(0xFE00 + b * 4 + 1);
+    });
+
+    std::array<bool, 160> taken{}; // an object before this one has a visible pixel there
+    for (size_t n = 0; n < count; ++n) {
+        const uint16_t entry = 0xFE00 + selected[n] * 4;
+        const auto Y = m_bus->read(entry);
+        const auto X = m_bus->read(entry + 1);
+        const auto TILE = height == 16 ? m_bus->read(entry + 2) & 0xFE : m_bus->read(entry + 2);
+        const auto FLAGS = m_bus->read(entry + 3);
+
+        const auto xFlip = static_cast<bool>(FLAGS & 0b0010'0000);
+        const auto yFlip = static_cast<bool>(FLAGS & 0b0100'0000);
+        const auto priority = static_cast<bool>(FLAGS & 0b1000'0000);
+        const auto& paletteLookup = m_objectPaletteLookup[(FLAGS >> 4) & 0b0000'0001];
+
+        const auto line = yFlip ? height - 1 - (LC + 16 - Y) : LC + 16 - Y;
+        const uint16_t tileStart = 0x8000 + (TILE + line / 8) * 16; // the lower half of a tall object is the next tile
+        const auto* row = m_tileCache.row(tileStart, line % 8, xFlip);
+#ifdef TAMEBOY_BENCHMARK
+        m_objectsDrawn++;
+#endif
+
+        for (int i = 0; i < 8; ++i) {
+            const auto x = X - 8 + i;
+            if (x < 0 || x >= 160 || taken[x]) {
+                continue;
             }
-            else {
-                const auto signedTile = (int8_t)tileNumber;
-                tileStart = 0x9000 + signedTile * 16;
+            const auto id = row[i];
+            if (!id) {
+                continue;
             }
-
-            const auto lsByteIndex = tileStart + 2 * ((scrollY + LC) % 8);
-            const auto lsByte = m_bus->read(lsByteIndex);
-            const auto msByte = m_bus->read(lsByteIndex + 1);
-    
-            const auto nonAlignedPixel = (pixel + scrollX) % 8;
-            const auto lsBit = static_cast<bool>(lsByte & (1 << (7 - nonAlignedPixel)));
-            const auto msBit = static_cast<bool>(msByte & (1 << (7 - nonAlignedPixel)));
-            const auto id = (static_cast<uint8_t>(msBit) << 1) | static_cast<uint8_t>(lsBit);
-             const auto [r, g, b] = m_palette[m_paletteLookup[id]];
-
-            const int index = pixel + tileSlice * 8 + LC * m_frameBuffer.width;
-            m_frameBuffer.data[4 * index] = r;
-            m_frameBuffer.data[4 * index + 1] = g;
-            m_frameBuffer.data[4 * index + 2] = b;
-            m_frameBuffer.data[4 * index + 3] = 255;
+            taken[x] = true;
+            if (priority && m_lineIds[x]) {
+                continue;
+            }
+            m_shades[x + LC * 160] = paletteLookup[id];
+#ifdef TAMEBOY_BENCHMARK
+            m_objectPixels++;
+#endif
         }
     }
-};
+}
+
+void PPU::printRenderStats() const
+{
+#ifdef TAMEBOY_BENCHMARK
+    std::cout << std::dec << "Render:\n"
+        << "frames=" << m_frames << " objects/frame=" << (m_frames ? double(m_objectsDrawn) / m_frames : 0.0)
+        << " object pixels/frame=" << (m_frames ? double(m_objectPixels) / m_frames : 0.0) << "\n"
+        << "lines=" << m_linesDrawn << " avgLine=" << (m_linesDrawn ? 1e9 * m_renderTime / m_linesDrawn : 0.0) << " ns\n"
+        << "conversions=" << m_conversions << " avgConversion=" << (m_conversions ? 1e6 * m_conversionTime / m_conversions : 0.0) << " us\n";
+#endif
+    m_tileCache.printStats();
+}
 
+// Every object whole, for the debug viewer
 void PPU::blitObjects(Vbuffer& buffer)
 {
     const auto numObjects = 40;
@@ -218,6 +350,16 @@ void PPU::drawDots() {
     m_dotsDrawn += dotsToDraw;
 }
 
+// LY, the LYC compare and both interrupts only change on line boundaries
+uint32_t PPU::cyclesUntilNextLine()
+{
+    const auto LCDC = m_bus->read(0xFF40);
+    if (!static_cast<bool>((LCDC & 0b10000000) >> 7)) {
+        return std::numeric_limits<uint32_t>::max();
+    }
+    return static_cast<uint32_t>(456 - m_cycleCounter);
+}
+
 void PPU::tick(uint32_t cycles) {
     m_dots += cycles;
 
@@ -284,28 +426,42 @@ void PPU::tick(uint32_t cycles) {
 
     auto advanceLine = [&]()
     {
-        m_bus->write(0xFF44, m_currentLine);
+        m_bus->io(0xFF44) = m_currentLine;
 
         const auto LYC = m_bus->read(0xFF45);
         const auto STAT = m_bus->read(0xFF41);
         if (m_currentLine == LYC) {
             const auto newSTAT = Utils::setBit(STAT, 2);
-            m_bus->write(0xFF41, newSTAT);
+            m_bus->io(0xFF41) = newSTAT;
             if (STAT & 0b0100'0000) {
                 statInterrupt();
             }
         }
         else {
             const auto newSTAT = Utils::clearBit(STAT, 2);
-            m_bus->write(0xFF41, newSTAT);
+            m_bus->io(0xFF41) = newSTAT;
         }
     
+        if (m_currentLine == 0) {
+            m_windowLine = 0;
+        }
         if (m_currentLine < 144) {
+#ifdef TAMEBOY_BENCHMARK
+            const auto renderStart = std::chrono::steady_clock::now();
+#endif
             drawLine(LCDC, SCX, SCY, WX, WY, m_currentLine);
-            blitObjects(m_frameBuffer); // TODO - line blit
+            drawObjects(LCDC, m_currentLine);
+#ifdef TAMEBOY_BENCHMARK
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - renderStart;
+            m_renderTime += elapsed.count();
+            m_linesDrawn++;
+#endif
         }
         if (m_currentLine == 144) {
             verticalInterrupt();
+#ifdef TAMEBOY_BENCHMARK
+            m_frames++;
+#endif
         }
         if (m_currentLine >= 153) {
             m_currentLine = -1;
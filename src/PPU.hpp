@@ -1,10 +1,16 @@
 #pragma once
 
+#include "PixelKernels.hpp"
+#include "TileCache.hpp"
+
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <vector>
 
 class Bus;
+class StateReader;
+class StateWriter;
 
 using XY = std::pair<uint8_t, uint8_t>;
 
@@ -27,12 +33,25 @@ class PPU {
 public:
     PPU(Bus* bus);
     void tick(uint32_t cycles);
-    void updatePaletteLookup(uint8_t map);
+    uint32_t cyclesUntilNextLine();
+    // Line timing `dots` into `line`, for starting without the boot ROM
+    void setLinePhase(uint8_t line, uint32_t dots);
     void updateDebugVramDisplays();
-    const std::vector<uint8_t>& getFrameBuffer() const { return m_frameBuffer.data; }
+
+    // Line timing only, the palettes are rebuilt from the registers and the frame is redrawn from memory
+    void saveState(StateWriter& state) const;
+    void loadState(StateReader& state);
+    // RGBA, converted from the shades on the first call after a line is drawn
+    const std::vector<uint8_t>& getFrameBuffer() const;
+    // 160x144, one byte per pixel from 0 (lightest) to 3 (darkest), the palettes already applied
+    const std::vector<uint8_t>& getShadeBuffer() const { return m_shades; }
     const std::vector<uint8_t>& getTileDataBuffer() const { return m_tileDataBuffer.data; }
     const std::vector<uint8_t>& getTileMapBuffer() const { return m_tileMapBuffer.data; }
     const std::vector<uint8_t>& getObjectBuffer() const { return m_objectBuffer.data; }
+    void printRenderStats() const;
+
+    // A CPU write to tile data, the tile is decoded again before it is next drawn
+    void invalidateTile(uint16_t addr) { m_tileCache.invalidate(addr); }
 
 private:
     void drawAlignedTile(Vbuffer& buffer, XY tilePos, uint16_t tile, bool unsignedMode = true);
@@ -40,11 +59,17 @@ private:
     void drawLine(uint8_t LCDC, uint8_t SCX, uint8_t SCY, uint8_t WX, uint8_t WY, int LC);
     void drawDots();
     void blitObjects(Vbuffer& buffer);
+    void drawObjects(uint8_t LCDC, int LC);
 
+    static void updatePaletteLookup(std::array<uint8_t, 4>& lookup, uint8_t map);
+    std::array<uint32_t, 4> colours(const std::array<uint8_t, 4>& lookup) const;
     void verticalInterrupt();
     void statInterrupt();
 
+    static constexpr size_t maxObjectsPerLine = 10;
+
     std::array<uint8_t, 4> m_paletteLookup{};
+    std::array<std::array<uint8_t, 4>, 2> m_objectPaletteLookup{};
 
 #define GREEN
 #ifdef GREEN
@@ -53,15 +78,32 @@ private:
     static constexpr std::array<std::array<uint8_t, 3>, 4> m_palette{ { {{255, 255, 255}}, {{170, 170, 170}}, {{ 80,  80,  80}}, {{  0,   0,   0}} } };
 #endif
 
-    Vbuffer m_frameBuffer;
+    std::vector<uint8_t> m_shades;
+    mutable Vbuffer m_frameBuffer;
+    mutable bool m_frameBufferStale = true;
     Vbuffer m_tileDataBuffer;
     Vbuffer m_tileMapBuffer;
     Vbuffer m_objectBuffer;
     Bus* m_bus{};
+    TileCache m_tileCache;
+    const PixelKernels& m_kernels;
 
     uint32_t m_dots;
     Mode m_mode = Mode::OAMSCAN;
     uint8_t m_currentLine{};
     uint32_t m_dotsDrawn{};
     uint64_t m_cycleCounter{};
+    uint8_t m_windowLine{}; // window rows shown so far this frame
+
+    std::array<uint8_t, 160> m_lineIds{}; // background and window colour of the line being drawn, before BGP
+
+#ifdef TAMEBOY_BENCHMARK
+    uint64_t m_frames{};
+    uint64_t m_objectsDrawn{};
+    uint64_t m_objectPixels{};
+    uint64_t m_linesDrawn{};
+    double m_renderTime{}; // seconds, background, window and objects
+    mutable uint64_t m_conversions{};
+    mutable double m_conversionTime{}; // seconds, shades to RGBA
+#endif
 };
@@ -0,0 +1,241 @@
+#include "PixelKernels.hpp"
+
+#include <cstring>
+
+#ifdef TAMEBOY_BENCHMARK
+#include <chrono>
+#include <iostream>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define TAMEBOY_X64_KERNELS
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+
+void decodeRowsScalar(const uint8_t* planar, uint8_t* indices, size_t rows)
+{
+    for (size_t row = 0; row < rows; ++row) {
+        const auto lsByte = planar[2 * row];
+        const auto msByte = planar[2 * row + 1];
+        for (int i = 0; i < 8; ++i) {
+            indices[8 * row + i] = static_cast<uint8_t>((((msByte >> (7 - i)) & 1) << 1) | ((lsByte >> (7 - i)) & 1));
+        }
+    }
+}
+
+void expandScalar(const uint8_t* indices, const std::array<uint32_t, 4>& colours, uint8_t* rgba, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(rgba + 4 * i, &colours[indices[i]], 4);
+    }
+}
+
+#ifdef TAMEBOY_X64_KERNELS
+// A row's two bytes spread to [low x8 | high x8], the bit for each pixel picked out and
+// weighted 1 or 2, then the two halves added.
+void decodeRowsSse2(const uint8_t* planar, uint8_t* indices, size_t rows)
+{
+    const auto bits = _mm_setr_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+    const auto weights = _mm_setr_epi8(1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2);
+    const auto decode = [&](__m128i row) {
+        const auto set = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(row, bits), bits), weights);
+        return _mm_add_epi8(set, _mm_srli_si128(set, 8));
+    };
+
+    size_t row = 0;
+    for (; row + 2 <= rows; row += 2) {
+        int32_t pair{};
+        std::memcpy(&pair, planar + 2 * row, 4);
+        const auto v = _mm_cvtsi32_si128(pair);
+        const auto bytes = _mm_unpacklo_epi8(v, v);
+        const auto words = _mm_unpacklo_epi16(bytes, bytes);
+        const auto first = decode(_mm_unpacklo_epi32(words, words));
+        const auto second = decode(_mm_unpackhi_epi32(words, words));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(indices + 8 * row), _mm_unpacklo_epi64(first, second));
+    }
+    if (row < rows) {
+        decodeRowsScalar(planar + 2 * row, indices + 8 * row, rows - row);
+    }
+}
+
+// No variable shuffle in SSE2, bit 0 of each index picks between colours 0 and 1 and between
+// 2 and 3, bit 1 between the two results
+void expandSse2(const uint8_t* indices, const std::array<uint32_t, 4>& colours, uint8_t* rgba, size_t count)
+{
+    const auto zero = _mm_setzero_si128();
+    const auto one = _mm_set1_epi32(1);
+    const auto two = _mm_set1_epi32(2);
+    const auto colour0 = _mm_set1_epi32(static_cast<int32_t>(colours[0]));
+    const auto colour2 = _mm_set1_epi32(static_cast<int32_t>(colours[2]));
+    const auto swap01 = _mm_xor_si128(colour0, _mm_set1_epi32(static_cast<int32_t>(colours[1])));
+    const auto swap23 = _mm_xor_si128(colour2, _mm_set1_epi32(static_cast<int32_t>(colours[3])));
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i));
+        const auto words = std::array{ _mm_unpacklo_epi8(bytes, zero), _mm_unpackhi_epi8(bytes, zero) };
+        for (int quad = 0; quad < 4; ++quad) {
+            const auto& half = words[quad / 2];
+            const auto ids = quad & 1 ? _mm_unpackhi_epi16(half, zero) : _mm_unpacklo_epi16(half, zero);
+            const auto bit0 = _mm_cmpeq_epi32(_mm_and_si128(ids, one), one);
+            const auto bit1 = _mm_cmpeq_epi32(_mm_and_si128(ids, two), two);
+            const auto low = _mm_xor_si128(colour0, _mm_and_si128(bit0, swap01));
+            const auto high = _mm_xor_si128(colour2, _mm_and_si128(bit0, swap23));
+            const auto out = _mm_xor_si128(low, _mm_and_si128(bit1, _mm_xor_si128(low, high)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + 4 * (i + 4 * quad)), out);
+        }
+    }
+    if (i < count) {
+        expandScalar(indices + i, colours, rgba + 4 * i, count - i);
+    }
+}
+
+// Lambdas do not take on the target of the function around them
+TARGET_AVX2 __m256i decodeSpreadAvx2(__m256i spread, __m256i bits, __m256i weights)
+{
+    const auto set = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(spread, bits), bits), weights);
+    return _mm256_add_epi8(set, _mm256_srli_si256(set, 8));
+}
+
+// As the SSE2 version, four rows at a time with two in each 128-bit lane
+TARGET_AVX2 void decodeRowsAvx2(const uint8_t* planar, uint8_t* indices, size_t rows)
+{
+    const auto bits = _mm256_setr_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1,
+        -128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+    const auto weights = _mm256_setr_epi8(1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2,
+        1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2);
+
+    size_t row = 0;
+    for (; row + 4 <= rows; row += 4) {
+        const auto v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(planar + 2 * row));
+        const auto bytes = _mm_unpacklo_epi8(v, v);
+        const auto words = _mm256_set_m128i(_mm_unpackhi_epi16(bytes, bytes), _mm_unpacklo_epi16(bytes, bytes));
+        const auto even = decodeSpreadAvx2(_mm256_unpacklo_epi32(words, words), bits, weights); // rows 0 and 2
+        const auto odd = decodeSpreadAvx2(_mm256_unpackhi_epi32(words, words), bits, weights); // rows 1 and 3
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(indices + 8 * row), _mm256_unpacklo_epi64(even, odd));
+    }
+    if (row < rows) {
+        decodeRowsScalar(planar + 2 * row, indices + 8 * row, rows - row);
+    }
+}
+
+// The four colours twice over make an 8 entry table for a cross-lane dword shuffle
+TARGET_AVX2 void expandAvx2(const uint8_t* indices, const std::array<uint32_t, 4>& colours, uint8_t* rgba, size_t count)
+{
+    const auto table = _mm256_setr_epi32(static_cast<int32_t>(colours[0]), static_cast<int32_t>(colours[1]),
+        static_cast<int32_t>(colours[2]), static_cast<int32_t>(colours[3]), static_cast<int32_t>(colours[0]),
+        static_cast<int32_t>(colours[1]), static_cast<int32_t>(colours[2]), static_cast<int32_t>(colours[3]));
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const auto ids = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(indices + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(rgba + 4 * i), _mm256_permutevar8x32_epi32(table, ids));
+    }
+    if (i < count) {
+        expandScalar(indices + i, colours, rgba + 4 * i, count - i);
+    }
+}
+
+bool hasAvx2()
+{
+#ifdef _MSC_VER
+    std::array<int, 4> info{};
+    __cpuid(info.data(), 1);
+    const auto osSavesYmm = (info[2] & (1 << 27)) && (_xgetbv(0) & 0b110) == 0b110;
+    __cpuidex(info.data(), 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5));
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+const PixelKernels scalarKernels{ "scalar", decodeRowsScalar, expandScalar };
+#ifdef TAMEBOY_X64_KERNELS
+const PixelKernels sse2Kernels{ "sse2", decodeRowsSse2, expandSse2 };
+const PixelKernels avx2Kernels{ "avx2", decodeRowsAvx2, expandAvx2 };
+#endif
+
+}
+
+std::vector<const PixelKernels*> PixelKernels::available()
+{
+    std::vector<const PixelKernels*> kernels{ &scalarKernels };
+#ifdef TAMEBOY_X64_KERNELS
+    kernels.push_back(&sse2Kernels); // part of x86-64
+    if (hasAvx2()) {
+        kernels.push_back(&avx2Kernels);
+    }
+#endif
+    return kernels;
+}
+
+const PixelKernels& PixelKernels::best()
+{
+    static const PixelKernels* kernels = available().back();
+    return *kernels;
+}
+
+uint32_t PixelKernels::rgba(uint8_t r, uint8_t g, uint8_t b)
+{
+    const std::array<uint8_t, 4> bytes{ r, g, b, 255 };
+    uint32_t pixel{};
+    std::memcpy(&pixel, bytes.data(), 4);
+    return pixel;
+}
+
+#ifdef TAMEBOY_BENCHMARK
+// Every pair of bitplane bytes and a line of colour indices through each variant, then the
+// time to decode one tile and to expand one line
+void PixelKernels::benchmark()
+{
+    std::vector<uint8_t> planar(2 * 0x10000);
+    for (size_t row = 0; row < 0x10000; ++row) {
+        planar[2 * row] = static_cast<uint8_t>(row);
+        planar[2 * row + 1] = static_cast<uint8_t>(row >> 8);
+    }
+    std::vector<uint8_t> line(160);
+    for (size_t i = 0; i < line.size(); ++i) {
+        line[i] = static_cast<uint8_t>((i * 7 + i / 3) & 0b11);
+    }
+    const std::array<uint32_t, 4> colours{ rgba(0x9B, 0xBC, 0x0F), rgba(0x8B, 0xAC, 0x0F), rgba(0x30, 0x62, 0x30), rgba(0x0F, 0x38, 0x0F) };
+
+    std::vector<uint8_t> expectedIndices(8 * 0x10000);
+    std::vector<uint8_t> expectedPixels(4 * line.size());
+    scalarKernels.decodeRows(planar.data(), expectedIndices.data(), 0x10000);
+    scalarKernels.expand(line.data(), colours, expectedPixels.data(), line.size());
+
+    constexpr int rounds = 20000;
+    std::cout << "Pixel kernels (best " << best().name << "):\n";
+    for (const auto* kernels : available()) {
+        std::vector<uint8_t> indices(expectedIndices.size());
+        std::vector<uint8_t> pixels(expectedPixels.size());
+        kernels->decodeRows(planar.data(), indices.data(), 0x10000);
+        kernels->expand(line.data(), colours, pixels.data(), line.size());
+        const auto matches = indices == expectedIndices && pixels == expectedPixels;
+
+        const auto decodeStart = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            kernels->decodeRows(planar.data() + 16 * (round % 4096), indices.data(), 8);
+        }
+        const auto expandStart = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            kernels->expand(line.data(), colours, pixels.data(), line.size());
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const std::chrono::duration<double, std::nano> decodeTime = expandStart - decodeStart;
+        const std::chrono::duration<double, std::nano> expandTime = end - expandStart;
+        std::cout << kernels->name << ": tile=" << decodeTime.count() / rounds << " ns line=" << expandTime.count() / rounds
+            << " ns " << (matches ? "matches scalar" : "DIFFERS from scalar") << "\n";
+    }
+}
+#endif
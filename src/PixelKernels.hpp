@@ -0,0 +1,31 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// The innermost loops of drawing: tile rows from their two bitplanes to one colour index per
+// pixel, and colour indices to RGBA through the four colours of a palette. best() is the
+// widest variant the host CPU runs, chosen on first use. The others stay reachable for the
+// benchmark, which checks them against the scalar loops.
+struct PixelKernels {
+    // rows * 2 bytes, low bitplane first, to rows * 8 indices
+    using DecodeRows = void (*)(const uint8_t* planar, uint8_t* indices, size_t rows);
+    // count indices to count * 4 bytes
+    using Expand = void (*)(const uint8_t* indices, const std::array<uint32_t, 4>& colours, uint8_t* rgba, size_t count);
+
+    const char* name{};
+    DecodeRows decodeRows{};
+    Expand expand{};
+
+    static const PixelKernels& best();
+    static std::vector<const PixelKernels*> available();
+
+    // A pixel as it is laid out in an RGBA buffer, whatever the host byte order
+    static uint32_t rgba(uint8_t r, uint8_t g, uint8_t b);
+
+#ifdef TAMEBOY_BENCHMARK
+    static void benchmark();
+#endif
+};
@@ -0,0 +1,664 @@
+#include "Recompiler.hpp"
+
+#include "Bus.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace {
+    enum HostRegister {
+        RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI,
+        R8, R9, R10, R11, R12, R13, R14, R15
+    };
+
+    // Guest registers live in callee-saved and high registers for the whole block,
+    // RAX, RCX, RDX, RSI and RDI are scratch and RBX points at the RecompilerState
+    constexpr int RegA = R8;
+    constexpr int RegF = R9;
+    constexpr int RegB = R10;
+    constexpr int RegC = R11;
+    constexpr int RegD = R12;
+    constexpr int RegE = R13;
+    constexpr int RegH = R14;
+    constexpr int RegL = R15;
+    constexpr int RegSP = RBP;
+    constexpr int RegState = RBX;
+
+    // Operand encoding of the 8 bit register field, (HL) is -1
+    constexpr std::array<int, 8> operandRegister{ RegB, RegC, RegD, RegE, RegH, RegL, -1, RegA };
+
+    enum class Alu : uint8_t { Add = 0x01, Or = 0x09, And = 0x21, Sub = 0x29, Xor = 0x31 };
+    enum class AluImm : uint8_t { Add = 0, Or = 1, And = 4, Sub = 5, Xor = 6 };
+    enum class Shift : uint8_t { Shl = 4, Shr = 5 };
+    enum Condition : uint8_t { Zero = 0x4, NotZero = 0x5 };
+
+    // Minimal x86-64 encoder, 32 bit operations unless stated otherwise
+    class Emitter {
+    public:
+        std::vector<uint8_t> code{};
+
+        size_t size() const { return code.size(); }
+        void byte(uint8_t value) { code.push_back(value); }
+        void word(uint16_t value) { byte(static_cast<uint8_t>(value)); byte(static_cast<uint8_t>(value >> 8)); }
+        void dword(uint32_t value) { word(static_cast<uint16_t>(value)); word(static_cast<uint16_t>(value >> 16)); }
+
+        void mov(int dst, int src) { rex(false, src, 0, dst); byte(0x89); modrm(3, src, dst); }
+        void mov64(int dst, int src) { rex(true, src, 0, dst); byte(0x89); modrm(3, src, dst); }
+        void movImm(int dst, uint32_t imm) { rex(false, 0, 0, dst); byte(0xB8 + (dst & 7)); dword(imm); }
+        void alu(Alu op, int dst, int src) { rex(false, src, 0, dst); byte(static_cast<uint8_t>(op)); modrm(3, src, dst); }
+        void aluImm(AluImm op, int dst, uint32_t imm) { rex(false, 0, 0, dst); byte(0x81); modrm(3, static_cast<int>(op), dst); dword(imm); }
+        void add64(int dst, int src) { rex(true, src, 0, dst); byte(0x01); modrm(3, src, dst); }
+        void shift(Shift op, int dst, uint8_t count) { rex(false, 0, 0, dst); byte(0xC1); modrm(3, static_cast<int>(op), dst); byte(count); }
+        void test64(int reg) { rex(true, reg, 0, reg); byte(0x85); modrm(3, reg, reg); }
+        void testImm(int reg, uint32_t imm) { rex(false, 0, 0, reg); byte(0xF7); modrm(3, 0, reg); dword(imm); }
+
+        // [base + disp32], base must not be RSP or R12
+        void load8(int dst, int base, int32_t disp) { rex(false, dst, 0, base); byte(0x0F); byte(0xB6); memory(dst, base, disp); }
+        void load16(int dst, int base, int32_t disp) { rex(false, dst, 0, base); byte(0x0F); byte(0xB7); memory(dst, base, disp); }
+        void load64(int dst, int base, int32_t disp) { rex(true, dst, 0, base); byte(0x8B); memory(dst, base, disp); }
+        void store8(int base, int32_t disp, int src) { rex(false, src, 0, base); byte(0x88); memory(src, base, disp); }
+        void store16(int base, int32_t disp, int src) { byte(0x66); rex(false, src, 0, base); byte(0x89); memory(src, base, disp); }
+        void storeImm16(int base, int32_t disp, uint16_t imm) { byte(0x66); rex(false, 0, 0, base); byte(0xC7); memory(0, base, disp); word(imm); }
+        void storeImm32(int base, int32_t disp, uint32_t imm) { rex(false, 0, 0, base); byte(0xC7); memory(0, base, disp); dword(imm); }
+        void cmpByteZero(int base, int32_t disp) { rex(false, 0, 0, base); byte(0x80); memory(7, base, disp); byte(0); }
+
+        // [base + index * 8 + disp32]
+        void load64Indexed(int dst, int base, int index, int32_t disp)
+        {
+            rex(true, dst, index, base);
+            byte(0x8B);
+            modrm(2, dst, RSP);
+            sib(3, index, base);
+            dword(static_cast<uint32_t>(disp));
+        }
+
+        // [base + index], base must not be RBP or R13
+        void cmpByteIndexedZero(int base, int index)
+        {
+            rex(false, 0, index, base);
+            byte(0x80);
+            modrm(0, 7, RSP);
+            sib(0, index, base);
+            byte(0);
+        }
+
+        void push(int reg) { rex(false, 0, 0, reg); byte(0x50 + (reg & 7)); }
+        void pop(int reg) { rex(false, 0, 0, reg); byte(0x58 + (reg & 7)); }
+        void ret() { byte(0xC3); }
+
+        // Jumps return the offset just past their rel32 for patching
+        size_t jcc(Condition condition) { byte(0x0F); byte(0x80 | condition); dword(0); return size(); }
+        size_t jmp() { byte(0xE9); dword(0); return size(); }
+
+        void patch(size_t jump, size_t target)
+        {
+            const auto rel = static_cast<int32_t>(target - jump);
+            std::memcpy(&code[jump - 4], &rel, sizeof(rel));
+        }
+
+    private:
+        void rex(bool wide, int reg, int index, int base)
+        {
+            const uint8_t value = 0x40 | (wide << 3) | ((reg & 8) >> 1) | ((index & 8) >> 2) | ((base & 8) >> 3);
+            if (value != 0x40) {
+                byte(value);
+            }
+        }
+
+        void modrm(int mod, int reg, int rm) { byte(static_cast<uint8_t>((mod << 6) | ((reg & 7) << 3) | (rm & 7))); }
+        void sib(int scale, int index, int base) { byte(static_cast<uint8_t>((scale << 6) | ((index & 7) << 3) | (base & 7))); }
+        void memory(int reg, int base, int32_t disp) { modrm(2, reg, base); dword(static_cast<uint32_t>(disp)); }
+    };
+
+    struct Exit {
+        size_t jump;
+        uint16_t pc;
+        uint32_t instructions;
+        uint32_t cycles;
+    };
+
+    constexpr int32_t offset(size_t value) { return static_cast<int32_t>(value); }
+
+    // dst = hi << 8 | lo
+    void loadPair(Emitter& e, int dst, int hi, int lo)
+    {
+        e.mov(dst, hi);
+        e.shift(Shift::Shl, dst, 8);
+        e.alu(Alu::Or, dst, lo);
+    }
+
+    // hi, lo = src & 0xFFFF, clobbers src
+    void storePair(Emitter& e, int hi, int lo, int src)
+    {
+        e.aluImm(AluImm::And, src, 0xFFFF);
+        e.mov(lo, src);
+        e.aluImm(AluImm::And, lo, 0xFF);
+        e.shift(Shift::Shr, src, 8);
+        e.mov(hi, src);
+    }
+
+    void addPair(Emitter& e, int hi, int lo, int32_t delta)
+    {
+        loadPair(e, RAX, hi, lo);
+        e.aluImm(AluImm::Add, RAX, static_cast<uint32_t>(delta));
+        storePair(e, hi, lo, RAX);
+    }
+
+    // flags |= (value == 0) << 7 for an 8 bit value, clobbers tmp
+    void zeroFlag(Emitter& e, int value, int tmp, int flags)
+    {
+        e.mov(tmp, value);
+        e.aluImm(AluImm::Sub, tmp, 1);
+        e.shift(Shift::Shr, tmp, 1);
+        e.aluImm(AluImm::And, tmp, 0x80);
+        e.alu(Alu::Or, flags, tmp);
+    }
+
+    // ADD, ADC, SUB, SBC, AND, XOR, OR and CP of A with the value in ECX
+    void aluA(Emitter& e, int kind)
+    {
+        switch (kind) {
+            case 4:
+            case 5:
+            case 6: {
+                const Alu op = (kind == 4) ? Alu::And : (kind == 5) ? Alu::Xor : Alu::Or;
+                e.alu(op, RegA, RCX);
+                e.movImm(RDI, (kind == 4) ? 0x20 : 0x00);
+                zeroFlag(e, RegA, RDX, RDI);
+                e.aluImm(AluImm::And, RegF, 0x0F);
+                e.alu(Alu::Or, RegF, RDI);
+                return;
+            }
+            default: {
+                const bool subtract = kind >= 2;
+                const bool carry = kind == 1 || kind == 3;
+                e.mov(RAX, RegA);
+                if (carry) {
+                    e.mov(RDX, RegF);
+                    e.shift(Shift::Shr, RDX, 4);
+                    e.aluImm(AluImm::And, RDX, 1);
+                }
+                e.alu(subtract ? Alu::Sub : Alu::Add, RAX, RCX);
+                if (carry) {
+                    e.alu(subtract ? Alu::Sub : Alu::Add, RAX, RDX);
+                }
+                // H from bit 4 of a ^ v ^ r, C from bit 8 of the unmasked result
+                e.mov(RSI, RegA);
+                e.alu(Alu::Xor, RSI, RCX);
+                e.alu(Alu::Xor, RSI, RAX);
+                e.aluImm(AluImm::And, RSI, 0x10);
+                e.shift(Shift::Shl, RSI, 1);
+                e.mov(RDI, RAX);
+                e.shift(Shift::Shr, RDI, 4);
+                e.aluImm(AluImm::And, RDI, 0x10);
+                e.alu(Alu::Or, RDI, RSI);
+                if (subtract) {
+                    e.aluImm(AluImm::Or, RDI, 0x40);
+                }
+                e.aluImm(AluImm::And, RAX, 0xFF);
+                if (kind != 7) {
+                    e.mov(RegA, RAX);
+                }
+                zeroFlag(e, RAX, RDX, RDI);
+                e.aluImm(AluImm::And, RegF, 0x0F);
+                e.alu(Alu::Or, RegF, RDI);
+                return;
+            }
+        }
+    }
+
+    // INC/DEC of an 8 bit value in place, C is preserved. Clobbers EAX, EDX and EDI.
+    void incDec(Emitter& e, int reg, bool decrement)
+    {
+        e.mov(RAX, reg);
+        e.aluImm(decrement ? AluImm::Sub : AluImm::Add, RAX, 1);
+        e.mov(RDI, reg);
+        e.alu(Alu::Xor, RDI, RAX);
+        e.aluImm(AluImm::And, RDI, 0x10);
+        e.shift(Shift::Shl, RDI, 1);
+        if (decrement) {
+            e.aluImm(AluImm::Or, RDI, 0x40);
+        }
+        e.aluImm(AluImm::And, RAX, 0xFF);
+        e.mov(reg, RAX);
+        zeroFlag(e, RAX, RDX, RDI);
+        e.aluImm(AluImm::And, RegF, 0x1F);
+        e.alu(Alu::Or, RegF, RDI);
+    }
+}
+
+Recompiler::Recompiler(Bus* bus, BlockCache& blockCache) :
+    m_bus(bus),
+    m_blockCache(blockCache)
+{
+#ifdef _WIN32
+    m_code = static_cast<uint8_t*>(VirtualAlloc(nullptr, codeBufferSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+#else
+    void* code = mmap(nullptr, codeBufferSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    m_code = (code == MAP_FAILED) ? nullptr : static_cast<uint8_t*>(code);
+#endif
+    if (!m_code) {
+        throw std::runtime_error("Failed to allocate recompiler code buffer!");
+    }
+
+    // Only ROM and work RAM are plain memory, everything else goes through the bus.
+    // ROM pages are filled by mapPages once the cartridge is loaded.
+    auto* map = m_bus->getMap();
+    for (int page = 0xC0; page < 0xE0; ++page) {
+        m_state.readPages[page] = map + (page << 8);
+        m_state.writePages[page] = map + (page << 8);
+    }
+    m_state.hram = map + 0xFF80;
+    m_state.codePages = m_blockCache.codePages();
+}
+
+// ROM pages follow the cartridge banks. Page 0 is left out as it is shadowed by the boot ROM
+// until 0xFF50 is written.
+void Recompiler::mapPages()
+{
+    for (int page = 0x01; page < 0x80; ++page) {
+        m_state.readPages[page] = m_bus->readPage(static_cast<uint8_t>(page));
+    }
+}
+
+Recompiler::~Recompiler()
+{
+#ifdef _WIN32
+    VirtualFree(m_code, 0, MEM_RELEASE);
+#else
+    munmap(m_code, codeBufferSize);
+#endif
+}
+
+NativeBlock Recompiler::compile(const Block& block)
+{
+    // Translated code must not depend on anything that can be rewritten, switching a ROM bank flushes it
+    if (block.start >= 0x8000 || block.end >= 0x8000 || block.end < block.start) {
+        m_blocksRejected++;
+        return nullptr;
+    }
+
+    Emitter e;
+    std::vector<Exit> exits;
+    uint32_t cycles = 0;
+    uint32_t instructions = 0;
+
+    const auto exitAt = [&](size_t jump, uint16_t pc, uint32_t extraCycles = 0) {
+        exits.push_back({ jump, pc, instructions, cycles + extraCycles });
+    };
+
+    // Host address of the guest address in EDX into RAX, leaves the block if it is not plain memory
+    const auto readAddress = [&](uint16_t pc) {
+        e.mov(RAX, RDX);
+        e.shift(Shift::Shr, RAX, 8);
+        e.load64Indexed(RAX, RegState, RAX, offset(offsetof(RecompilerState, readPages)));
+        e.test64(RAX);
+        exitAt(e.jcc(Zero), pc);
+        e.aluImm(AluImm::And, RDX, 0xFF);
+        e.add64(RAX, RDX);
+    };
+
+    // Same for writes into RSI, also leaving when the page holds decoded code
+    const auto writeAddress = [&](uint16_t pc) {
+        e.mov(RAX, RDX);
+        e.shift(Shift::Shr, RAX, 8);
+        e.load64(RSI, RegState, offset(offsetof(RecompilerState, codePages)));
+        e.cmpByteIndexedZero(RSI, RAX);
+        exitAt(e.jcc(NotZero), pc);
+        e.load64Indexed(RSI, RegState, RAX, offset(offsetof(RecompilerState, writePages)));
+        e.test64(RSI);
+        exitAt(e.jcc(Zero), pc);
+        e.aluImm(AluImm::And, RDX, 0xFF);
+        e.add64(RSI, RDX);
+    };
+
+    const auto hramWrite = [&](uint16_t pc) {
+        e.load64(RSI, RegState, offset(offsetof(RecompilerState, codePages)));
+        e.cmpByteZero(RSI, 0xFF);
+        exitAt(e.jcc(NotZero), pc);
+        e.load64(RSI, RegState, offset(offsetof(RecompilerState, hram)));
+    };
+
+    // HRAM without the IE register, everything below is I/O and stays in the interpreter
+    const auto isHram = [](uint16_t addr) { return addr >= 0xFF80 && addr != 0xFFFF; };
+
+    for (auto pushed : { RBX, RBP, RSI, RDI, R12, R13, R14, R15 }) {
+        e.push(pushed);
+    }
+#ifdef _WIN32
+    e.mov64(RegState, RCX);
+#else
+    e.mov64(RegState, RDI);
+#endif
+    e.load8(RegA, RegState, offset(offsetof(RecompilerState, a)));
+    e.load8(RegF, RegState, offset(offsetof(RecompilerState, f)));
+    e.load8(RegB, RegState, offset(offsetof(RecompilerState, b)));
+    e.load8(RegC, RegState, offset(offsetof(RecompilerState, c)));
+    e.load8(RegD, RegState, offset(offsetof(RecompilerState, d)));
+    e.load8(RegE, RegState, offset(offsetof(RecompilerState, e)));
+    e.load8(RegH, RegState, offset(offsetof(RecompilerState, h)));
+    e.load8(RegL, RegState, offset(offsetof(RecompilerState, l)));
+    e.load16(RegSP, RegState, offset(offsetof(RecompilerState, sp)));
+
+    bool terminated = false;
+    for (const auto& decoded : block.instructions) {
+        const auto opcode = decoded.opcode;
+        const auto pc = decoded.address;
+        const uint16_t next = pc + decoded.length;
+        const auto n = decoded.operands[0];
+        const auto nn = static_cast<uint16_t>(decoded.operands[0] | (decoded.operands[1] << 8));
+        const auto dst = operandRegister[(opcode >> 3) & 7];
+        const auto src = operandRegister[opcode & 7];
+        bool translated = true;
+
+        switch (opcode) {
+            case 0x00: break;
+            case 0x01: e.movImm(RegB, nn >> 8); e.movImm(RegC, nn & 0xFF); break;
+            case 0x11: e.movImm(RegD, nn >> 8); e.movImm(RegE, nn & 0xFF); break;
+            case 0x21: e.movImm(RegH, nn >> 8); e.movImm(RegL, nn & 0xFF); break;
+            case 0x31: e.movImm(RegSP, nn); break;
+            case 0x03: addPair(e, RegB, RegC, 1); break;
+            case 0x13: addPair(e, RegD, RegE, 1); break;
+            case 0x23: addPair(e, RegH, RegL, 1); break;
+            case 0x0B: addPair(e, RegB, RegC, -1); break;
+            case 0x1B: addPair(e, RegD, RegE, -1); break;
+            case 0x2B: addPair(e, RegH, RegL, -1); break;
+            case 0x33: e.aluImm(AluImm::Add, RegSP, 1); e.aluImm(AluImm::And, RegSP, 0xFFFF); break;
+            case 0x3B: e.aluImm(AluImm::Sub, RegSP, 1); e.aluImm(AluImm::And, RegSP, 0xFFFF); break;
+            case 0x09: case 0x19: case 0x29: case 0x39: {
+                // ADD HL,rr: Z kept, N cleared, H from bit 11, C from bit 15
+                loadPair(e, RAX, RegH, RegL);
+                if (opcode == 0x39) {
+                    e.mov(RCX, RegSP);
+                }
+                else {
+                    const auto hi = (opcode == 0x09) ? RegB : (opcode == 0x19) ? RegD : RegH;
+                    const auto lo = (opcode == 0x09) ? RegC : (opcode == 0x19) ? RegE : RegL;
+                    loadPair(e, RCX, hi, lo);
+                }
+                e.mov(RDX, RAX);
+                e.alu(Alu::Add, RDX, RCX);
+                e.mov(RSI, RAX);
+                e.alu(Alu::Xor, RSI, RCX);
+                e.alu(Alu::Xor, RSI, RDX);
+                e.aluImm(AluImm::And, RSI, 0x1000);
+                e.shift(Shift::Shr, RSI, 7);
+                e.mov(RDI, RDX);
+                e.shift(Shift::Shr, RDI, 12);
+                e.aluImm(AluImm::And, RDI, 0x10);
+                e.alu(Alu::Or, RDI, RSI);
+                e.aluImm(AluImm::And, RegF, 0x8F);
+                e.alu(Alu::Or, RegF, RDI);
+                storePair(e, RegH, RegL, RDX);
+                break;
+            }
+            case 0x02: case 0x12: case 0x22: case 0x32: {
+                if (opcode == 0x02) loadPair(e, RDX, RegB, RegC);
+                else if (opcode == 0x12) loadPair(e, RDX, RegD, RegE);
+                else loadPair(e, RDX, RegH, RegL);
+                writeAddress(pc);
+                e.store8(RSI, 0, RegA);
+                if (opcode == 0x22) addPair(e, RegH, RegL, 1);
+                if (opcode == 0x32) addPair(e, RegH, RegL, -1);
+                break;
+            }
+            case 0x0A: case 0x1A: case 0x2A: case 0x3A: {
+                if (opcode == 0x0A) loadPair(e, RDX, RegB, RegC);
+                else if (opcode == 0x1A) loadPair(e, RDX, RegD, RegE);
+                else loadPair(e, RDX, RegH, RegL);
+                readAddress(pc);
+                e.load8(RegA, RAX, 0);
+                if (opcode == 0x2A) addPair(e, RegH, RegL, 1);
+                if (opcode == 0x3A) addPair(e, RegH, RegL, -1);
+                break;
+            }
+            case 0x04: case 0x0C: case 0x14: case 0x1C: case 0x24: case 0x2C: case 0x3C:
+            case 0x05: case 0x0D: case 0x15: case 0x1D: case 0x25: case 0x2D: case 0x3D:
+                incDec(e, dst, opcode & 1);
+                break;
+            case 0x34: case 0x35: {
+                loadPair(e, RDX, RegH, RegL);
+                writeAddress(pc);
+                e.load8(RCX, RSI, 0);
+                incDec(e, RCX, opcode & 1);
+                e.store8(RSI, 0, RCX);
+                break;
+            }
+            case 0x06: case 0x0E: case 0x16: case 0x1E: case 0x26: case 0x2E: case 0x3E:
+                e.movImm(dst, n);
+                break;
+            case 0x36: {
+                loadPair(e, RDX, RegH, RegL);
+                writeAddress(pc);
+                e.movImm(RCX, n);
+                e.store8(RSI, 0, RCX);
+                break;
+            }
+            case 0x07: case 0x0F: case 0x17: case 0x1F: {
+                // RLCA, RRCA, RLA, RRA: Z, N and H cleared
+                const bool left = opcode == 0x07 || opcode == 0x17;
+                const bool throughCarry = opcode >= 0x17;
+                e.mov(RAX, RegA);
+                e.shift(left ? Shift::Shr : Shift::Shl, RAX, 7); // bit rotated out, moved to the far end
+                if (!left) {
+                    e.aluImm(AluImm::And, RAX, 0x80);
+                }
+                e.mov(RCX, RAX);
+                e.shift(left ? Shift::Shl : Shift::Shr, RCX, left ? 4 : 3);
+                if (throughCarry) {
+                    e.mov(RAX, RegF);
+                    e.aluImm(AluImm::And, RAX, 0x10);
+                    e.shift(left ? Shift::Shr : Shift::Shl, RAX, left ? 4 : 3);
+                }
+                e.shift(left ? Shift::Shl : Shift::Shr, RegA, 1);
+                e.alu(Alu::Or, RegA, RAX);
+                e.aluImm(AluImm::And, RegA, 0xFF);
+                e.aluImm(AluImm::And, RegF, 0x0F);
+                e.alu(Alu::Or, RegF, RCX);
+                break;
+            }
+            case 0x2F: e.aluImm(AluImm::Xor, RegA, 0xFF); e.aluImm(AluImm::Or, RegF, 0x60); break;
+            case 0x37: e.aluImm(AluImm::And, RegF, 0x8F); e.aluImm(AluImm::Or, RegF, 0x10); break;
+            case 0x3F: e.aluImm(AluImm::And, RegF, 0x9F); e.aluImm(AluImm::Xor, RegF, 0x10); break;
+            case 0xC6: case 0xCE: case 0xD6: case 0xDE: case 0xE6: case 0xEE: case 0xF6: case 0xFE:
+                e.movImm(RCX, n);
+                aluA(e, (opcode >> 3) & 7);
+                break;
+            case 0xE0: case 0xEA: {
+                const uint16_t addr = (opcode == 0xE0) ? 0xFF00 + n : nn;
+                if (isHram(addr)) {
+                    hramWrite(pc);
+                    e.store8(RSI, addr - 0xFF80, RegA);
+                }
+                else if (addr < 0xFE00) {
+                    e.movImm(RDX, addr);
+                    writeAddress(pc);
+                    e.store8(RSI, 0, RegA);
+                }
+                else {
+                    translated = false;
+                }
+                break;
+            }
+            case 0xF0: case 0xFA: {
+                const uint16_t addr = (opcode == 0xF0) ? 0xFF00 + n : nn;
+                if (isHram(addr)) {
+                    e.load64(RAX, RegState, offset(offsetof(RecompilerState, hram)));
+                    e.load8(RegA, RAX, addr - 0xFF80);
+                }
+                else if (addr < 0xFE00) {
+                    e.movImm(RDX, addr);
+                    readAddress(pc);
+                    e.load8(RegA, RAX, 0);
+                }
+                else {
+                    translated = false;
+                }
+                break;
+            }
+            case 0x18: {
+                cycles += decoded.cycles;
+                instructions++;
+                exitAt(e.jmp(), static_cast<uint16_t>(next + static_cast<int8_t>(n)));
+                terminated = true;
+                break;
+            }
+            case 0xC3: {
+                cycles += decoded.cycles;
+                instructions++;
+                exitAt(e.jmp(), nn);
+                terminated = true;
+                break;
+            }
+            case 0x20: case 0x28: case 0x30: case 0x38:
+            case 0xC2: case 0xCA: case 0xD2: case 0xDA: {
+                const bool relative = opcode < 0x40;
+                const uint16_t target = relative ? static_cast<uint16_t>(next + static_cast<int8_t>(n)) : nn;
+                const auto condition = (opcode >> 3) & 3; // NZ, Z, NC, C
+                e.testImm(RegF, (condition < 2) ? 0x80 : 0x10);
+                cycles += decoded.cycles;
+                instructions++;
+                // NZ and NC are not taken when the flag is set, Z and C when it is clear
+                exitAt(e.jcc((condition & 1) ? Zero : NotZero), next);
+                exitAt(e.jmp(), target, takenBranchCycles);
+                terminated = true;
+                break;
+            }
+            default: {
+                if (opcode >= 0x40 && opcode < 0x80 && opcode != 0x76) {
+                    if (dst < 0) {
+                        loadPair(e, RDX, RegH, RegL);
+                        writeAddress(pc);
+                        e.store8(RSI, 0, src);
+                    }
+                    else if (src < 0) {
+                        loadPair(e, RDX, RegH, RegL);
+                        readAddress(pc);
+                        e.load8(dst, RAX, 0);
+                    }
+                    else if (dst != src) {
+                        e.mov(dst, src);
+                    }
+                }
+                else if (opcode >= 0x80 && opcode < 0xC0) {
+                    if (src < 0) {
+                        loadPair(e, RDX, RegH, RegL);
+                        readAddress(pc);
+                        e.load8(RCX, RAX, 0);
+                    }
+                    else {
+                        e.mov(RCX, src);
+                    }
+                    aluA(e, (opcode >> 3) & 7);
+                }
+                else {
+                    translated = false;
+                }
+                break;
+            }
+        }
+
+        if (terminated) {
+            break;
+        }
+        if (!translated) {
+            exitAt(e.jmp(), pc);
+            terminated = true;
+            break;
+        }
+        cycles += decoded.cycles;
+        instructions++;
+    }
+
+    if (instructions == 0) {
+        m_blocksRejected++;
+        return nullptr;
+    }
+    if (!terminated) {
+        const auto& last = block.instructions.back();
+        exitAt(e.jmp(), static_cast<uint16_t>(last.address + last.length));
+    }
+
+    // Exit stubs record where the interpreter resumes and jump to the shared epilogue
+    std::vector<size_t> stubJumps;
+    for (const auto& exit : exits) {
+        e.patch(exit.jump, e.size());
+        e.storeImm16(RegState, offset(offsetof(RecompilerState, pc)), exit.pc);
+        e.storeImm32(RegState, offset(offsetof(RecompilerState, instructions)), exit.instructions);
+        e.movImm(RAX, exit.cycles);
+        stubJumps.push_back(e.jmp());
+    }
+    for (const auto jump : stubJumps) {
+        e.patch(jump, e.size());
+    }
+
+    e.store8(RegState, offset(offsetof(RecompilerState, a)), RegA);
+    e.store8(RegState, offset(offsetof(RecompilerState, f)), RegF);
+    e.store8(RegState, offset(offsetof(RecompilerState, b)), RegB);
+    e.store8(RegState, offset(offsetof(RecompilerState, c)), RegC);
+    e.store8(RegState, offset(offsetof(RecompilerState, d)), RegD);
+    e.store8(RegState, offset(offsetof(RecompilerState, e)), RegE);
+    e.store8(RegState, offset(offsetof(RecompilerState, h)), RegH);
+    e.store8(RegState, offset(offsetof(RecompilerState, l)), RegL);
+    e.store16(RegState, offset(offsetof(RecompilerState, sp)), RegSP);
+    for (auto popped : { R15, R14, R13, R12, RDI, RSI, RBP, RBX }) {
+        e.pop(popped);
+    }
+    e.ret();
+
+    return install(e.code);
+}
+
+NativeBlock Recompiler::install(const std::vector<uint8_t>& code)
+{
+    // A full buffer starts over, blocks get translated again as they turn hot
+    if (m_codeUsed + code.size() > codeBufferSize) {
+        m_blockCache.forgetNative();
+        m_codeUsed = 0;
+        m_bufferFlushes++;
+    }
+
+    // Pages are writable or executable but never both
+#ifdef _WIN32
+    DWORD previous{};
+    VirtualProtect(m_code, codeBufferSize, PAGE_READWRITE, &previous);
+    std::memcpy(m_code + m_codeUsed, code.data(), code.size());
+    VirtualProtect(m_code, codeBufferSize, PAGE_EXECUTE_READ, &previous);
+#else
+    mprotect(m_code, codeBufferSize, PROT_READ | PROT_WRITE);
+    std::memcpy(m_code + m_codeUsed, code.data(), code.size());
+    mprotect(m_code, codeBufferSize, PROT_READ | PROT_EXEC);
+#endif
+
+    const auto native = reinterpret_cast<NativeBlock>(m_code + m_codeUsed);
+    m_codeUsed += (code.size() + 15) & ~size_t{15};
+    m_blocksCompiled++;
+    return native;
+}
+
+void Recompiler::recordRun(uint32_t instructions, bool sideExit)
+{
+    m_runs++;
+    m_instructions += instructions;
+    if (sideExit) {
+        m_sideExits++;
+    }
+}
+
+void Recompiler::printStats() const
+{
+    std::cout << std::dec << "Recompiler:\n"
+        << "blocksCompiled=" << m_blocksCompiled << " blocksRejected=" << m_blocksRejected
+        << " codeBytes=" << m_codeUsed << " bufferFlushes=" << m_bufferFlushes << "\n"
+        << "runs=" << m_runs << " instructions=" << m_instructions
+        << " avgRun=" << (m_runs ? double(m_instructions) / m_runs : 0.0)
+        << " sideExits=" << m_sideExits << " verified=" << m_blocksVerified << "\n";
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "BlockCache.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Bus;
+
+// Guest state shared with translated code. Registers are loaded into host registers
+// on block entry and stored back on exit together with the PC and instruction count.
+struct RecompilerState {
+    uint8_t a{}, f{}, b{}, c{}, d{}, e{}, h{}, l{};
+    uint16_t sp{};
+    uint16_t pc{};
+    uint32_t instructions{};
+    const uint8_t* codePages{}; // non-zero for pages holding decoded RAM code
+    uint8_t* hram{};
+    std::array<const uint8_t*, 256> readPages{}; // nullptr leaves the block
+    std::array<uint8_t*, 256> writePages{};
+};
+
+// Tier-2 engine translating hot ROM blocks of the block cache into x86-64 code.
+// Any access it cannot prove to be plain memory exits back to the interpreter.
+class Recompiler {
+public:
+    Recompiler(Bus* bus, BlockCache& blockCache);
+    ~Recompiler();
+    Recompiler(const Recompiler&) = delete;
+    Recompiler& operator=(const Recompiler&) = delete;
+
+    // Counts an entry into the block and returns its translation once it is hot
+    NativeBlock lookup(Block& block)
+    {
+        if (block.native || ++block.executions != hotThreshold) {
+            return block.native;
+        }
+        block.native = compile(block);
+        return block.native;
+    }
+
+    RecompilerState& state() { return m_state; }
+    void mapPages();
+    void recordRun(uint32_t instructions, bool sideExit);
+    void recordVerified() { m_blocksVerified++; }
+    uint64_t blocksVerified() const { return m_blocksVerified; }
+    void printStats() const;
+
+    static constexpr uint32_t hotThreshold = 64;
+    static constexpr uint32_t takenBranchCycles = 4; // on top of the static cost in the decoded instruction
+    static constexpr size_t codeBufferSize = 4 * 1024 * 1024;
+
+private:
+    NativeBlock compile(const Block& block);
+    NativeBlock install(const std::vector<uint8_t>& code);
+
+    Bus* m_bus{};
+    BlockCache& m_blockCache;
+    RecompilerState m_state{};
+
+    uint8_t* m_code{};
+    size_t m_codeUsed{};
+
+    uint64_t m_blocksCompiled{};
+    uint64_t m_blocksRejected{};
+    uint64_t m_bufferFlushes{};
+    uint64_t m_runs{};
+    uint64_t m_sideExits{};
+    uint64_t m_instructions{};
+    uint64_t m_blocksVerified{};
+};
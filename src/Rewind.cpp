@@ -0,0 +1,150 @@
+#include "Rewind.hpp"
+
+#include "Bus.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+Rewind::Rewind(Bus* bus, size_t budget) : m_bus(bus), m_budget(budget) {}
+
+void Rewind::allocate()
+{
+    const auto size = m_bus->stateSize();
+    m_current.resize(size);
+    m_next.resize(size);
+    m_delta.resize(size + 4 * (size / maxRun + 2)); // worst case, every run header is paid for by the bytes it skips
+    if (m_budget < m_delta.size()) {
+        throw std::runtime_error("Rewind budget is smaller than a save state!");
+    }
+    m_ring.resize(m_budget);
+    m_snapshots.resize(maxSnapshots);
+}
+
+void Rewind::capture()
+{
+    const auto start = std::chrono::steady_clock::now();
+    if (m_current.empty()) {
+        allocate();
+    }
+
+    m_bus->saveState(m_next.data(), m_next.size());
+    if (m_valid) {
+        const auto size = encode(m_current.data(), m_next.data(), m_delta.data());
+        while (m_count == maxSnapshots || m_used + size > m_ring.size()) {
+            dropOldest();
+        }
+        const auto first = std::min(size, m_ring.size() - m_end);
+        std::memcpy(m_ring.data() + m_end, m_delta.data(), first);
+        std::memcpy(m_ring.data(), m_delta.data() + first, size - first);
+        m_snapshots[(m_first + m_count) % maxSnapshots] = { m_end, size };
+        m_count++;
+        m_used += size;
+        m_end = (m_end + size) % m_ring.size();
+        m_deltas++;
+        m_encodedBytes += size;
+    }
+    std::swap(m_current, m_next);
+    m_valid = true;
+
+    m_captures++;
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    m_captureTime += elapsed.count();
+}
+
+void Rewind::stepBack(uint32_t steps)
+{
+    if (!m_valid) {
+        return;
+    }
+
+    for (uint32_t step = 0; step < steps && m_count; ++step) {
+        const auto& newest = m_snapshots[(m_first + m_count - 1) % maxSnapshots];
+        const auto first = std::min(newest.size, m_ring.size() - newest.offset);
+        std::memcpy(m_delta.data(), m_ring.data() + newest.offset, first);
+        std::memcpy(m_delta.data() + first, m_ring.data(), newest.size - first);
+        decode(m_delta.data(), newest.size, m_current.data());
+        m_count--;
+        m_used -= newest.size;
+        m_end = newest.offset;
+    }
+    m_bus->loadState(m_current.data(), m_current.size());
+}
+
+void Rewind::dropOldest()
+{
+    m_used -= m_snapshots[m_first].size;
+    m_first = (m_first + 1) % maxSnapshots;
+    m_count--;
+    m_dropped++;
+}
+
+size_t Rewind::encode(const uint8_t* older, const uint8_t* newer, uint8_t* out) const
+{
+    const auto size = m_current.size();
+    const auto equalRun = [=](size_t i) {
+        const auto end = std::min(i + minEqualRun, size);
+        return std::equal(older + i, older + end, newer + i);
+    };
+    const auto put16 = [out](size_t& written, size_t value) {
+        out[written++] = static_cast<uint8_t>(value);
+        out[written++] = static_cast<uint8_t>(value >> 8);
+    };
+
+    size_t in = 0;
+    size_t written = 0;
+    while (in < size) {
+        // Most of the state is unchanged between snapshots, skip it a word at a time
+        size_t equal = 0;
+        while (in + equal + 8 <= size && equal + 8 <= maxRun && std::memcmp(older + in + equal, newer + in + equal, 8) == 0) {
+            equal += 8;
+        }
+        while (in + equal < size && equal < maxRun && older[in + equal] == newer[in + equal]) {
+            equal++;
+        }
+        in += equal;
+
+        size_t changed = 0;
+        while (in + changed < size && changed < maxRun && !equalRun(in + changed)) {
+            changed++;
+        }
+
+        put16(written, equal);
+        put16(written, changed);
+        for (size_t i = 0; i < changed; ++i) {
+            out[written++] = older[in + i] ^ newer[in + i];
+        }
+        in += changed;
+    }
+    return written;
+}
+
+// XORs the delta into the newer state, which leaves the older one
+void Rewind::decode(const uint8_t* delta, size_t size, uint8_t* state) const
+{
+    size_t in = 0;
+    size_t offset = 0;
+    while (in < size) {
+        const size_t equal = delta[in] | (delta[in + 1] << 8);
+        const size_t changed = delta[in + 2] | (delta[in + 3] << 8);
+        in += 4;
+        offset += equal;
+        for (size_t i = 0; i < changed; ++i) {
+            state[offset + i] ^= delta[in + i];
+        }
+        offset += changed;
+        in += changed;
+    }
+}
+
+void Rewind::printStats() const
+{
+    std::cout << std::dec << "Rewind:\n"
+        << "captures=" << m_captures << " kept=" << m_count << " dropped=" << m_dropped
+        << " ringUsed=" << m_used << "/" << m_ring.size() << " bytes\n"
+        << "stateSize=" << m_current.size() << " avgDelta=" << (m_deltas ? double(m_encodedBytes) / m_deltas : 0.0)
+        << " bytes avgCapture=" << (m_captures ? 1e6 * m_captureTime / m_captures : 0.0) << " us\n";
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Bus;
+
+// Save states taken every few frames for stepping back in time. Only the newest state is
+// kept whole, each older one is stored as its XOR with the next newer state, run-length
+// encoded, in a ring of fixed size. The oldest states are dropped once the ring is full.
+class Rewind {
+public:
+    Rewind(Bus* bus, size_t budget);
+
+    void capture();
+    // Restores the state `steps` snapshots back, or the oldest one still kept
+    void stepBack(uint32_t steps);
+    void printStats() const;
+
+    static constexpr size_t maxSnapshots = 1 << 16;
+
+private:
+    // Delta entries are runs of [uint16 unchanged bytes][uint16 changed bytes][XOR of the changed bytes].
+    // Fewer than minEqualRun unchanged bytes are cheaper to keep inside the changed run.
+    static constexpr size_t minEqualRun = 4;
+    static constexpr size_t maxRun = 0xFFFF;
+
+    size_t encode(const uint8_t* older, const uint8_t* newer, uint8_t* out) const;
+    void decode(const uint8_t* delta, size_t size, uint8_t* state) const;
+    void allocate();
+    void dropOldest();
+
+    struct Snapshot {
+        size_t offset{}; // into m_ring, the delta may wrap around its end
+        size_t size{};
+    };
+
+    Bus* m_bus{};
+    size_t m_budget{};
+
+    // Sized on the first capture, when the cartridge and so the state size are known
+    std::vector<uint8_t> m_ring{};
+    std::vector<uint8_t> m_current{};
+    std::vector<uint8_t> m_next{};
+    std::vector<uint8_t> m_delta{};
+    std::vector<Snapshot> m_snapshots{}; // circular, m_first is the oldest
+    size_t m_first{};
+    size_t m_count{};
+    size_t m_used{};
+    size_t m_end{}; // where the next delta goes
+    bool m_valid = false; // m_current holds a state
+
+    uint64_t m_captures{};
+    uint64_t m_deltas{};
+    uint64_t m_encodedBytes{};
+    uint64_t m_dropped{};
+    double m_captureTime{}; // seconds
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+// Save states are a fixed sequence of fields in host byte order, each component writing its
+// own in a fixed order. The writer and reader only move a cursor over a buffer the caller
+// owns, so taking or restoring a state never allocates. A writer without a buffer only
+// counts, which is how the size of the buffer is found.
+class StateWriter {
+public:
+    StateWriter(uint8_t* data = nullptr, size_t size = 0) : m_data(data), m_size(size) {}
+
+    template<typename T>
+    void put(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        put(reinterpret_cast<const uint8_t*>(&value), sizeof(T));
+    }
+
+    void put(const uint8_t* data, size_t size)
+    {
+        if (m_data && size) {
+            if (m_size - m_offset < size) {
+                throw std::runtime_error("Save state buffer too small!");
+            }
+            std::memcpy(m_data + m_offset, data, size);
+        }
+        m_offset += size;
+    }
+
+    size_t size() const { return m_offset; }
+
+private:
+    uint8_t* m_data{};
+    size_t m_size{};
+    size_t m_offset{};
+};
+
+class StateReader {
+public:
+    StateReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    template<typename T>
+    void get(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        get(reinterpret_cast<uint8_t*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    T get()
+    {
+        T value{};
+        get(value);
+        return value;
+    }
+
+    void get(uint8_t* data, size_t size)
+    {
+        if (m_size - m_offset < size) {
+            throw std::runtime_error("Save state truncated!");
+        }
+        if (size) {
+            std::memcpy(data, m_data + m_offset, size);
+        }
+        m_offset += size;
+    }
+
+    size_t size() const { return m_offset; }
+
+private:
+    const uint8_t* m_data{};
+    size_t m_size{};
+    size_t m_offset{};
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "SaveState.hpp"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+enum class Event : uint8_t {
+    Timer,        // TIMA overflow, reloads TMA and requests the timer interrupt
+    Serial,       // transfer complete
+    PPULine,      // LY advances, raises the VBlank and LYC interrupts
+    Sound,        // APU step at the frame sequencer rate
+    ScreenUpdate, // present the frame and poll input
+    SaveFlush,    // write back changed battery RAM
+    Dma,          // OAM DMA done, the CPU gets the bus back
+    Count
+};
+
+// One deadline per event kind on the absolute cycle counter. There are few enough kinds
+// that rescanning the slots on every change is cheaper than maintaining a heap.
+class Scheduler {
+public:
+    static constexpr uint64_t never = std::numeric_limits<uint64_t>::max();
+
+    Scheduler() { m_deadlines.fill(never); }
+
+    void schedule(Event event, uint64_t cycle)
+    {
+        m_deadlines[static_cast<size_t>(event)] = cycle;
+        update();
+    }
+
+    void cancel(Event event) { schedule(event, never); }
+
+    uint64_t next() const { return m_next; }
+    Event nextEvent() const { return m_nextEvent; }
+
+    void saveState(StateWriter& state) const { state.put(m_deadlines); }
+
+    void loadState(StateReader& state)
+    {
+        state.get(m_deadlines);
+        update();
+    }
+
+private:
+    void update()
+    {
+        m_next = never;
+        for (size_t i = 0; i < m_deadlines.size(); ++i) {
+            if (m_deadlines[i] < m_next) {
+                m_next = m_deadlines[i];
+                m_nextEvent = static_cast<Event>(i);
+            }
+        }
+    }
+
+    std::array<uint64_t, static_cast<size_t>(Event::Count)> m_deadlines{};
+    uint64_t m_next = never;
+    Event m_nextEvent = Event::Count;
+};
@@ -1,13 +1,12 @@
 #include "Screen.hpp"
 
-#include "Bus.hpp"
 #include "Utils.hpp"
 
 #include <SFML/Graphics.hpp>
 
 #include <iostream>
 
-Screen::Screen(Bus* bus) : m_bus(bus)
+Screen::Screen()
 {
     constexpr int delta = 20;
     m_mainWindow.create(sf::VideoMode(sf::Vector2u(m_mainWidth, m_mainHeight)), "tameBOY");
@@ -32,7 +31,7 @@ Screen::Screen(Bus* bus) : m_bus(bus)
     m_objectWindow.setPosition(windowPosition + sf::Vector2i{m_mainScale * m_mainWidth + m_tileDataScale * m_tileDataWidth + m_tileMapScale * m_tileMapWidth + 3 * delta, 0});
 }
 
-void Screen::update(const std::vector<uint8_t>& frameBuffer)
+void Screen::present(const std::vector<uint8_t>& frameBuffer)
 {
     if(!m_mainWindow.isOpen()) {
         m_running = false;
@@ -44,7 +43,6 @@ void Screen::update(const std::vector<uint8_t>& frameBuffer)
             m_mainWindow.close();
         }
 
-        const uint8_t currentJoypad = m_joypad;
         if (event->is<sf::Event::KeyPressed>()) {  // active low
             const auto code = event->getIf<sf::Event::KeyPressed>()->code;
             if (code == sf::Keyboard::Key::Down) { m_joypad = Utils::clearBit(m_joypad, 7); }
@@ -55,6 +53,7 @@ void Screen::update(const std::vector<uint8_t>& frameBuffer)
             if (code == sf::Keyboard::Key::A) { m_joypad = Utils::clearBit(m_joypad, 2); }
             if (code == sf::Keyboard::Key::Z) { m_joypad = Utils::clearBit(m_joypad, 1); }
             if (code == sf::Keyboard::Key::X) { m_joypad = Utils::clearBit(m_joypad, 0); }
+            if (code == sf::Keyboard::Key::Backspace) { m_rewinding = true; }
         }
 
         if (event->is<sf::Event::KeyReleased>()) {
@@ -67,11 +66,7 @@ void Screen::update(const std::vector<uint8_t>& frameBuffer)
             if (code == sf::Keyboard::Key::A) { m_joypad = Utils::setBit(m_joypad, 2); }
             if (code == sf::Keyboard::Key::Z) { m_joypad = Utils::setBit(m_joypad, 1); }
             if (code == sf::Keyboard::Key::X) { m_joypad = Utils::setBit(m_joypad, 0); }
-        }
-
-        if (currentJoypad != m_joypad) {
-            const auto newInterruptFlag = Utils::setBit(m_bus->read(0xFF0F), static_cast<int>(Interrupt::Joypad));
-            m_bus->write(0xFF0F, newInterruptFlag);
+            if (code == sf::Keyboard::Key::Backspace) { m_rewinding = false; }
         }
     }
 
@@ -82,7 +77,7 @@ void Screen::update(const std::vector<uint8_t>& frameBuffer)
     m_mainWindow.display();
 }
 
-void Screen::updateDebug(const std::vector<uint8_t>& tileDataBuffer,
+void Screen::presentDebug(const std::vector<uint8_t>& tileDataBuffer,
     const std::vector<uint8_t>& tileMapBuffer, const std::vector<uint8_t>& objectBuffer)
 {
     while (const std::optional event = m_tileDataWindow.pollEvent()) {
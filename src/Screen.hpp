@@ -1,19 +1,22 @@
 #pragma once
 
+#include "VideoSink.hpp"
+
 #include <SFML/Graphics.hpp>
 
 #include <optional>
 
-class Bus;
-
-class Screen {
+// SFML windows for the game and the VRAM viewers, and the keyboard as joypad
+class Screen : public VideoSink {
 public:
-    Screen(Bus* bus);
-    void update(const std::vector<uint8_t>& frameBuffer);
-    void updateDebug(const std::vector<uint8_t>& tileDataBuffer,
-        const std::vector<uint8_t>& tileMapBuffer, const std::vector<uint8_t>& objectBuffer);
+    Screen();
+    void present(const std::vector<uint8_t>& frameBuffer) override;
+    bool wantsDebug() const override { return true; }
+    void presentDebug(const std::vector<uint8_t>& tileDataBuffer,
+        const std::vector<uint8_t>& tileMapBuffer, const std::vector<uint8_t>& objectBuffer) override;
 
-    uint8_t getJoypad() { return m_joypad; }
+    uint8_t joypad() const override { return m_joypad; }
+    bool rewinding() const override { return m_rewinding; }
 
 private:
     sf::RenderWindow m_mainWindow;
@@ -45,7 +48,7 @@ private:
     int m_objectScale = 3;
 
     bool m_running = true;
+    bool m_rewinding = false; // backspace held
 
-    Bus* m_bus;
     uint8_t m_joypad{0xFF}; // down, up, left, right, start, select, b, a
 };
@@ -1,8 +1,11 @@
 #pragma once
 
-#include <SFML/Audio.hpp>
+#include "AudioSink.hpp"
+#include "SaveState.hpp"
 
-#include <vector>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
 
 class Bus;
 
@@ -28,7 +31,7 @@ public:
         }
     }
 
-    uint8_t get() { return m_waveform(m_index); }
+    uint8_t get() { return m_waveform[m_index]; }
    
     void setPeriod(uint16_t period) { m_period = period; }
     
@@ -45,14 +48,50 @@ public:
                     const auto value = m_bus->read(0xFF30 + offset);
                     const auto msn = static_cast<uint8_t>(value >> 4);
                     const auto lsn = static_cast<uint8_t>(value & 0b0000'1111);
-                    m_period[2 * offset] = msn;
-                    m_period[2 * offset + 1] = lsn;
+                    m_waveform[2 * offset] = msn;
+                    m_waveform[2 * offset + 1] = lsn;
                 }
             }
             default: { throw std::runtime_error("Invalid duty cycle value"); }
         }
     }
 
+    void saveState(StateWriter& state) const
+    {
+        state.put(m_timer);
+        state.put(m_period);
+        state.put(m_index);
+        state.put(m_waveform);
+        state.put(m_pace);
+        state.put(m_direction);
+        state.put(individualStep);
+        state.put(m_waveDuty);
+        state.put(m_initialLengthTimer);
+        state.put(m_initialVolume);
+        state.put(m_envDir);
+        state.put(m_sweepPace);
+        state.put(m_trigger);
+        state.put(m_lengthEnable);
+    }
+
+    void loadState(StateReader& state)
+    {
+        state.get(m_timer);
+        state.get(m_period);
+        state.get(m_index);
+        state.get(m_waveform);
+        state.get(m_pace);
+        state.get(m_direction);
+        state.get(individualStep);
+        state.get(m_waveDuty);
+        state.get(m_initialLengthTimer);
+        state.get(m_initialVolume);
+        state.get(m_envDir);
+        state.get(m_sweepPace);
+        state.get(m_trigger);
+        state.get(m_lengthEnable);
+    }
+
 private:
     int32_t m_timer{}; // TODO - check type
     uint16_t m_period{};
@@ -76,25 +115,24 @@ private:
     Bus* m_bus{};
 };
 
-class Sound : public sf::SoundStream {
+// The APU registers and channels. Output goes to the sink the bus was given, if any.
+class Sound {
 public:
-    Sound(Bus* bus);
+    Sound(Bus* bus, AudioSink* sink);
     void tick(uint64_t cycles);
     void printState();
 
+    // Channel state, the registers themselves are saved with the rest of 0xFF00-0xFFFF
+    void saveState(StateWriter& state) const;
+    void loadState(StateReader& state);
+
 private:
-    bool onGetData(Chunk& data) override;
-    void onSeek(sf::Time timeOffset) override;
+    Bus* m_bus{};
+    AudioSink* m_sink{};
+    bool m_started = false;
 
-    std::vector<std::int16_t> m_samples{};
-    std::size_t m_currentSample{};
-    static constexpr uint32_t m_blockSize = 4000;
-    static constexpr uint32_t m_sampleRate = 44100;
-   
     Channel<8> m_channel1;
     Channel<8> m_channel2;
     Channel<32> m_channel3;
     Channel<8> m_channel4;
- 
-    Bus* m_bus{};
 };
@@ -0,0 +1,26 @@
+#include "TileCache.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+TileCache::TileCache(const uint8_t* vram) : m_vram(vram), m_decodeRows(PixelKernels::best().decodeRows)
+{
+    m_dirty.set();
+}
+
+void TileCache::decode(size_t tile)
+{
+    auto& pixels = m_tiles[tile];
+    m_decodeRows(m_vram + tile * 16, pixels.data(), 8);
+    for (int j = 0; j < 8; ++j) {
+        std::reverse_copy(pixels.begin() + 8 * j, pixels.begin() + 8 * j + 8, m_flipped[tile].begin() + 8 * j);
+    }
+    m_dirty.reset(tile);
+    m_decodes++;
+}
+
+void TileCache::printStats() const
+{
+    std::cout << std::dec << "Tile cache:\n"
+        << "decodes=" << m_decodes << " invalidations=" << m_invalidations << " dirty=" << m_dirty.count() << "\n";
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "PixelKernels.hpp"
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+
+// The 384 tiles at 0x8000-0x97FF decoded to one colour index per pixel, and mirrored for
+// objects flipped in X. Writes only mark the tile, it is decoded again when next drawn.
+class TileCache {
+public:
+    TileCache(const uint8_t* vram);
+
+    void invalidate(uint16_t addr)
+    {
+        m_dirty.set((addr - 0x8000) >> 4);
+        m_invalidations++;
+    }
+
+    void invalidateAll() { m_dirty.set(); }
+
+    // 8 colour indices, left to right on screen. tileAddr is the address of the tile's first byte.
+    const uint8_t* row(uint16_t tileAddr, int row, bool xFlip = false)
+    {
+        const auto tile = static_cast<size_t>((tileAddr - 0x8000) >> 4);
+        if (m_dirty.test(tile)) {
+            decode(tile);
+        }
+        return (xFlip ? m_flipped : m_tiles)[tile].data() + row * 8;
+    }
+
+    void printStats() const;
+
+    static constexpr size_t tileCount = 384;
+
+private:
+    void decode(size_t tile);
+
+    const uint8_t* m_vram{};
+    PixelKernels::DecodeRows m_decodeRows{};
+    std::array<std::array<uint8_t, 64>, tileCount> m_tiles{};
+    std::array<std::array<uint8_t, 64>, tileCount> m_flipped{};
+    std::bitset<tileCount> m_dirty{};
+
+    uint64_t m_decodes{};
+    uint64_t m_invalidations{};
+};
@@ -0,0 +1,140 @@
+#include "Timer.hpp"
+
+#include "Bus.hpp"
+#include "SaveState.hpp"
+#include "Utils.hpp"
+
+#include <algorithm>
+
+Timer::Timer(Bus* bus) : m_bus(bus)
+{
+    m_bus->mapIo(0xFF04, 0xFF, [this](uint8_t) { writeDivider(m_bus->cycles()); }, [this]() {
+        return static_cast<uint8_t>(counter(m_bus->cycles()) >> 8);
+    });
+    m_bus->mapIo(0xFF05, 0xFF, [this](uint8_t value) {
+        sync(m_bus->cycles());
+        m_tima = value; // also cancels a pending reload
+        schedule();
+    }, [this]() {
+        sync(m_bus->cycles());
+        return static_cast<uint8_t>(m_tima);
+    });
+    m_bus->mapIo(0xFF06, 0xFF, [this](uint8_t value) { m_tma = value; }, [this]() { return m_tma; });
+    m_bus->mapIo(0xFF07, 0x07, [this](uint8_t value) { writeControl(m_bus->cycles(), value); }, [this]() {
+        return static_cast<uint8_t>(0b1111'1000 | m_tac);
+    });
+}
+
+void Timer::sync(uint64_t cycle)
+{
+    if (enabled() && m_tima <= 0xFF) {
+        const auto shift = edgeShift();
+        const auto edges = (counter(cycle) >> shift) - (counter(m_syncCycle) >> shift);
+        m_tima = static_cast<uint16_t>(std::min<uint64_t>(m_tima + edges, 0x100));
+    }
+    m_syncCycle = cycle;
+}
+
+// A falling edge outside the regular counting, from a DIV or TAC write
+void Timer::increment(uint64_t cycle)
+{
+    if (m_tima <= 0xFF && ++m_tima == 0x100) {
+        m_overflowCycle = cycle;
+    }
+}
+
+void Timer::schedule()
+{
+    auto& scheduler = m_bus->scheduler();
+    if (m_tima > 0xFF) {
+        scheduler.schedule(Event::Timer, m_overflowCycle + reloadDelay);
+        return;
+    }
+    if (!enabled()) {
+        scheduler.cancel(Event::Timer);
+        return;
+    }
+
+    const auto shift = edgeShift();
+    const auto edge = ((counter(m_syncCycle) >> shift) + (0x100 - m_tima)) << shift;
+    m_overflowCycle = m_resetCycle + edge;
+    scheduler.schedule(Event::Timer, m_overflowCycle + reloadDelay);
+}
+
+void Timer::overflow(uint64_t cycle)
+{
+    sync(cycle);
+    if (m_tima > 0xFF) {
+        m_tima = m_tma;
+        auto& interruptFlag = m_bus->io(0xFF0F);
+        interruptFlag = Utils::setBit(interruptFlag, static_cast<int>(Interrupt::Timer));
+    }
+    schedule();
+}
+
+// Resetting the counter is a falling edge when the selected bit was set
+void Timer::writeDivider(uint64_t cycle)
+{
+    sync(cycle);
+    if (timerInput(cycle)) {
+        increment(cycle);
+    }
+    m_resetCycle = cycle;
+    m_syncCycle = cycle;
+    schedule();
+}
+
+// TIMA sees the selected bit ANDed with the enable, switching it from 1 to 0 is an edge too
+void Timer::writeControl(uint64_t cycle, uint8_t value)
+{
+    sync(cycle);
+    const auto before = timerInput(cycle);
+    m_tac = value & 0b0000'0111;
+    if (before && !timerInput(cycle)) {
+        increment(cycle);
+    }
+    schedule();
+}
+
+uint64_t Timer::nextChange(uint16_t addr) const
+{
+    const auto now = m_bus->cycles();
+    if (addr == 0xFF04) {
+        return m_resetCycle + (((counter(now) >> 8) + 1) << 8);
+    }
+    if (addr == 0xFF05 && enabled() && m_tima <= 0xFF) {
+        const auto shift = edgeShift();
+        return m_resetCycle + (((counter(now) >> shift) + 1) << shift);
+    }
+    return Scheduler::never; // only changes in the overflow event or on writes
+}
+
+// Only differences of cycles are ever taken, so the reset cycle may wrap below 0
+void Timer::presetCounter(uint16_t value)
+{
+    const auto cycle = m_bus->cycles();
+    sync(cycle);
+    m_resetCycle = cycle - value;
+    m_syncCycle = cycle;
+    schedule();
+}
+
+void Timer::saveState(StateWriter& state) const
+{
+    state.put(m_resetCycle);
+    state.put(m_syncCycle);
+    state.put(m_overflowCycle);
+    state.put(m_tima);
+    state.put(m_tma);
+    state.put(m_tac);
+}
+
+void Timer::loadState(StateReader& state)
+{
+    state.get(m_resetCycle);
+    state.get(m_syncCycle);
+    state.get(m_overflowCycle);
+    state.get(m_tima);
+    state.get(m_tma);
+    state.get(m_tac);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+class Bus;
+class StateReader;
+class StateWriter;
+
+// DIV and TIMA derived from the bus cycle counter. DIV is the top byte of a 16-bit counter
+// that starts at the last DIV write, TIMA counts falling edges of the counter bit selected
+// by TAC. Nothing runs per instruction: registers are computed when read and the only
+// event is the TIMA overflow.
+class Timer {
+public:
+    Timer(Bus* bus);
+
+    // Event::Timer, TIMA is reloaded from TMA and the interrupt requested
+    void overflow(uint64_t cycle);
+
+    // First cycle at which a read of addr may return a different value, for idle loop skipping
+    uint64_t nextChange(uint16_t addr) const;
+
+    // Continues counting from value instead of 0, as the boot ROM leaves it
+    void presetCounter(uint16_t value);
+
+    void saveState(StateWriter& state) const;
+    void loadState(StateReader& state);
+
+private:
+    uint64_t counter(uint64_t cycle) const { return cycle - m_resetCycle; }
+    bool enabled() const { return m_tac & 0b0000'0100; }
+    uint32_t edgeShift() const { return tacBits[m_tac & 0b0000'0011] + 1; }
+    bool timerInput(uint64_t cycle) const { return enabled() && ((counter(cycle) >> tacBits[m_tac & 0b0000'0011]) & 1); }
+
+    void sync(uint64_t cycle);
+    void increment(uint64_t cycle);
+    void schedule();
+
+    void writeDivider(uint64_t cycle);
+    void writeControl(uint64_t cycle, uint8_t value);
+
+    // Counter bit driving TIMA for each TAC clock select: 4096, 262144, 65536 and 16384 Hz
+    static constexpr std::array<uint32_t, 4> tacBits{ 9, 3, 5, 7 };
+    static constexpr uint64_t reloadDelay = 4; // TIMA reads 0x00 for one M-cycle before the reload
+
+    Bus* m_bus{};
+    uint64_t m_resetCycle{}; // last DIV write
+    uint64_t m_syncCycle{}; // m_tima counts the edges up to here
+    uint64_t m_overflowCycle{};
+    uint16_t m_tima{}; // 0x100 from the overflow until the reload
+    uint8_t m_tma{};
+    uint8_t m_tac{};
+};
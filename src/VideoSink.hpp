@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Where a Bus sends its frames and reads its buttons from. The core never opens a window
+// itself, a Bus constructed without a sink runs headless.
+class VideoSink {
+public:
+    virtual ~VideoSink() = default;
+
+    // Once per frame, 160x144 RGBA
+    virtual void present(const std::vector<uint8_t>& frameBuffer) = 0;
+
+    // The VRAM viewers are only rendered for a sink that shows them
+    virtual bool wantsDebug() const { return false; }
+    virtual void presentDebug(const std::vector<uint8_t>& /*tileDataBuffer*/,
+        const std::vector<uint8_t>& /*tileMapBuffer*/, const std::vector<uint8_t>& /*objectBuffer*/) {}
+
+    // down, up, left, right, start, select, b, a, active low. Read after every present.
+    virtual uint8_t joypad() const { return 0xFF; }
+    virtual bool rewinding() const { return false; }
+};
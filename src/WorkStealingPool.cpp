@@ -0,0 +1,66 @@
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <thread>
+
+WorkStealingPool::WorkStealingPool(size_t threads)
+{
+    for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+}
+
+void WorkStealingPool::submit(Task task)
+{
+    auto& worker = *m_workers[m_next++ % m_workers.size()];
+    std::lock_guard lock(worker.mutex);
+    worker.tasks.push_back(std::move(task));
+}
+
+void WorkStealingPool::run()
+{
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < m_workers.size(); ++i) {
+        threads.emplace_back(&WorkStealingPool::work, this, i);
+    }
+    work(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+// Nothing is submitted while running, so a thread is done once every deque is empty
+void WorkStealingPool::work(size_t worker)
+{
+    Task task;
+    while (pop(worker, task) || steal(worker, task)) {
+        task();
+    }
+}
+
+bool WorkStealingPool::pop(size_t worker, Task& task)
+{
+    auto& own = *m_workers[worker];
+    std::lock_guard lock(own.mutex);
+    if (own.tasks.empty()) {
+        return false;
+    }
+    task = std::move(own.tasks.back());
+    own.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(size_t thief, Task& task)
+{
+    for (size_t i = 1; i < m_workers.size(); ++i) {
+        auto& victim = *m_workers[(thief + i) % m_workers.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            m_steals++;
+            return true;
+        }
+    }
+    return false;
+}
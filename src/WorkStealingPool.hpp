@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Runs a fixed set of tasks on a fixed set of threads. Each thread owns a deque, takes work from
+// its back and, once it is empty, steals from the front of the others. Jobs of very different
+// length even out across the threads without them contending on one shared queue.
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(size_t threads);
+
+    // Tasks are dealt out round-robin, run() then executes all of them and returns when they are done
+    void submit(Task task);
+    void run();
+
+    size_t threads() const { return m_workers.size(); }
+    uint64_t steals() const { return m_steals; }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool pop(size_t worker, Task& task);
+    bool steal(size_t thief, Task& task);
+    void work(size_t worker);
+
+    std::vector<std::unique_ptr<Worker>> m_workers{};
+    size_t m_next{};
+    std::atomic<uint64_t> m_steals{};
+};
@@ -0,0 +1,402 @@
+#include "Bus.hpp"
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Headless runner for regression runs and data generation over many ROMs.
+//
+//   tameboy-batch <job file> [threads]
+//
+// One job per line, # starts a comment:
+//
+//   <rom> <frames> [<movie>|-] [hash,serial,frame]
+//
+// A movie has one "<frame> <keys>" line per joypad change, keys in hex as Bus::setJoypad takes them.
+// It may be left out before the outputs, which are told apart by their names. A movie file named
+// like them needs a path, e.g. ./hash. The outputs default to hash, the FNV-1a hash of the last frame. frame writes it as job<N>.ppm.
+// Jobs start from the post-boot state and never touch the .sav files next to the ROMs.
+//
+//   tameboy-batch --lockstep <job file> [threads]
+//
+// Runs the jobs with every translated block repeated on the interpreter, a difference fails the job.
+// Needs a TAMEBOY_RECOMPILER build.
+//
+//   tameboy-batch --state-check <rom> [frames]
+//
+// Takes a save state after a number of frames and runs as many again three times: straight on,
+// after loading the state back and on a new machine loading it. All three have to end in the same state.
+//
+//   tameboy-batch --boot-check <rom> <boot ROM> [frames]
+//
+// Checks that post-boot state against running the boot ROM: registers, VRAM, OAM and the I/O
+// registers at 0x0100, then both machines side by side for a number of frames. Exits with 1 on
+// a difference and with 77, the usual code for a skipped test, if the boot ROM cannot be read.
+
+namespace {
+
+// Nothing here rewinds, snapshots would only cost time
+constexpr RewindSettings noRewind{ .interval = 0 };
+
+struct Job {
+    std::string rom{};
+    uint64_t frames{};
+    std::string movie{};
+    bool hash = true;
+    bool serial = false;
+    bool frame = false;
+};
+
+struct Result {
+    uint64_t hash{};
+    std::string serial{};
+    double seconds{};
+    uint64_t checks{};
+    std::string error{};
+};
+
+// hash, serial and frame separated by commas
+bool isOutputs(const std::string& field)
+{
+    std::istringstream names(field);
+    std::string name;
+    while (std::getline(names, name, ',')) {
+        if (name != "hash" && name != "serial" && name != "frame") {
+            return false;
+        }
+    }
+    return !field.empty() && field.back() != ',';
+}
+
+std::vector<Job> loadJobs(const char* filename)
+{
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Can't open job file!");
+    }
+
+    std::vector<Job> jobs;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        Job job;
+        if (!(fields >> job.rom)) {
+            continue;
+        }
+        if (!(fields >> job.frames)) {
+            throw std::runtime_error("Job without a frame count: " + line);
+        }
+        std::string field;
+        fields >> field;
+        if (!field.empty() && !isOutputs(field)) {
+            job.movie = field == "-" ? "" : field;
+            field.clear();
+            fields >> field;
+        }
+        if (!field.empty()) {
+            if (!isOutputs(field)) {
+                throw std::runtime_error("Unknown job outputs: " + line);
+            }
+            job.hash = field.find("hash") != std::string::npos;
+            job.serial = field.find("serial") != std::string::npos;
+            job.frame = field.find("frame") != std::string::npos;
+        }
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+std::vector<std::pair<uint64_t, uint8_t>> loadMovie(const std::string& filename)
+{
+    std::vector<std::pair<uint64_t, uint8_t>> movie;
+    if (filename.empty()) {
+        return movie;
+    }
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Can't open movie " + filename);
+    }
+    uint64_t frame{};
+    unsigned keys{};
+    while (file >> std::dec >> frame >> std::hex >> keys) {
+        movie.emplace_back(frame, static_cast<uint8_t>(keys));
+    }
+    return movie;
+}
+
+uint64_t hashFrame(const std::vector<uint8_t>& frameBuffer)
+{
+    uint64_t hash = 0xCBF29CE484222325;
+    for (const auto byte : frameBuffer) {
+        hash = (hash ^ byte) * 0x100000001B3;
+    }
+    return hash;
+}
+
+void writeFrame(const std::vector<uint8_t>& frameBuffer, size_t index)
+{
+    std::ofstream file("job" + std::to_string(index) + ".ppm", std::ios::binary);
+    file << "P6\n160 144\n255\n";
+    for (size_t pixel = 0; pixel < frameBuffer.size(); pixel += 4) { // RGBA
+        file.write(reinterpret_cast<const char*>(&frameBuffer[pixel]), 3);
+    }
+}
+
+Result runJob(const Job& job, size_t index, bool lockstep)
+{
+    Result result;
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        const auto movie = loadMovie(job.movie);
+        Bus bus(job.rom.c_str(), nullptr, nullptr, nullptr, false);
+        bus.setRewind(noRewind);
+        if (lockstep && !bus.setLockstep(true)) {
+            throw std::runtime_error("Built without TAMEBOY_RECOMPILER, nothing to check");
+        }
+        std::ostringstream serial;
+        bus.setSerialOutput(serial);
+
+        size_t next = 0;
+        for (uint64_t frame = 0; frame < job.frames; ++frame) {
+            while (next < movie.size() && movie[next].first <= frame) {
+                bus.setJoypad(movie[next++].second);
+            }
+            bus.runFrames(1);
+        }
+
+        result.hash = hashFrame(bus.frameBuffer());
+        result.serial = serial.str();
+        result.checks = bus.lockstepChecks();
+        if (job.frame) {
+            writeFrame(bus.frameBuffer(), index);
+        }
+    }
+    catch (const std::exception& e) {
+        result.error = e.what();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.seconds = elapsed.count();
+    return result;
+}
+
+// Bits a DMG reads as 1 whatever was written, which the registers here store as written
+uint8_t ioReadMask(uint16_t addr)
+{
+    constexpr std::array<std::pair<uint16_t, uint8_t>, 21> masks{ {
+        { 0xFF00, 0xC0 }, { 0xFF02, 0x7E }, { 0xFF07, 0xF8 }, { 0xFF0F, 0xE0 }, { 0xFF10, 0x80 },
+        { 0xFF11, 0x3F }, { 0xFF13, 0xFF }, { 0xFF14, 0xBF }, { 0xFF16, 0x3F }, { 0xFF18, 0xFF },
+        { 0xFF19, 0xBF }, { 0xFF1A, 0x7F }, { 0xFF1B, 0xFF }, { 0xFF1C, 0x9F }, { 0xFF1D, 0xFF },
+        { 0xFF1E, 0xBF }, { 0xFF20, 0xFF }, { 0xFF23, 0xBF }, { 0xFF26, 0x70 }, { 0xFF41, 0x80 },
+        { 0xFF50, 0xFF },
+    } };
+    for (const auto& [reg, mask] : masks) {
+        if (reg == addr) {
+            return mask;
+        }
+    }
+    const auto unused = addr == 0xFF03 || (addr >= 0xFF08 && addr <= 0xFF0E) || addr == 0xFF15 || addr == 0xFF1F
+        || (addr >= 0xFF27 && addr <= 0xFF2F) || (addr >= 0xFF4C && addr <= 0xFF7F);
+    return unused ? 0xFF : 0x00;
+}
+
+std::string registerString(const std::array<uint16_t, 6>& registers)
+{
+    constexpr std::array<const char*, 6> names{ "AF", "BC", "DE", "HL", "SP", "PC" };
+    std::ostringstream out;
+    out << std::hex << std::setfill('0');
+    for (size_t i = 0; i < registers.size(); ++i) {
+        out << (i ? " " : "") << names[i] << "=" << std::setw(4) << registers[i];
+    }
+    return out.str();
+}
+
+int checkState(const char* rom, uint64_t frames)
+{
+    Bus bus(rom, nullptr, nullptr, nullptr, false);
+    bus.setRewind(noRewind);
+    std::ostringstream serial;
+    bus.setSerialOutput(serial);
+    bus.runFrames(frames);
+    std::vector<uint8_t> state(bus.stateSize());
+    bus.saveState(state.data(), state.size());
+
+    const auto runFrom = [&state, frames](Bus& machine) {
+        machine.runFrames(frames);
+        std::vector<uint8_t> result(state.size());
+        machine.saveState(result.data(), result.size());
+        return result;
+    };
+    const auto straight = runFrom(bus);
+    bus.loadState(state.data(), state.size());
+    const auto reloaded = runFrom(bus);
+    Bus fresh(rom, nullptr, nullptr, nullptr, false);
+    fresh.setRewind(noRewind);
+    fresh.setSerialOutput(serial);
+    fresh.loadState(state.data(), state.size());
+    const auto restored = runFrom(fresh);
+
+    size_t differences = 0;
+    const auto compare = [&straight, &differences](const char* name, const std::vector<uint8_t>& result) {
+        const auto mismatch = std::mismatch(straight.begin(), straight.end(), result.begin());
+        if (mismatch.first != straight.end()) {
+            std::cout << name << " differs from byte " << std::distance(straight.begin(), mismatch.first) << " of the state\n";
+            differences++;
+        }
+    };
+    compare("reloaded", reloaded);
+    compare("new machine", restored);
+
+    std::cout << std::dec << rom << ": " << state.size() << " byte state, " << frames << " frames, " << differences
+        << " differences\n";
+    return differences ? 1 : 0;
+}
+
+int checkBoot(const char* rom, const char* bootRom, uint64_t frames)
+{
+    if (!std::ifstream(bootRom, std::ios::binary)) {
+        std::cout << rom << ": skipped, no boot ROM at " << bootRom << "\n";
+        return 77;
+    }
+    Bus boot(rom, bootRom, nullptr, nullptr, false);
+    boot.setRewind(noRewind);
+    const auto start = std::chrono::steady_clock::now();
+    while (boot.bootRomMapped()) {
+        boot.stepInstruction();
+    }
+    const std::chrono::duration<double> bootTime = std::chrono::steady_clock::now() - start;
+
+    const auto fastStart = std::chrono::steady_clock::now();
+    Bus fast(rom, nullptr, nullptr, nullptr, false);
+    fast.setRewind(noRewind);
+    const std::chrono::duration<double> fastTime = std::chrono::steady_clock::now() - fastStart;
+
+    size_t differences = 0;
+    if (boot.cpuRegisters() != fast.cpuRegisters()) {
+        std::cout << "registers: boot " << registerString(boot.cpuRegisters()) << "\n"
+            << "           fast " << registerString(fast.cpuRegisters()) << "\n";
+        differences++;
+    }
+    for (uint32_t addr = 0x8000; addr <= 0xFFFF; ++addr) {
+        if (addr == 0xA000) {
+            addr = 0xFE00; // cartridge and work RAM are not touched by the boot ROM
+        }
+        const auto mask = addr >= 0xFF00 && addr < 0xFF80 ? ioReadMask(static_cast<uint16_t>(addr)) : 0;
+        const auto bootValue = boot.read(static_cast<uint16_t>(addr)) | mask;
+        const auto fastValue = fast.read(static_cast<uint16_t>(addr)) | mask;
+        if (bootValue != fastValue) {
+            std::cout << std::hex << std::setfill('0') << std::setw(4) << addr << ": boot " << std::setw(2) << bootValue
+                << " fast " << std::setw(2) << fastValue << std::setfill(' ') << "\n";
+            differences++;
+        }
+    }
+
+    // DIV and the PPU phase only show over time, a game polling them takes another path if they are off
+    const auto bootStart = boot.cycles();
+    uint64_t instructions = 0;
+    while (fast.cycles() < frames * 70224) {
+        boot.stepInstruction();
+        fast.stepInstruction();
+        instructions++;
+        if (boot.cpuRegisters() != fast.cpuRegisters() || boot.cycles() - bootStart != fast.cycles()) {
+            std::cout << std::dec << "diverged after " << instructions << " instructions, " << fast.cycles() << " cycles:\n"
+                << "  boot " << registerString(boot.cpuRegisters()) << "\n"
+                << "  fast " << registerString(fast.cpuRegisters()) << "\n";
+            differences++;
+            break;
+        }
+    }
+    if (boot.shadeBuffer() != fast.shadeBuffer()) {
+        std::cout << std::dec << "frame differs after " << instructions << " instructions\n";
+        differences++;
+    }
+
+    std::cout << std::dec << rom << ": " << (differences ? "failed" : "passed") << ", boot ROM " << bootTime.count() * 1e3
+        << " ms, fast boot " << fastTime.count() * 1e6 << " us, " << differences << " differences\n";
+    return differences ? 1 : 0;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const std::string mode = argc > 1 ? argv[1] : "";
+    if (argc < 2 || (mode == "--state-check" && argc < 3) || (mode == "--boot-check" && argc < 4)) {
+        std::cerr << "usage: tameboy-batch <job file> [threads]\n"
+            "       tameboy-batch --lockstep <job file> [threads]\n"
+            "       tameboy-batch --state-check <rom> [frames]\n"
+            "       tameboy-batch --boot-check <rom> <boot ROM> [frames]" << std::endl;
+        return 1;
+    }
+
+    try {
+        if (mode == "--state-check") {
+            return checkState(argv[2], argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 60);
+        }
+        if (mode == "--boot-check") {
+            return checkBoot(argv[2], argv[3], argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 60);
+        }
+
+        const bool lockstep = mode == "--lockstep";
+        if (lockstep && argc < 3) {
+            std::cerr << "--lockstep needs a job file" << std::endl;
+            return 1;
+        }
+        const auto jobFile = lockstep ? 2 : 1;
+        const auto jobs = loadJobs(argv[jobFile]);
+        const auto threads = argc > jobFile + 1 ? std::strtoul(argv[jobFile + 1], nullptr, 10) : std::thread::hardware_concurrency();
+        std::vector<Result> results(jobs.size());
+
+        WorkStealingPool pool(threads);
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            pool.submit([&jobs, &results, i, lockstep]() { results[i] = runJob(jobs[i], i, lockstep); });
+        }
+        const auto start = std::chrono::steady_clock::now();
+        pool.run();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        uint64_t frames = 0;
+        size_t failed = 0;
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            const auto& job = jobs[i];
+            const auto& result = results[i];
+            std::cout << std::dec << i << " " << job.rom << " frames=" << job.frames << " time=" << result.seconds
+                << " fps=" << (result.seconds > 0 ? job.frames / result.seconds : 0.0);
+            if (!result.error.empty()) {
+                std::cout << " error=\"" << result.error << "\"\n";
+                failed++;
+                continue;
+            }
+            frames += job.frames;
+            if (job.hash) {
+                std::cout << " hash=" << std::hex << std::setw(16) << std::setfill('0') << result.hash << std::setfill(' ');
+            }
+            if (job.serial) {
+                std::cout << " serial=\"" << result.serial << "\"";
+            }
+            if (lockstep) {
+                std::cout << std::dec << " checks=" << result.checks;
+            }
+            std::cout << "\n";
+        }
+        std::cout << std::dec << jobs.size() << " jobs, " << failed << " failed, " << frames << " frames in " << elapsed.count()
+            << " s on " << pool.threads() << " threads (" << frames / elapsed.count() << " frames/s, "
+            << pool.steals() << " steals)\n";
+        return failed ? 1 : 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -1,10 +1,26 @@
+#include "AudioOutput.hpp"
 #include "Bus.hpp"
+#include "Screen.hpp"
 
 #include <iostream>
 
 int main() {
     try{
-        Bus bus(true);
+        Screen screen;
+        AudioOutput audio;
+        //const auto* rom = "../roms/tetris.bin";
+        //const auto* rom = "../roms/cpu_instrs.gb";
+        //const auto* rom = "../roms/blargg/cpu_instrs/1.gb";
+        //const auto* rom = "../roms/blargg/instr_timing.gb";
+        //const auto* rom = "../roms/tennis.bin";
+        //const auto* rom = "../roms/Alleyway.bin";
+        //const auto* rom = "../roms/dr.bin";
+        //const auto* rom = "../roms/spot.gb";
+        const auto* rom = "../roms/taz.gb";
+        //const auto* rom = "../roms/balls.gb";
+        const auto* bootRom = "../roms/DMG_ROM_no_checksum.bin";
+        Bus bus(rom, bootRom, &screen, &audio);
+        bus.setRewind({ .budget = 32 * 1024 * 1024, .interval = 4, .speed = 1 });
         bus.start();
     }
     catch(std::runtime_error e) {